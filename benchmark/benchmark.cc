@@ -0,0 +1,191 @@
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSysInfo>
+
+#include <game_data/game_data.h>
+#include <version.h>
+
+#include "benchmark.h"
+
+const void *volatile Benchmark::_sink = nullptr;
+
+/**
+ * @brief		Constructor.
+ */
+Benchmark::Benchmark(qint64 minTime, int samples) :
+    m_minTime(minTime), m_samples(::std::max(samples, 1))
+{}
+
+/**
+ * @brief		Add a case.
+ */
+void Benchmark::addCase(const QString &name, Setup setup)
+{
+    m_cases.append({name, setup});
+}
+
+/**
+ * @brief		Get names of cases.
+ */
+QStringList Benchmark::names() const
+{
+    QStringList ret;
+    for (const auto &benchmarkCase : m_cases) {
+        ret.append(benchmarkCase.name);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Run cases.
+ */
+QVector<Benchmark::Result> Benchmark::run(const QRegularExpression &filter)
+{
+    QVector<Result> results;
+    for (const auto &benchmarkCase : m_cases) {
+        if (! filter.match(benchmarkCase.name).hasMatch()) {
+            continue;
+        }
+
+        Function function = benchmarkCase.setup();
+        if (! function) {
+            qWarning().noquote() << QString("%1 : skipped, not available.")
+                                        .arg(benchmarkCase.name);
+            continue;
+        }
+
+        Result result = this->measure(benchmarkCase.name, function);
+        qDebug().noquote() << QString("%1 : %2 ns, %3 items/s.")
+                                  .arg(result.name)
+                                  .arg(result.nsPerIteration, 0, 'f', 1)
+                                  .arg(result.itemsPerSecond, 0, 'f', 0);
+        results.append(result);
+    }
+
+    return results;
+}
+
+/**
+ * @brief		Format results as CSV.
+ */
+QByteArray Benchmark::toCsv(const QVector<Result> &results)
+{
+    QByteArray ret("name,iterations,ns_per_iteration,items_per_iteration,"
+                   "items_per_second\n");
+    for (const auto &result : results) {
+        ret.append(QString("%1,%2,%3,%4,%5\n")
+                       .arg(result.name)
+                       .arg(result.iterations)
+                       .arg(result.nsPerIteration, 0, 'f', 3)
+                       .arg(result.itemsPerIteration)
+                       .arg(result.itemsPerSecond, 0, 'f', 3)
+                       .toUtf8());
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Format results as JSON.
+ */
+QByteArray Benchmark::toJson(const QVector<Result> &results)
+{
+    QJsonArray cases;
+    for (const auto &result : results) {
+        QJsonObject obj;
+        obj.insert("name", result.name);
+        obj.insert("iterations", (qint64)(result.iterations));
+        obj.insert("ns_per_iteration", result.nsPerIteration);
+        obj.insert("items_per_iteration", (qint64)(result.itemsPerIteration));
+        obj.insert("items_per_second", result.itemsPerSecond);
+        cases.append(obj);
+    }
+
+    QJsonObject root;
+    root.insert("version", VERSION_STR);
+    root.insert("time",
+                QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert("cpu", QSysInfo::currentCpuArchitecture());
+    root.insert("os", QSysInfo::prettyProductName());
+    root.insert("results", cases);
+
+    return QJsonDocument(root).toJson(QJsonDocument::JsonFormat::Indented);
+}
+
+/**
+ * @brief		Destructor.
+ */
+Benchmark::~Benchmark() {}
+
+/**
+ * @brief		Measure a function.
+ */
+Benchmark::Result Benchmark::measure(const QString & name,
+                                     const Function &function)
+{
+    QElapsedTimer timer;
+
+    // Warm up and calibrate, the number of iterations is doubled until a
+    // sample takes the minimum time.
+    quint64 iterations = 1;
+    quint64 items      = function(1);
+    while (true) {
+        timer.start();
+        items          = function(iterations);
+        qint64 elapsed = timer.nsecsElapsed();
+        if (elapsed >= m_minTime * 1000000 || iterations >= (1ULL << 40)) {
+            break;
+        }
+
+        // Jump close to the minimum time when the sample is long enough to
+        // be measured.
+        if (elapsed > 1000000) {
+            iterations = ::std::max(
+                iterations * 2,
+                (quint64)((double)(iterations)*m_minTime * 1000000 / elapsed)
+                    + 1);
+        } else {
+            iterations *= 2;
+        }
+    }
+
+    // Samples.
+    QVector<double> samples;
+    for (int i = 0; i < m_samples; ++i) {
+        timer.start();
+        function(iterations);
+        samples.append((double)(timer.nsecsElapsed()) / iterations);
+    }
+    ::std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+
+    return {name, iterations, median, items,
+            median > 0 ? items * 1e9 / median : 0.0};
+}
+
+/**
+ * @brief		Get macros of station modules which can be built by player.
+ */
+QStringList benchmarkModules()
+{
+    QStringList ret;
+    if (GameData::instance() == nullptr) {
+        return ret;
+    }
+
+    for (const auto &module :
+         GameData::instance()->stationModules()->modules()) {
+        if (module->playerModule) {
+            ret.append(module->macro);
+        }
+    }
+
+    return ret;
+}
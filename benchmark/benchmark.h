@@ -0,0 +1,179 @@
+#pragma once
+
+#include <functional>
+
+#if defined(_MSC_VER) && ! defined(__clang__)
+    #include <intrin.h>
+#endif
+
+#include <QtCore/QByteArray>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/**
+ * @brief	Benchmark harness. Each case is calibrated until one sample takes
+ *			at least the minimum time, then the median of the samples is
+ *			reported.
+ */
+class Benchmark {
+  public:
+    /**
+     * @brief	Body of a case, runs the measured code \c iterations times.
+     *			Returns the number of items processed in one iteration,
+     *			which is used to compute throughput.
+     */
+    typedef ::std::function<quint64(quint64 iterations)> Function;
+
+    /**
+     * @brief	Setup of a case, called once before the case is measured.
+     *			Returns an empty function if the case is not available.
+     */
+    typedef ::std::function<Function()> Setup;
+
+    /**
+     * @brief	Result of a case.
+     */
+    struct Result {
+        QString name;              ///< Name of the case.
+        quint64 iterations;        ///< Iterations of each sample.
+        double  nsPerIteration;    ///< Median time of an iteration(ns).
+        quint64 itemsPerIteration; ///< Items processed in an iteration.
+        double  itemsPerSecond;    ///< Throughput.
+    };
+
+  private:
+    /**
+     * @brief	Case.
+     */
+    struct Case {
+        QString name;  ///< Name.
+        Setup   setup; ///< Setup.
+    };
+
+  private:
+    QVector<Case> m_cases;   ///< Cases.
+    qint64        m_minTime; ///< Minimum time of a sample(ms).
+    int           m_samples; ///< Samples of each case.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	minTime		Minimum time of a sample(ms).
+     * @param[in]	samples		Samples of each case.
+     */
+    Benchmark(qint64 minTime = 200, int samples = 5);
+
+    /**
+     * @brief		Add a case.
+     *
+     * @param[in]	name		Name of the case, groups are separated by
+     *							'/'.
+     * @param[in]	setup		Setup of the case.
+     */
+    void addCase(const QString &name, Setup setup);
+
+    /**
+     * @brief		Get names of cases.
+     *
+     * @return		Names of cases.
+     */
+    QStringList names() const;
+
+    /**
+     * @brief		Run cases.
+     *
+     * @param[in]	filter		Only cases whose names match the filter are
+     *							run.
+     *
+     * @return		Results of cases run, unavailable cases are skipped.
+     */
+    QVector<Result> run(const QRegularExpression &filter);
+
+    /**
+     * @brief		Format results as CSV.
+     *
+     * @param[in]	results		Results.
+     *
+     * @return		CSV text.
+     */
+    static QByteArray toCsv(const QVector<Result> &results);
+
+    /**
+     * @brief		Format results as JSON.
+     *
+     * @param[in]	results		Results.
+     *
+     * @return		JSON text.
+     */
+    static QByteArray toJson(const QVector<Result> &results);
+
+    /**
+     * @brief		Keep a value from being optimized out. The compiler has to
+     *				assume the value is read, so the computation of it is
+     *				kept.
+     *
+     * @param[in]	value		Value.
+     */
+    template<typename T>
+    static inline void keep(const T &value)
+    {
+#if defined(_MSC_VER) && ! defined(__clang__)
+        _sink = static_cast<const void *>(&value);
+        (void)*static_cast<const volatile char *>(_sink);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~Benchmark();
+
+  private:
+    /**
+     * @brief		Measure a function.
+     *
+     * @param[in]	name		Name of the case.
+     * @param[in]	function	Function.
+     *
+     * @return		Result.
+     */
+    Result measure(const QString &name, const Function &function);
+
+  private:
+    static const void *volatile _sink; ///< Sink of kept values(MSVC).
+};
+
+/**
+ * @brief		Get macros of station modules which can be built by player,
+ *				used to make stations of benchmarks.
+ *
+ * @return		Macros, empty if game data is not loaded.
+ */
+QStringList benchmarkModules();
+
+/**
+ * @brief		Add benchmarks of game VFS, texts and XML loader.
+ *
+ * @param[in]	benchmark	Benchmark.
+ */
+void addGameDataBenchmarks(Benchmark &benchmark);
+
+/**
+ * @brief		Add benchmarks of station summary.
+ *
+ * @param[in]	benchmark	Benchmark.
+ */
+void addSummaryBenchmarks(Benchmark &benchmark);
+
+/**
+ * @brief		Add benchmarks of saves.
+ *
+ * @param[in]	benchmark	Benchmark.
+ */
+void addSaveBenchmarks(Benchmark &benchmark);
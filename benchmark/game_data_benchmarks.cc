@@ -0,0 +1,189 @@
+#include <QtCore/QXmlStreamReader>
+
+#include <common/fuzzy_index.h>
+#include <common/xml_loader.h>
+#include <config.h>
+#include <game_data/game_data.h>
+
+#include "benchmark.h"
+
+/// Elements in the XML document parsed by the XML loader benchmark.
+#define BENCHMARK_XML_ELEMENTS 10000
+
+/**
+ * @brief		Make an XML document like the macro files of the game.
+ *
+ * @param[in]	count		Number of macros.
+ *
+ * @return		XML document.
+ */
+static QByteArray makeXMLDocument(int count)
+{
+    QByteArray ret("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<macros>\n");
+    for (int i = 0; i < count; ++i) {
+        ret.append(
+            QString("  <macro name=\"prod_gen_macro_%1\" "
+                    "class=\"production\">\n"
+                    "    <component ref=\"prod_gen_%1\" />\n"
+                    "    <properties>\n"
+                    "      <identification name=\"{20104,%1}\" "
+                    "description=\"{20104,%2}\" />\n"
+                    "      <hull max=\"%3\" />\n"
+                    "      <workforce max=\"%4\" />\n"
+                    "    </properties>\n"
+                    "  </macro>\n")
+                .arg(i)
+                .arg(i + 1)
+                .arg(100000 + i)
+                .arg(i % 500)
+                .toUtf8());
+    }
+    ret.append("</macros>\n");
+
+    return ret;
+}
+
+/**
+ * @brief		Add benchmarks of game VFS, texts and XML loader.
+ */
+void addGameDataBenchmarks(Benchmark &benchmark)
+{
+    // Index cat files of the game.
+    benchmark.addCase("vfs/create", []() -> Benchmark::Function {
+        QString gamePath = Config::instance()->getString("/gamePath", "");
+        QMap<QString, GameVFS::CatFileInfo> catFiles;
+        if (gamePath.isEmpty()
+            || ! GameData::checkGamePath(gamePath, catFiles)) {
+            return nullptr;
+        }
+
+        return [gamePath, catFiles](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                auto vfs = GameVFS::create(
+                    gamePath, catFiles, [](const QString &) -> void {},
+                    [](const QString &) -> void {});
+                Benchmark::keep(vfs);
+            }
+            return catFiles.size();
+        };
+    });
+
+    // Look up files of station modules.
+    benchmark.addCase("vfs/open", []() -> Benchmark::Function {
+        if (GameData::instance() == nullptr
+            || GameData::instance()->vfs() == nullptr) {
+            return nullptr;
+        }
+
+        auto        vfs    = GameData::instance()->vfs();
+        auto        macros = GameData::instance()->macros();
+        QStringList paths
+            = {"/libraries/wares.xml", "/libraries/races.xml",
+               "/libraries/modulegroups.xml", "/index/macros.xml",
+               "/index/components.xml"};
+        for (const auto &module :
+             GameData::instance()->stationModules()->modules()) {
+            paths.append(macros->macro(module->macro) + ".xml");
+        }
+
+        return [vfs, paths](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                for (const auto &path : paths) {
+                    auto file = vfs->open(path);
+                    Benchmark::keep(file);
+                }
+            }
+            return paths.size();
+        };
+    });
+
+    // Parse a document, items are bytes.
+    benchmark.addCase("xml_loader/parse", []() -> Benchmark::Function {
+        QByteArray document = makeXMLDocument(BENCHMARK_XML_ELEMENTS);
+
+        return [document](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                quint64                               elements = 0;
+                XMLLoader                             loader;
+                QXmlStreamReader                      reader(document);
+                ::std::unique_ptr<XMLLoader::Context> context
+                    = XMLLoader::Context::create();
+                context->setOnStartElement(
+                    [&elements](XMLLoader &, XMLLoader::Context &,
+                                const QString &,
+                                const QMap<QString, QString> &) -> bool {
+                        ++elements;
+                        return true;
+                    });
+                loader.parse(reader, ::std::move(context));
+                Benchmark::keep(elements);
+            }
+            return document.size();
+        };
+    });
+
+    // Resolve names and descriptions of station modules.
+    benchmark.addCase("texts/text", []() -> Benchmark::Function {
+        if (GameData::instance() == nullptr) {
+            return nullptr;
+        }
+
+        auto                       texts = GameData::instance()->texts();
+        QVector<GameTexts::IDPair> ids;
+        for (const auto &module :
+             GameData::instance()->stationModules()->modules()) {
+            ids.append(module->name);
+            ids.append(module->description);
+        }
+
+        return [texts, ids](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                for (const auto &id : ids) {
+                    QString text = texts->text(id);
+                    Benchmark::keep(text);
+                }
+            }
+            return ids.size();
+        };
+    });
+
+    // Search names and macros of station modules with a typo in each query,
+    // items are queries.
+    benchmark.addCase("texts/fuzzy_search", []() -> Benchmark::Function {
+        if (GameData::instance() == nullptr) {
+            return nullptr;
+        }
+
+        auto                 texts = GameData::instance()->texts();
+        QVector<QStringList> documents;
+        QStringList          queries;
+        for (const auto &module :
+             GameData::instance()->stationModules()->modules()) {
+            QString name = texts->text(module->name);
+            documents.append({name, module->macro});
+            if (name.size() >= 4 && queries.size() < 100) {
+                QChar c = name[1];
+                name[1] = name[2];
+                name[2] = c;
+                queries.append(name);
+            }
+        }
+        if (queries.empty()) {
+            return nullptr;
+        }
+        auto index = ::std::make_shared<FuzzyIndex>(documents);
+
+        return [index, queries](quint64 iterations) -> quint64 {
+            auto cancelled = []() -> bool {
+                return false;
+            };
+            for (quint64 i = 0; i < iterations; ++i) {
+                for (const auto &query : queries) {
+                    auto matches = index->search(query, cancelled);
+                    Benchmark::keep(matches);
+                }
+            }
+            return queries.size();
+        };
+    });
+}
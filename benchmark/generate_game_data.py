@@ -0,0 +1,641 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import hashlib
+import os
+import random
+import stat
+from xml.sax.saxutils import escape, quoteattr
+
+# Languages of text files, the first one is always generated.
+LANGUAGES = [44, 86, 88, 49, 33, 7, 81, 82, 39, 34, 55]
+
+# Words used in texts of each language.
+WORDS = {
+    44: {"ware": "Ware", "module": "Module", "group": "Group", "race": "Race"},
+    49: {"ware": "Ware", "module": "Modul", "group": "Gruppe", "race": "Volk"},
+    86: {"ware": "商品", "module": "模块", "group": "分组", "race": "种族"},
+    88: {"ware": "商品", "module": "模組", "group": "分組", "race": "種族"},
+}
+
+DESCRIPTION_WORDS = [
+    "station", "module", "sector", "trade", "cargo", "production", "energy",
+    "hull", "dock", "ship", "storage", "workforce", "supply", "demand",
+    "price", "faction", "defence", "turret", "shield", "habitat"
+]
+
+# Pages of texts.
+PAGE_MODULES = 20104
+PAGE_WARES = 20201
+PAGE_RACES = 20202
+PAGE_GROUPS = 20215
+PAGE_EXTRA = 90000
+
+# Ids of texts in each extension start from a multiple of this value.
+EXTENSION_TEXT_ID_STEP = 100000
+
+# Texts in each page of extra texts.
+EXTRA_TEXTS_PER_PAGE = 1000
+
+# Races, the first four are player races.
+RACES = ["argon", "paranid", "split", "teladi", "boron", "terran", "xenon"]
+PLAYER_RACES = RACES[:4]
+
+WARE_GROUPS = [("energy", "container"), ("minerals", "solid"),
+               ("gases", "liquid"), ("refined", "container"),
+               ("hightech", "container"), ("agricultural", "container"),
+               ("pharmaceutical", "container"), ("shiptech", "container")]
+
+# Docking bays referenced by dock areas, (name, external, capacity, tags).
+DOCKING_BAYS = [("s", 4, 10, "dock_s"), ("m", 2, 5, "dock_m"),
+                ("l", 1, 0, "dock_l"), ("xl", 1, 0, "dock_xl"),
+                ("l_xl", 1, 0, "dock_l dock_xl")]
+
+# Tags of connections of defence module components.
+DEFENCE_TAGS = ["turret medium", "turret large", "shield medium large",
+                "shield large"]
+
+# Classes of station modules and their shares, production modules use the
+# rest.
+MODULE_CLASSES = [("habitation", 0.10), ("storage", 0.12), ("dockarea", 0.05),
+                  ("pier", 0.03), ("defencemodule", 0.08),
+                  ("connectionmodule", 0.04), ("buildmodule", 0.02),
+                  ("welfaremodule", 0.02), ("processingmodule", 0.02),
+                  ("radar", 0.02)]
+
+# Fixed timestamp of packed files to make the output reproducible.
+TIMESTAMP = 1600000000
+
+
+class Texts:
+    """
+    Texts of the game, rendered in each language.
+    """
+
+    def __init__(self, description_words):
+        self.entries = {}
+        self.description_words = description_words
+
+    def add(self, page, tid, kind, number):
+        self.entries.setdefault(page, {})[tid] = (kind, number)
+        return "{%d,%d}" % (page, tid)
+
+    def add_reference(self, page, tid, reference, kind):
+        self.entries.setdefault(page, {})[tid] = ("reference",
+                                                  (reference, kind))
+        return "{%d,%d}" % (page, tid)
+
+    def render(self, language, kind, value):
+        words = WORDS.get(language)
+        prefix = ""
+        if words is None:
+            words = WORDS[44]
+            prefix = "[%d] " % (language)
+
+        if kind == "reference":
+            return "%s %s" % (value[0], words[value[1]])
+        elif kind == "description" or kind == "extra":
+            rng = random.Random(value * 131 + language)
+            text = " ".join(
+                rng.choice(DESCRIPTION_WORDS)
+                for i in range(self.description_words))
+            # Comments in brackets are removed by the game.
+            return "%s(generated %d) %s." % (prefix, value, text.capitalize())
+        else:
+            return "%s%s %d" % (prefix, words[kind], value)
+
+    def xml(self, language):
+        lines = [
+            "<?xml version=\"1.0\" encoding=\"utf-8\"?>",
+            "<language id=\"%d\">" % (language)
+        ]
+        for page in sorted(self.entries):
+            lines.append("  <page id=\"%d\">" % (page))
+            for tid, (kind, value) in sorted(self.entries[page].items()):
+                lines.append("    <t id=\"%d\">%s</t>" %
+                             (tid, escape(self.render(language, kind, value))))
+            lines.append("  </page>")
+        lines.append("</language>")
+        return "\n".join(lines) + "\n"
+
+
+class Package:
+    """
+    Files of the game or an extension, packed in cat/dat files.
+    """
+
+    def __init__(self, prefix):
+        self.prefix = prefix
+        self.files = {}
+        self.macros = {}
+        self.components = {}
+
+    def add(self, path, content):
+        self.files[path] = content.encode(encoding="utf-8")
+
+    def add_macro(self, name, path, content):
+        self.macros[name] = path
+        self.add(path + ".xml", content)
+
+    def add_component(self, name, path, content):
+        self.components[name] = path
+        self.add(path + ".xml", content)
+
+    def index(self, entries):
+        lines = ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<index>"]
+        for name, path in sorted(entries.items()):
+            value = (self.prefix + path).replace("/", "\\")
+            lines.append("  <entry name=%s value=%s />" %
+                         (quoteattr(name), quoteattr(value)))
+        lines.append("</index>")
+        return "\n".join(lines) + "\n"
+
+    def write(self, root, cat_names):
+        self.add("index/macros.xml", self.index(self.macros))
+        self.add("index/components.xml", self.index(self.components))
+
+        # Files are spreaded over cat files like the game does.
+        paths = sorted(self.files)
+        for i, cat_name in enumerate(cat_names):
+            cat_path = os.path.join(root, cat_name + ".cat")
+            dat_path = os.path.join(root, cat_name + ".dat")
+            with open(cat_path, "wb") as cat, open(dat_path, "wb") as dat:
+                for path in paths[i::len(cat_names)]:
+                    data = self.files[path]
+                    cat.write(("%s %d %d %s\n" %
+                               (path, len(data), TIMESTAMP,
+                                hashlib.md5(data).hexdigest())).encode(
+                                    encoding="utf-8"))
+                    dat.write(data)
+
+
+def make_ware_xml(ware):
+    lines = [
+        "  <ware id=%s name=%s description=%s group=%s transport=%s "
+        "volume=\"%d\" tags=%s>" %
+        (quoteattr(ware["id"]), quoteattr(ware["name"]),
+         quoteattr(ware["description"]), quoteattr(ware["group"]),
+         quoteattr(ware["transport"]), ware["volume"], quoteattr(ware["tags"])),
+        "    <price min=\"%d\" average=\"%d\" max=\"%d\" />" %
+        (ware["price"] * 8 // 10, ware["price"], ware["price"] * 12 // 10)
+    ]
+    for method, production in ware["productions"].items():
+        lines.append("    <production time=\"%d\" amount=\"%d\" "
+                     "method=%s name=\"{20206,101}\">" %
+                     (production["time"], production["amount"],
+                      quoteattr(method)))
+        if len(production["resources"]) > 0:
+            lines.append("      <primary>")
+            for resource, amount in production["resources"]:
+                lines.append("        <ware ware=%s amount=\"%d\" />" %
+                             (quoteattr(resource), amount))
+            lines.append("      </primary>")
+        lines.append("      <effects>")
+        lines.append("        <effect type=\"work\" product=\"%.2f\" />" %
+                     (production["work"]))
+        lines.append("      </effects>")
+        lines.append("    </production>")
+    lines.append("  </ware>")
+    return "\n".join(lines)
+
+
+def make_wares(rng, texts, prefix, count, text_base, resources):
+    """
+    Make wares, each ware is produced from wares made before it.
+    """
+    wares = []
+    for i in range(count):
+        tid = text_base + i * 2 + 1
+        group, transport = WARE_GROUPS[3 + i % (len(WARE_GROUPS) - 3)]
+        available = resources + [w["id"] for w in wares]
+        productions = {}
+        methods = ["default"]
+        if i % 7 == 3:
+            methods.append(PLAYER_RACES[i % len(PLAYER_RACES)])
+        for method in methods:
+            picked = rng.sample(available[1:],
+                                min(len(available) - 1, rng.randint(1, 3)))
+            if rng.random() < 0.8:
+                picked.append(available[0])
+            productions[method] = {
+                "time": rng.choice([60, 120, 300, 600, 900]),
+                "amount": rng.randint(10, 400),
+                "work": rng.choice([0.25, 0.3, 0.43, 0.5]),
+                "resources": [(r, rng.randint(5, 200)) for r in picked]
+            }
+        wares.append({
+            "id": "%sware_%03d" % (prefix, i),
+            "name": texts.add(PAGE_WARES, tid, "ware", tid),
+            "description": texts.add(PAGE_WARES, tid + 1, "description",
+                                     tid + 1),
+            "group": group,
+            "transport": transport,
+            "volume": rng.randint(1, 50),
+            "tags": "container economy",
+            "price": rng.randint(10, 5000),
+            "productions": productions
+        })
+    return wares
+
+
+def make_base_wares(rng, texts, count):
+    """
+    Make wares of the game, including energy cells, raw resources and work
+    units.
+    """
+    wares = [{
+        "id": "energycells",
+        "name": texts.add(PAGE_WARES, 1, "ware", 1),
+        "description": texts.add(PAGE_WARES, 2, "description", 2),
+        "group": "energy",
+        "transport": "container",
+        "volume": 6,
+        "tags": "container economy",
+        "price": 16,
+        "productions": {
+            "default": {
+                "time": 60,
+                "amount": 175,
+                "work": 0.43,
+                "resources": []
+            }
+        }
+    }]
+
+    raw_count = max(2, count // 10)
+    for i in range(raw_count):
+        tid = 1001 + i * 2
+        group, transport = WARE_GROUPS[1 + i % 2]
+        wares.append({
+            "id": "raw_%03d" % (i),
+            "name": texts.add(PAGE_WARES, tid, "ware", tid),
+            "description": texts.add(PAGE_WARES, tid + 1, "description",
+                                     tid + 1),
+            "group": group,
+            "transport": transport,
+            "volume": rng.randint(6, 10),
+            "tags": "minable %s" % (transport),
+            "price": rng.randint(20, 100),
+            "productions": {}
+        })
+
+    wares += make_wares(rng, texts, "", max(2, count - raw_count - 1), 2001,
+                        [w["id"] for w in wares])
+    return wares
+
+
+def make_workunit(wares):
+    """
+    Make work units consumed by workforce, the first two produced wares are
+    food and medicine.
+    """
+    produced = [w["id"] for w in wares if w["id"].startswith("ware_")]
+    productions = {}
+    for i, method in enumerate(["default"] + PLAYER_RACES):
+        productions[method] = {
+            "time": 600,
+            "amount": 100,
+            "work": 0,
+            "resources": [(produced[0], 20 + i), (produced[1], 10 + i)]
+        }
+    return productions
+
+
+def make_macro_xml(module):
+    lines = [
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<macros>",
+        "  <macro name=%s class=%s>" %
+        (quoteattr(module["macro"]), quoteattr(module["class"])),
+        "    <component ref=%s />" % (quoteattr(module["component"])),
+        "    <properties>"
+    ]
+    identification = "      <identification name=%s description=%s" % (
+        quoteattr(module["name"]), quoteattr(module["description"]))
+    if module["race"] is not None:
+        identification += " makerrace=%s" % (quoteattr(module["race"]))
+    lines.append(identification + " />")
+    if module["player"]:
+        lines += [
+            "      <build>", "        <sets>",
+            "          <set ref=\"headquarters_player\" />",
+            "          <set ref=\"factory_player\" />", "        </sets>",
+            "      </build>"
+        ]
+    lines.append("      <explosiondamage value=\"%d\" />" %
+                 (module["explosiondamage"]))
+    lines.append("      <hull max=\"%d\" />" % (module["hull"]))
+    if "workforce" in module:
+        lines.append("      <workforce max=\"%d\" />" % (module["workforce"]))
+    if "habitation" in module:
+        lines.append("      <workforce race=%s capacity=\"%d\" />" %
+                     (quoteattr(module["race"]), module["habitation"]))
+    if "product" in module:
+        ware, method = module["product"]
+        queue = "        <queue ware=%s" % (quoteattr(ware))
+        if method != "default":
+            queue += " method=%s" % (quoteattr(method))
+        lines += [
+            "      <production wares=%s>" % (quoteattr(ware)), queue + " />",
+            "      </production>"
+        ]
+    if "cargo" in module:
+        lines.append("      <cargo max=\"%d\" tags=%s />" %
+                     (module["cargo"][0], quoteattr(module["cargo"][1])))
+    lines.append("    </properties>")
+    if len(module["connections"]) > 0:
+        lines.append("    <connections>")
+        for i, macro in enumerate(module["connections"]):
+            lines += [
+                "      <connection ref=\"con_%02d\">" % (i + 1),
+                "        <macro ref=%s connection=\"space\" />" %
+                (quoteattr(macro)), "      </connection>"
+            ]
+        lines.append("    </connections>")
+    lines += ["  </macro>", "</macros>"]
+    return "\n".join(lines) + "\n"
+
+
+def make_component_xml(name, module_class, connections):
+    lines = [
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<components>",
+        "  <component name=%s class=%s>" %
+        (quoteattr(name), quoteattr(module_class)), "    <connections>",
+        "      <connection name=\"container\" tags=\"contents\" />"
+    ]
+    for i, tags in enumerate(connections):
+        lines.append("      <connection name=\"con_%03d\" tags=%s />" %
+                     (i + 1, quoteattr(tags)))
+    lines += ["    </connections>", "  </component>", "</components>"]
+    return "\n".join(lines) + "\n"
+
+
+def add_docking_bays(package):
+    """
+    Add macros of docking bays and launch tubes referenced by dock areas.
+    """
+    for name, external, capacity, tags in DOCKING_BAYS:
+        macro = "dockingbay_gen_%s_macro" % (name)
+        path = "assets/props/surfaceelements/macros/%s" % (macro)
+        package.add_macro(
+            macro, path, "\n".join([
+                "<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<macros>",
+                "  <macro name=%s class=\"dockingbay\">" % (quoteattr(macro)),
+                "    <properties>",
+                "      <dock external=\"%d\" capacity=\"%d\" />" %
+                (external, capacity),
+                "      <docksize tags=%s />" % (quoteattr(tags)),
+                "    </properties>", "  </macro>", "</macros>"
+            ]) + "\n")
+
+
+def make_modules(rng, texts, package, prefix, count, text_base, wares):
+    """
+    Make station modules and add their macros and components to the package.
+    """
+    classes = []
+    for module_class, share in MODULE_CLASSES:
+        classes += [module_class] * max(1, int(count * share))
+    classes += ["production"] * max(1, count - len(classes))
+    classes = classes[:max(count, 1)]
+
+    produced = [w for w in wares if len(w["productions"]) > 0]
+    modules = []
+    for i, module_class in enumerate(classes):
+        tid = text_base + i * 2 + 1
+        module = {
+            "class": module_class,
+            "description": texts.add(PAGE_MODULES, tid + 1, "description",
+                                     tid + 1),
+            "race": None,
+            "player": i % 10 != 9,
+            "hull": rng.randint(10, 500) * 1000,
+            "explosiondamage": rng.randint(1, 100) * 100,
+            "connections": []
+        }
+        connections = []
+
+        if module_class == "production":
+            # Modules of the same ware share a component, racial ones limit
+            # races of the others.
+            ware = produced[(i // 3) % len(produced)]
+            methods = list(ware["productions"])
+            if i % 3 != 0:
+                module["race"] = RACES[i % 6]
+            method = module["race"] if module["race"] in methods else "default"
+            module["product"] = (ware["id"], method)
+            module["workforce"] = rng.choice([30, 60, 90, 120, 180])
+            component = "%sprod_gen_%s" % (prefix, ware["id"])
+            wid = int(ware["name"][1:-1].split(",")[1])
+            module["name"] = texts.add_reference(PAGE_MODULES, tid,
+                                                 "{%d,%d}" % (PAGE_WARES, wid),
+                                                 "module")
+        else:
+            component = "%s%s_gen_%03d" % (prefix, module_class, i)
+            module["name"] = texts.add(PAGE_MODULES, tid, "module", tid)
+
+        if module_class == "habitation":
+            module["race"] = PLAYER_RACES[i % len(PLAYER_RACES)]
+            module["habitation"] = rng.choice([250, 500, 1000])
+        elif module_class == "storage":
+            module["cargo"] = (rng.randint(1, 100) * 10000,
+                               ["container", "solid", "liquid"][i % 3])
+        elif module_class in ("dockarea", "pier"):
+            for j in range(rng.randint(1, 4)):
+                module["connections"].append(
+                    "dockingbay_gen_%s_macro" %
+                    (rng.choice(DOCKING_BAYS)[0]))
+            for j in range(rng.randint(0, 2)):
+                module["connections"].append(
+                    "launchtube_gen_%s_%02d_macro" % (rng.choice(["s", "m"]),
+                                                     j + 1))
+        elif module_class == "defencemodule":
+            connections = [
+                rng.choice(DEFENCE_TAGS) for j in range(rng.randint(2, 16))
+            ]
+
+        module["macro"] = "%s%s_gen_%03d_macro" % (prefix, module_class, i)
+        module["component"] = component
+        if component not in package.components:
+            package.add_component(
+                component, "assets/structures/%s/%s" % (module_class,
+                                                        component),
+                make_component_xml(component, module_class, connections))
+        package.add_macro(
+            module["macro"], "assets/structures/%s/macros/%s" %
+            (module_class, module["macro"]), make_macro_xml(module))
+        modules.append(module)
+
+    return modules
+
+
+def make_module_groups(modules):
+    lines = ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<groups>"]
+    for i in range(0, len(modules), 5):
+        lines.append("  <group name=\"%s\">" % (modules[i]["macro"][:-6]))
+        for module in modules[i:i + 5]:
+            lines.append("    <select macro=%s />" %
+                         (quoteattr(module["macro"])))
+        lines.append("  </group>")
+    lines.append("</groups>")
+    return "\n".join(lines) + "\n"
+
+
+def add_texts(package, texts, languages):
+    for language in languages:
+        package.add("t/0001-l%03d.xml" % (language), texts.xml(language))
+
+
+def main():
+    #Parse argument
+    parser = argparse.ArgumentParser(
+        description="Generate synthetic game data for benchmarks.")
+    parser.add_argument("-o",
+                        "--output",
+                        type=str,
+                        required=True,
+                        help="Output directory, used as the game path.")
+    parser.add_argument("--modules",
+                        type=int,
+                        default=300,
+                        help="Number of station modules of the game.")
+    parser.add_argument("--wares",
+                        type=int,
+                        default=100,
+                        help="Number of wares of the game.")
+    parser.add_argument("--extensions",
+                        type=int,
+                        default=2,
+                        help="Number of extensions.")
+    parser.add_argument("--extension-modules",
+                        type=int,
+                        default=40,
+                        help="Number of station modules of each extension.")
+    parser.add_argument("--extension-wares",
+                        type=int,
+                        default=10,
+                        help="Number of wares of each extension.")
+    parser.add_argument("--languages",
+                        type=int,
+                        default=3,
+                        help="Number of languages of texts, at most %d." %
+                        (len(LANGUAGES)))
+    parser.add_argument("--extra-texts",
+                        type=int,
+                        default=20000,
+                        help="Number of texts not used by the calculator.")
+    parser.add_argument("--description-words",
+                        type=int,
+                        default=24,
+                        help="Number of words in each description.")
+    parser.add_argument("--cat-files",
+                        type=int,
+                        default=9,
+                        help="Number of cat files, at least 9.")
+    parser.add_argument("--seed", type=int, default=0, help="Random seed.")
+
+    args = parser.parse_args()
+    rng = random.Random(args.seed)
+    languages = LANGUAGES[:max(1, min(args.languages, len(LANGUAGES)))]
+    root = os.path.abspath(args.output)
+    os.makedirs(root, exist_ok=True)
+
+    # Executable.
+    exe_path = os.path.join(root, "X4")
+    with open(exe_path, "wb") as f:
+        f.write("#! /bin/sh\n".encode(encoding="utf-8"))
+    os.chmod(exe_path, os.stat(exe_path).st_mode | stat.S_IXUSR)
+
+    # Game.
+    texts = Texts(args.description_words)
+    game = Package("")
+
+    game.add(
+        "libraries/races.xml", "\n".join(
+            ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<races>"] + [
+                "  <race id=\"%s\" name=%s description=%s tags=\"\" />" %
+                (race, quoteattr(texts.add(PAGE_RACES, i * 2 + 1, "race", i +
+                                           1)),
+                 quoteattr(
+                     texts.add(PAGE_RACES, i * 2 + 2, "description", i * 2 +
+                               2))) for i, race in enumerate(RACES)
+            ] + ["</races>"]) + "\n")
+
+    game.add(
+        "libraries/waregroups.xml", "\n".join(
+            ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<groups>"] + [
+                "  <group id=\"%s\" name=%s tags=\"%s\" />" %
+                (group, quoteattr(texts.add(PAGE_GROUPS, i + 1, "group", i + 1)),
+                 tag) for i, (group, tag) in enumerate(WARE_GROUPS)
+            ] + ["</groups>"]) + "\n")
+
+    wares = make_base_wares(rng, texts, args.wares)
+    workunit = {
+        "id": "workunit_busy",
+        "name": "",
+        "description": "",
+        "group": "",
+        "transport": "",
+        "volume": 1,
+        "tags": "workunit",
+        "price": 1,
+        "productions": make_workunit(wares)
+    }
+    game.add(
+        "libraries/wares.xml", "\n".join(
+            ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<wares>"] +
+            [make_ware_xml(w) for w in wares + [workunit]] + ["</wares>"]) +
+        "\n")
+
+    add_docking_bays(game)
+    modules = make_modules(rng, texts, game, "", args.modules, 0, wares)
+    game.add("libraries/modulegroups.xml", make_module_groups(modules))
+
+    for i in range(args.extra_texts):
+        texts.add(PAGE_EXTRA + i // EXTRA_TEXTS_PER_PAGE,
+                  i % EXTRA_TEXTS_PER_PAGE + 1, "extra", i)
+    add_texts(game, texts, languages)
+    game.write(root, ["%02d" % (i + 1) for i in range(max(9, args.cat_files))])
+
+    # Extensions, their wares are added by diff and their modules may
+    # produce wares of the game.
+    module_count = len(modules)
+    ware_count = len(wares)
+    for i in range(args.extensions):
+        name = "ego_dlc_gen_%02d" % (i + 1)
+        prefix = "ext%02d_" % (i + 1)
+        text_base = (i + 1) * EXTENSION_TEXT_ID_STEP
+        ext_root = os.path.join(root, "extensions", name)
+        os.makedirs(ext_root, exist_ok=True)
+
+        ext_texts = Texts(args.description_words)
+        extension = Package("extensions/%s/" % (name))
+        ext_wares = make_wares(rng, ext_texts, prefix,
+                               max(1, args.extension_wares), text_base,
+                               [w["id"] for w in wares])
+        extension.add(
+            "libraries/wares.xml", "\n".join(
+                ["<?xml version=\"1.0\" encoding=\"utf-8\"?>", "<diff>",
+                 "<add sel=\"/wares\">"] +
+                [make_ware_xml(w) for w in ext_wares] + ["</add>", "</diff>"])
+            + "\n")
+        ext_modules = make_modules(rng, ext_texts, extension, prefix,
+                                   args.extension_modules, text_base,
+                                   ext_wares + wares)
+        extension.add("libraries/modulegroups.xml",
+                      make_module_groups(ext_modules))
+        add_texts(extension, ext_texts, languages)
+        extension.write(ext_root, ["ext_01"])
+
+        module_count += len(ext_modules)
+        ware_count += len(ext_wares)
+
+    print("Generated %d modules, %d wares, %d extensions and %d languages "
+          "in \"%s\"." %
+          (module_count, ware_count, args.extensions, len(languages), root))
+
+    return 0
+
+
+if __name__ == "__main__":
+    exit(main())
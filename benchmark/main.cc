@@ -0,0 +1,121 @@
+#include <iostream>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <config.h>
+#include <game_data/game_data.h>
+#include <global.h>
+#include <locale/string_table.h>
+
+#include "benchmark.h"
+
+/**
+ * @brief		Entery.
+ *
+ * @param[in]	argc		Count of arguments.
+ * @param[in]	argv		Values of arguments.
+ *
+ * @return		Exit code.
+ */
+int main(int argc, char *argv[])
+{
+    Q_INIT_RESOURCE(resources);
+
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("X4 Station Calculator");
+
+    // Arguments.
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Benchmarks of X4 Station Calculator. Cases which require game data "
+        "are skipped if the game data cannot be loaded.");
+    parser.addHelpOption();
+    QCommandLineOption gamePathOption(
+        "game-path",
+        "Path of game, such as one made by generate_game_data.py. The "
+        "configured one is used by default.",
+        "path");
+    QCommandLineOption filterOption(
+        "filter", "Only run cases whose names match the regular expression.",
+        "regex", ".*");
+    QCommandLineOption formatOption("format", "Format of results, csv or json.",
+                                    "format", "csv");
+    QCommandLineOption outputOption(
+        "output", "File to write results, standard output by default.",
+        "path");
+    QCommandLineOption minTimeOption(
+        "min-time", "Minimum time of a sample(ms).", "ms", "200");
+    QCommandLineOption listOption("list", "List cases.");
+    parser.addOptions({gamePathOption, filterOption, formatOption,
+                       outputOption, minTimeOption, listOption});
+    parser.process(app);
+
+    // A given game path has its own config and snapshot, so the ones of the
+    // calculator are not changed.
+    if (parser.isSet(gamePathOption)) {
+        app.setApplicationName("X4 Station Calculator Benchmark");
+    }
+
+    // Initialize.
+    int    exitCode;
+    int    fakeArgc    = 1;
+    char * fakeArgv[]  = {argv[0], NULL};
+    char **fakeArgvPtr = fakeArgv;
+    if (Global::initialize(fakeArgc, fakeArgvPtr, exitCode) == nullptr) {
+        return exitCode;
+    }
+
+    if (Config::initialize() == nullptr) {
+        return 1;
+    }
+    if (parser.isSet(gamePathOption)) {
+        Config::instance()->setString(
+            "/gamePath", QDir(parser.value(gamePathOption)).absolutePath());
+    }
+
+    if (StringTable::initialize() == nullptr) {
+        return 1;
+    }
+
+    // Cases.
+    Benchmark benchmark(parser.value(minTimeOption).toLongLong());
+    addGameDataBenchmarks(benchmark);
+    addSummaryBenchmarks(benchmark);
+    addSaveBenchmarks(benchmark);
+
+    if (parser.isSet(listOption)) {
+        for (const auto &name : benchmark.names()) {
+            ::std::cout << name.toStdString() << ::std::endl;
+        }
+        return 0;
+    }
+
+    // Load game data, the cases using it are skipped on failure.
+    HeadlessGameDataLoadingSink sink(parser.value(gamePathOption));
+    if (GameData::initialize(&sink) == nullptr) {
+        qWarning() << "Failed to load game data.";
+    }
+
+    // Run.
+    QRegularExpression filter(parser.value(filterOption));
+    auto               results = benchmark.run(filter);
+    QByteArray         output  = parser.value(formatOption) == "json"
+                                     ? Benchmark::toJson(results)
+                                     : Benchmark::toCsv(results);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (! file.open(QIODevice::OpenModeFlag::WriteOnly)) {
+            qWarning() << "Failed to open" << file.fileName() << ".";
+            return 1;
+        }
+        file.write(output);
+    } else {
+        ::std::cout << output.toStdString();
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+
+#include <save/save.h>
+
+#include "benchmark.h"
+
+/// Modules in each group of saves.
+#define BENCHMARK_GROUP_SIZE 50
+
+/**
+ * @brief		Make a save.
+ *
+ * @param[in]	modules		Number of modules.
+ *
+ * @return		Save, \c nullptr if game data is not loaded.
+ */
+static ::std::shared_ptr<Save> makeSave(int modules)
+{
+    QStringList macros = benchmarkModules();
+    if (macros.empty()) {
+        return nullptr;
+    }
+
+    // Macros in a group must be unique.
+    int groupSize = ::std::min(BENCHMARK_GROUP_SIZE, (int)(macros.size()));
+    auto save     = Save::create();
+    for (int i = 0; i < modules; i += groupSize) {
+        auto group = SaveGroup::create();
+        group->setName(QString("Group %1").arg(i / groupSize));
+        for (int j = 0; j < groupSize && i + j < modules; ++j) {
+            group->insertModule(-1, macros[(i + j) % macros.size()],
+                                (i + j) % 10 + 1);
+        }
+        save->insertGroup(-1, group);
+    }
+
+    return save;
+}
+
+/**
+ * @brief		Add benchmarks of saves.
+ */
+void addSaveBenchmarks(Benchmark &benchmark)
+{
+    for (int modules : {100, 1000, 10000}) {
+        // Write JSON.
+        benchmark.addCase(
+            QString("save/write/%1").arg(modules),
+            [modules]() -> Benchmark::Function {
+                auto save = makeSave(modules);
+                auto dir  = ::std::make_shared<QTemporaryDir>();
+                if (save == nullptr || ! dir->isValid()) {
+                    return nullptr;
+                }
+                QString path = QDir(dir->path()).absoluteFilePath(
+                    "station.x4station");
+
+                return [save, dir, path,
+                        modules](quint64 iterations) -> quint64 {
+                    for (quint64 i = 0; i < iterations; ++i) {
+                        save->write(path);
+                    }
+                    return modules;
+                };
+            });
+
+        // Load JSON.
+        benchmark.addCase(
+            QString("save/load/%1").arg(modules),
+            [modules]() -> Benchmark::Function {
+                auto save = makeSave(modules);
+                auto dir  = ::std::make_shared<QTemporaryDir>();
+                if (save == nullptr || ! dir->isValid()) {
+                    return nullptr;
+                }
+                QString path = QDir(dir->path()).absoluteFilePath(
+                    "station.x4station");
+                if (! save->write(path)) {
+                    return nullptr;
+                }
+
+                return [dir, path, modules](quint64 iterations) -> quint64 {
+                    for (quint64 i = 0; i < iterations; ++i) {
+                        auto loaded = Save::load(path);
+                        Benchmark::keep(loaded);
+                    }
+                    return modules;
+                };
+            });
+    }
+}
@@ -0,0 +1,208 @@
+#include <game_data/game_data.h>
+#include <summary/station_simulation.h>
+#include <summary/station_summary.h>
+#include <summary/station_variants.h>
+
+#include "benchmark.h"
+
+/**
+ * @brief		Make modules of a station.
+ *
+ * @param[in]	instances	Number of module instances.
+ *
+ * @return		Macros and amounts of modules, each instance is an entry.
+ */
+static QVector<QPair<QString, quint64>> makeStation(int instances)
+{
+    QVector<QPair<QString, quint64>> ret;
+    QStringList                      macros = benchmarkModules();
+    if (macros.empty()) {
+        return ret;
+    }
+
+    ret.reserve(instances);
+    for (int i = 0; i < instances; ++i) {
+        ret.append({macros[i % macros.size()], 1});
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Add benchmarks of station summary.
+ */
+void addSummaryBenchmarks(Benchmark &benchmark)
+{
+    for (int instances : {1000, 10000, 100000}) {
+        // Rebuild and make summary.
+        benchmark.addCase(
+            QString("summary/make/%1").arg(instances),
+            [instances]() -> Benchmark::Function {
+                auto modules = makeStation(instances);
+                if (modules.empty()) {
+                    return nullptr;
+                }
+                auto table = GameData::instance()->stationModules()->table();
+
+                return [table, modules](quint64 iterations) -> quint64 {
+                    for (quint64 i = 0; i < iterations; ++i) {
+                        StationSummary summary;
+                        summary.reset(table, modules);
+                        auto info = summary.make();
+                        Benchmark::keep(info);
+                    }
+                    return modules.size();
+                };
+            });
+
+        // Sum counters of each instance, the way summaries were made before
+        // the module table, as the baseline of the table kernel.
+        benchmark.addCase(
+            QString("summary/sum_instances/%1").arg(instances),
+            [instances]() -> Benchmark::Function {
+                auto modules = makeStation(instances);
+                if (modules.empty()) {
+                    return nullptr;
+                }
+                auto stationModules = GameData::instance()->stationModules();
+
+                return [stationModules,
+                        modules](quint64 iterations) -> quint64 {
+                    typedef GameStationModules::StationModule StationModule;
+                    for (quint64 i = 0; i < iterations; ++i) {
+                        GameStationModuleTable::Sums sums;
+                        sums.fill(0);
+                        for (const auto &entry : modules) {
+                            auto module = stationModules->module(entry.first);
+                            for (int c = 0; c < StationModule::CounterCount;
+                                 ++c) {
+                                sums[c] += module->counters[c] * entry.second;
+                            }
+                            sums[GameStationModuleTable::Hull]
+                                += module->hull * entry.second;
+                            sums[GameStationModuleTable::ExplosionDamage]
+                                += module->explosiondamage * entry.second;
+                        }
+                        Benchmark::keep(sums);
+                    }
+                    return modules.size();
+                };
+            });
+
+        // Sum counters with the module table.
+        benchmark.addCase(
+            QString("summary/sum_table/%1").arg(instances),
+            [instances]() -> Benchmark::Function {
+                auto modules = makeStation(instances);
+                if (modules.empty()) {
+                    return nullptr;
+                }
+                auto table = GameData::instance()->stationModules()->table();
+
+                return [table, modules](quint64 iterations) -> quint64 {
+                    for (quint64 i = 0; i < iterations; ++i) {
+                        QVector<quint32> weights = table->makeWeights();
+                        for (const auto &entry : modules) {
+                            weights[table->id(entry.first)] += entry.second;
+                        }
+                        auto sums = table->sum(weights);
+                        Benchmark::keep(sums);
+                    }
+                    return modules.size();
+                };
+            });
+    }
+
+    // Change amount of a module in a large station.
+    benchmark.addCase("summary/add", []() -> Benchmark::Function {
+        auto modules = makeStation(100000);
+        if (modules.empty()) {
+            return nullptr;
+        }
+        auto summary = ::std::make_shared<StationSummary>();
+        summary->reset(GameData::instance()->stationModules()->table(),
+                       modules);
+        QString macro = modules.front().first;
+
+        return [summary, macro](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                summary->add(macro, (i & 1) ? -1 : 1);
+                auto info = summary->make();
+                Benchmark::keep(info);
+            }
+            return 1;
+        };
+    });
+
+    // Solve suggested amounts.
+    benchmark.addCase("summary/solve", []() -> Benchmark::Function {
+        auto modules = makeStation(1000);
+        if (modules.empty()) {
+            return nullptr;
+        }
+        auto summary = ::std::make_shared<StationSummary>();
+        summary->reset(GameData::instance()->stationModules()->table(),
+                       modules);
+
+        return [summary](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                auto info = summary->make();
+                summary->solveSuggestedAmounts(info);
+                Benchmark::keep(info);
+            }
+            return 1;
+        };
+    });
+
+    // Simulate storage of a station for a week, items are steps.
+    benchmark.addCase("summary/simulate", []() -> Benchmark::Function {
+        auto modules = makeStation(1000);
+        if (modules.empty()) {
+            return nullptr;
+        }
+        auto simulation = ::std::make_shared<StationSimulation>(
+            GameData::instance()->stationModules()->table(),
+            GameData::instance()->wares(), modules);
+        StationSimulation::Options options;
+
+        return [simulation, options](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                auto result = simulation->run(options);
+                Benchmark::keep(result);
+            }
+            return options.duration / options.step;
+        };
+    });
+
+    // Evaluate variants of a station, items are variants.
+    benchmark.addCase("summary/variants", []() -> Benchmark::Function {
+        QStringList macros = benchmarkModules();
+        if (macros.size() < 5) {
+            return nullptr;
+        }
+        auto group = SaveGroup::create();
+        for (const auto &macro : macros) {
+            group->insertModule(-1, macro, 4);
+        }
+        auto save = Save::create();
+        save->insertGroup(-1, group);
+        auto variants = ::std::make_shared<StationVariants>(
+            GameData::instance()->stationModules()->table(),
+            GameData::instance()->wares(), save);
+        for (int i = 0; i < 5; ++i) {
+            variants->addAmountSweep(macros[i], -2, 2);
+        }
+
+        return [variants](quint64 iterations) -> quint64 {
+            for (quint64 i = 0; i < iterations; ++i) {
+                auto result = variants->evaluate(
+                    StationVariants::RankBy::Surplus, 1000,
+                    []() -> bool {
+                        return false;
+                    });
+                Benchmark::keep(result);
+            }
+            return variants->count();
+        };
+    });
+}
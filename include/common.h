@@ -10,5 +10,7 @@
 #include <common/generic_reference.h>
 //#include <common/generic_string.h>
 #include <common/multi_threading.h>
+#include <common/rate.h>
+#include <common/trace.h>
 #include <common/types.h>
 #include <common/xml_loader.h>
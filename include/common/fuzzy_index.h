@@ -0,0 +1,93 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/**
+ * @brief	Fuzzy text index. Each document has several fields, documents
+ *			are found by substrings, subsequences or trigrams of the query so
+ *			a typo is tolerated. Documents are referred by their indices.
+ */
+class FuzzyIndex {
+  public:
+    /**
+     * @brief	Matched document.
+     */
+    struct Match {
+        quint32 id;    ///< Index of the document.
+        qint32  score; ///< Score, higher is better.
+    };
+
+  private:
+    QVector<QStringList>    m_documents;  ///< Case folded fields.
+    QHash<quint64, quint32> m_trigramIDs; ///< IDs of trigrams.
+    QVector<quint32>
+        m_postingOffsets; ///< Offsets of documents of each trigram, has one
+                          ///< more item than trigrams.
+    QVector<quint32> m_postings; ///< Documents containing each trigram.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	documents	Fields of each document.
+     */
+    FuzzyIndex(const QVector<QStringList> &documents);
+
+    /**
+     * @brief		Get number of documents.
+     *
+     * @return		Number of documents.
+     */
+    quint32 size() const;
+
+    /**
+     * @brief		Search documents.
+     *
+     * @param[in]	query		Query.
+     * @param[in]	cancelled	Checked while searching, returns \c true to
+     *							stop.
+     *
+     * @return		Matched documents in descending order of score, empty if
+     *				cancelled.
+     */
+    QVector<Match> search(const QString &                query,
+                          const ::std::function<bool()> &cancelled) const;
+
+  private:
+    /**
+     * @brief		Get trigrams of a text.
+     *
+     * @param[in]	text		Text.
+     *
+     * @return		Distinct trigrams.
+     */
+    static QVector<quint64> trigrams(const QString &text);
+
+    /**
+     * @brief		Check if characters of the query are in a text in order.
+     *
+     * @param[in]	query		Case folded query.
+     * @param[in]	text		Case folded text.
+     *
+     * @return		\c true if the query is a subsequence of the text.
+     */
+    static bool subsequence(const QString &query, const QString &text);
+
+    /**
+     * @brief		Score a text.
+     *
+     * @param[in]	query			Case folded query.
+     * @param[in]	queryTrigrams	Trigrams of the query.
+     * @param[in]	text			Case folded text.
+     *
+     * @return		Score, 0 if not matched.
+     */
+    static qint32 score(const QString &         query,
+                        const QVector<quint64> &queryTrigrams,
+                        const QString &         text);
+};
@@ -3,3 +3,4 @@
 #include <common/multi_threading/background_task.h>
 #include <common/multi_threading/multi_run.h>
 #include <common/multi_threading/simple_thread.h>
+#include <common/multi_threading/task_graph.h>
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QMutex>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+/**
+ * @brief	Run tasks in multiple threads in the order of their dependencies.
+ *
+ * A task is started as soon as all the tasks it depends on have finished
+ * successfully. Once a task failed, no more task will be started.
+ */
+class TaskGraph {
+  public:
+    /**
+     * @brief	Task function, returns \c false if the task failed.
+     */
+    typedef ::std::function<bool()> TaskFunc;
+
+  private:
+    /**
+     * @brief	Task.
+     */
+    struct Task {
+        QString      name;         ///< Name of the task.
+        TaskFunc     func;         ///< Task function.
+        int          dependencies; ///< Number of dependencies.
+        QVector<int> dependents;   ///< Tasks depend on the task.
+        int          remaining;    ///< Number of unfinished dependencies.
+    };
+
+  private:
+    QVector<Task>  m_tasks;         ///< Tasks.
+    QMutex         m_lock;          ///< Lock.
+    QWaitCondition m_cond;          ///< Condition variable.
+    QQueue<int>    m_readyTasks;    ///< Tasks ready to run.
+    int            m_runningCount;  ///< Number of running tasks.
+    int            m_finishedCount; ///< Number of finished tasks.
+    int            m_failedTask;    ///< Failed task, -1 if no task failed.
+
+  public:
+    /**
+     * @brief		Constructor.
+     */
+    TaskGraph();
+
+    /**
+     * @brief		Add task.
+     *
+     * @param[in]	name			Name of the task.
+     * @param[in]	func			Task function.
+     * @param[in]	dependencies	Tasks the new task depends on.
+     *
+     * @return		ID of the new task.
+     */
+    int addTask(const QString &     name,
+                TaskFunc            func,
+                const QVector<int> &dependencies = {});
+
+    /**
+     * @brief		Get number of tasks.
+     *
+     * @return		Number of tasks.
+     */
+    int taskCount() const;
+
+    /**
+     * @brief		Get name of the task.
+     *
+     * @param[in]	id		ID of the task.
+     *
+     * @return		Name of the task.
+     */
+    const QString &taskName(int id) const;
+
+    /**
+     * @brief		Run all tasks and wait until finished.
+     *
+     * @param[in]	signleThread	True if run in signle thread.
+     *
+     * @return		\c true if all tasks finished successfully, otherwise
+     *				returns \c false.
+     */
+    bool run(bool signleThread = false);
+
+    /**
+     * @brief		Get the task which failed.
+     *
+     * @return		ID of the failed task, -1 if no task failed.
+     */
+    int failedTask() const;
+
+    /**
+     * @brief	Destructor.
+     */
+    virtual ~TaskGraph();
+
+  private:
+    /**
+     * @brief	Worker thread function.
+     */
+    void work();
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+/**
+ * @brief   Rate of a ware each hour, in fixed point.
+ *
+ * The rate is kept as an integer of 1/Scale units, so sums of rates are
+ * exact and the same on all platforms. Convert to floating point only to
+ * show the rate.
+ */
+class Rate {
+  public:
+    static constexpr qint64 Scale = 1000000; ///< Units in a ware.
+
+  private:
+    qint64 m_value; ///< Rate in 1/Scale units each hour.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   value       Rate in 1/Scale units each hour.
+     */
+    constexpr explicit Rate(qint64 value) : m_value(value) {}
+
+    /**
+     * @brief       Divide and round half away from zero.
+     *
+     * @param[in]   dividend    Dividend.
+     * @param[in]   divisor     Divisor, must be positive.
+     *
+     * @return      Quotient.
+     */
+    static constexpr qint64 divRound(qint64 dividend, qint64 divisor)
+    {
+        return dividend >= 0 ? (dividend + divisor / 2) / divisor
+                             : -((-dividend + divisor / 2) / divisor);
+    }
+
+  public:
+    /**
+     * @brief       Constructor, zero rate.
+     */
+    constexpr Rate() : m_value(0) {}
+
+    /**
+     * @brief       Make rate of a production cycle.
+     *
+     * @param[in]   amount      Amount each cycle.
+     * @param[in]   time        Time of each cycle(s).
+     *
+     * @return      Rate, zero if the time is not positive.
+     */
+    static constexpr Rate perCycle(qint64 amount, qint64 time)
+    {
+        return time > 0 ? Rate(divRound(amount * 3600 * Scale, time)) : Rate();
+    }
+
+    /**
+     * @brief       Make rate from 1/Scale units each hour.
+     *
+     * @param[in]   value       Rate in 1/Scale units each hour.
+     *
+     * @return      Rate.
+     */
+    static constexpr Rate fromRaw(qint64 value)
+    {
+        return Rate(value);
+    }
+
+    /**
+     * @brief       Get rate in 1/Scale units each hour.
+     *
+     * @return      Rate in 1/Scale units each hour.
+     */
+    constexpr qint64 raw() const
+    {
+        return m_value;
+    }
+
+    /**
+     * @brief       Get rate rounded to units each hour.
+     *
+     * @return      Rounded rate.
+     */
+    constexpr qint64 round() const
+    {
+        return divRound(m_value, Scale);
+    }
+
+    /**
+     * @brief       Convert to floating point, only for showing.
+     *
+     * @return      Rate each hour.
+     */
+    double toDouble() const
+    {
+        return static_cast<double>(m_value) / Scale;
+    }
+
+    /**
+     * @brief       Multiply by a ratio and round.
+     *
+     * @param[in]   numerator       Numerator.
+     * @param[in]   denominator     Denominator, must be positive.
+     *
+     * @return      Scaled rate.
+     */
+    constexpr Rate scaled(qint64 numerator, qint64 denominator) const
+    {
+        return Rate(divRound(m_value * numerator, denominator));
+    }
+
+    /**
+     * @brief       Get how many times of another rate is needed to reach
+     *              this rate.
+     *
+     * @param[in]   rate        Rate, must be positive.
+     *
+     * @return      Times rounded up, 0 if this rate is not positive.
+     */
+    constexpr qint64 ceilDiv(const Rate &rate) const
+    {
+        return m_value <= 0 ? 0
+                            : (m_value + rate.m_value - 1) / rate.m_value;
+    }
+
+    /**
+     * @brief       Get ratio to another rate.
+     *
+     * @param[in]   rate        Rate, must be positive. This rate must be
+     *                          less than Scale times of it.
+     *
+     * @return      Ratio in 1/Scale.
+     */
+    constexpr qint64 ratio(const Rate &rate) const
+    {
+        return divRound(m_value * Scale, rate.m_value);
+    }
+
+    // Operators.
+    constexpr Rate operator+(const Rate &rate) const
+    {
+        return Rate(m_value + rate.m_value);
+    }
+
+    constexpr Rate operator-(const Rate &rate) const
+    {
+        return Rate(m_value - rate.m_value);
+    }
+
+    constexpr Rate operator-() const
+    {
+        return Rate(-m_value);
+    }
+
+    constexpr Rate operator*(qint64 times) const
+    {
+        return Rate(m_value * times);
+    }
+
+    Rate &operator+=(const Rate &rate)
+    {
+        m_value += rate.m_value;
+        return *this;
+    }
+
+    Rate &operator-=(const Rate &rate)
+    {
+        m_value -= rate.m_value;
+        return *this;
+    }
+
+    constexpr bool operator==(const Rate &rate) const
+    {
+        return m_value == rate.m_value;
+    }
+
+    constexpr bool operator!=(const Rate &rate) const
+    {
+        return m_value != rate.m_value;
+    }
+
+    constexpr bool operator<(const Rate &rate) const
+    {
+        return m_value < rate.m_value;
+    }
+
+    constexpr bool operator<=(const Rate &rate) const
+    {
+        return m_value <= rate.m_value;
+    }
+
+    constexpr bool operator>(const Rate &rate) const
+    {
+        return m_value > rate.m_value;
+    }
+
+    constexpr bool operator>=(const Rate &rate) const
+    {
+        return m_value >= rate.m_value;
+    }
+};
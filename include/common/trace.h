@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+/**
+ * @brief	Trace recorder, the trace is written in Chrome trace format
+ *			which can be opened by chrome://tracing or Perfetto.
+ */
+class Trace {
+  public:
+    /**
+     * @brief	Scope, a span is recorded from construction to destruction
+     *			if trace is enabled.
+     */
+    class Scope {
+      private:
+        bool    m_enabled; ///< Trace is enabled when the scope begins.
+        QString m_name;    ///< Name of the span.
+        qint64  m_begin;   ///< Begin time(us).
+
+      public:
+        /**
+         * @brief		Constructor.
+         *
+         * @param[in]	name		Name of the span.
+         */
+        Scope(const char *name);
+
+        /**
+         * @brief		Constructor.
+         *
+         * @param[in]	name		Name of the span.
+         */
+        Scope(const QString &name);
+
+        /**
+         * @brief		Destructor.
+         */
+        ~Scope();
+    };
+
+  private:
+    /**
+     * @brief	Complete event.
+     */
+    struct Event {
+        QString name;     ///< Name.
+        quint64 threadId; ///< Thread ID.
+        qint64  begin;    ///< Begin time(us).
+        qint64  duration; ///< Duration(us).
+    };
+
+  private:
+    static ::std::atomic<bool>    _enabled;     ///< Trace enabled.
+    static QElapsedTimer          _timer;       ///< Timer.
+    static QMutex                 _lock;        ///< Lock.
+    static QVector<Event>         _events;      ///< Events.
+    static QMap<quint64, QString> _threadNames; ///< Names of threads.
+
+  public:
+    /**
+     * @brief	Enable trace, the time of events is relative to the time
+     *			this function called.
+     */
+    static void enable();
+
+    /**
+     * @brief	Disable trace and free recorded events.
+     */
+    static void disable();
+
+    /**
+     * @brief		Check if trace is enabled.
+     *
+     * @return		\c true if enabled, otherwise returns \c false.
+     */
+    static bool enabled();
+
+    /**
+     * @brief		Write trace.
+     *
+     * @param[in]	path		Path of the file.
+     *
+     * @return		\c true if the trace is written, otherwise returns
+     *				\c false.
+     */
+    static bool save(const QString &path);
+
+  private:
+    /**
+     * @brief		Get current time.
+     *
+     * @return		Time since trace enabled(us).
+     */
+    static qint64 now();
+
+    /**
+     * @brief		Record an event.
+     *
+     * @param[in]	name		Name of the event.
+     * @param[in]	begin		Begin time(us).
+     * @param[in]	end			End time(us).
+     */
+    static void record(const QString &name, qint64 begin, qint64 end);
+};
@@ -164,4 +164,34 @@ class Range {
 
         return *this;
     }
+
+    /**
+     * @brief       Operator "==".
+     *
+     * @tparam      T1      Data type.
+     * @param[in]   range   Range to compare.
+     *
+     * @return      \c true if both boundaries are equal, otherwise returns
+     *              \c false.
+     */
+    template<typename T1>
+    bool operator==(const Range<T1, incLB, incRB> &range) const
+    {
+        return m_min == range.min() && m_max == range.max();
+    }
+
+    /**
+     * @brief       Operator "!=".
+     *
+     * @tparam      T1      Data type.
+     * @param[in]   range   Range to compare.
+     *
+     * @return      \c true if any boundary differs, otherwise returns
+     *              \c false.
+     */
+    template<typename T1>
+    bool operator!=(const Range<T1, incLB, incRB> &range) const
+    {
+        return ! (*this == range);
+    }
 };
@@ -7,6 +7,7 @@
 
 #include <common.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 #include <locale/string_table.h>
 
 class GameVFS;
@@ -17,10 +18,12 @@ class GameVFS;
 class GameComponents :
     public ILoadFactoryFunc<GameComponents,
                             ::std::shared_ptr<GameVFS>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameComponents> {
     LOAD_FUNC(GameComponents,
               ::std::shared_ptr<GameVFS>,
               ::std::function<void(const QString &)>);
+    SNAPSHOT_FUNC(GameComponents)
 
     QMap<QString, QString> m_components; ///< Components
 
@@ -34,6 +37,13 @@ class GameComponents :
     GameComponents(::std::shared_ptr<GameVFS>             vfs,
                    ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     */
+    GameComponents(QDataStream &stream);
+
   public:
     /**
      * @brief	Get component.
@@ -42,6 +52,13 @@ class GameComponents :
      */
     QString component(const QString &id);
 
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
 
+#include <common/multi_threading.h>
 #include <game_data/game_components.h>
+#include <game_data/game_data_loading_sink.h>
 #include <game_data/game_macros.h>
 #include <game_data/game_races.h>
 #include <game_data/game_station_modules.h>
@@ -10,38 +16,50 @@
 #include <game_data/game_vfs.h>
 #include <game_data/game_wares.h>
 #include <interfaces/i_singleton.h>
-#include <ui/splash/splash_widget.h>
 
 /// Minimum number of cat files.
 #define MIN_CAT_FILE_NUM 9
 
+/// Delay before reloading after game files changed(ms).
+#define GAME_DATA_RELOAD_DELAY 2000
+
+class GameDataSnapshot;
+
 /**
  * @brief   Game datas.
  */
-class GameData : public QObject, public ISingleton<GameData, SplashWidget *> {
+class GameData : public QObject,
+                 public ISingleton<GameData, IGameDataLoadingSink *> {
     Q_OBJECT
   private:
-    SIGNLETON_OBJECT(GameData, SplashWidget *)
+    SIGNLETON_OBJECT(GameData, IGameDataLoadingSink *)
 
   private:
-    QString                           m_gamePath;   ///< Game path.
-    ::std::shared_ptr<GameVFS>        m_vfs;        ///< Game VFS
-    ::std::shared_ptr<GameTexts>      m_texts;      ///< Game texts.
-    ::std::shared_ptr<GameMacros>     m_macros;     ///< Game macros.
-    ::std::shared_ptr<GameComponents> m_components; ///< Game components.
-    ::std::shared_ptr<GameRaces>      m_races;      ///< Game races.
-    ::std::shared_ptr<GameWares>      m_wares;      ///< Game wares
+    QString                               m_gamePath;   ///< Game path.
+    QMap<QString, GameVFS::CatFileInfo>   m_catFiles;   ///< Cat files.
+    QMutex                                m_vfsLock;    ///< Lock of game VFS.
+    ::std::shared_ptr<GameVFS>            m_vfs;        ///< Game VFS
+    ::std::shared_ptr<GameTexts>          m_texts;      ///< Game texts.
+    ::std::shared_ptr<GameMacros>         m_macros;     ///< Game macros.
+    ::std::shared_ptr<GameComponents>     m_components; ///< Game components.
+    ::std::shared_ptr<GameRaces>          m_races;      ///< Game races.
+    ::std::shared_ptr<GameWares>          m_wares;      ///< Game wares
     ::std::shared_ptr<GameStationModules>
         m_stationModules; ///< Station modules.
+    QMutex                                m_dataLock;    ///< Lock of game data.
+    QMap<QString, QByteArray>             m_inputFingerprints; ///< Fingerprints.
+    QFileSystemWatcher *                  m_watcher;     ///< Watcher of files.
+    QTimer *                              m_reloadTimer; ///< Reloading delay.
+    BackgroundTask *                      m_reloadTask;  ///< Reloading task.
 
   protected:
     /**
      * @brief		Constructor.
      *
-     * @param[in]	splashWidget		Splash widget.
+     * @param[in]	sink		Receiver of progress and errors.
      *
      */
-    GameData(SplashWidget *splashWidget);
+    GameData(IGameDataLoadingSink *sink);
 
   public:
     /**
@@ -55,6 +73,19 @@ class GameData : public QObject, public ISingleton<GameData, SplashWidget *> {
      */
     bool checkGamePath(const QString &path);
 
+    /**
+     * @brief		Check path of game.
+     *
+     * @param[in]	path		Path of the game.
+     * @param[out]	catFiles	Cat files found.
+     *
+     * @return		True if the path of game is available, otherwise returns
+     *				false.
+     *
+     */
+    static bool checkGamePath(const QString &                      path,
+                              QMap<QString, GameVFS::CatFileInfo> &catFiles);
+
     /**
      * @brief		Check path of game.
      *
@@ -66,6 +97,19 @@ class GameData : public QObject, public ISingleton<GameData, SplashWidget *> {
      */
     bool setGamePath(const QString &path);
 
+    /**
+     * @brief	Watch game files and reload changed game data in background,
+     *			\c dataReloaded() is emitted after reloaded. It should be
+     *			called in the thread of the application.
+     */
+    void enableHotReload();
+
+    /**
+     * @brief	Reload game data in background with the game path in config.
+     *			Only loaders whose inputs changed are run.
+     */
+    void requestReload();
+
     /**
      * @brief Destructor.
      */
@@ -73,7 +117,8 @@ class GameData : public QObject, public ISingleton<GameData, SplashWidget *> {
 
   public:
     /*
-     * @brief	Get game VFS.
+     * @brief	Get game VFS, it is loaded when first used if the game data
+     *			was loaded from snapshot.
      *
      * @return	Game VFS.
      */
@@ -123,25 +168,53 @@ class GameData : public QObject, public ISingleton<GameData, SplashWidget *> {
 
   private:
     /**
-     * @brief		Check path of game.
+     * @brief		Load game data.
      *
-     * @param[in]	path		Path of the game.
-     * @param[out]	catFiles	Cat files found.
+     * @param[in]	vfs			Game VFS.
+     * @param[in]	sink		Receiver of progress and errors.
+     * @param[in]	data		Data loaded. Data of loaders in \c keep are
+     *							kept.
+     * @param[in]	keep		Names of loaders to skip.
      *
-     * @return		True if the path of game is available, otherwise returns
-     *				false.
+     * @return		\c true if loaded, otherwise returns \c false.
+     */
+    bool loadGameData(::std::shared_ptr<GameVFS> vfs,
+                      IGameDataLoadingSink *     sink,
+                      GameDataSnapshot &         data,
+                      const QSet<QString> &      keep);
+
+    /**
+     * @brief		Reload game data.
+     *
+     * @param[in]	gamePath	Path of the game.
+     */
+    void reload(const QString &gamePath);
+
+    /**
+     * @brief		Update paths watched for hot reloading.
+     */
+    void updateWatchedPaths();
+
+    /**
+     * @brief		Get paths of inputs of each loader.
+     *
+     * @param[in]	gamePath	Path of the game.
      *
+     * @return		Relative paths of inputs, keyed by name of loader.
      */
-    bool checkGamePath(const QString &                      path,
-                       QMap<QString, GameVFS::CatFileInfo> &catFiles);
+    static QMap<QString, QStringList> inputPaths(const QString &gamePath);
 
     /**
-     * @brief		Ask game path.
+     * @brief		Compute fingerprints of inputs of each loader.
      *
-     * @return		True if the path of game is selected, otherwise returns
-     *				false.
+     * @param[in]	gamePath	Path of the game.
+     * @param[in]	vfs			Game VFS.
+     *
+     * @return		Fingerprints, keyed by name of loader.
      */
-    bool askGamePath();
+    static QMap<QString, QByteArray>
+        inputFingerprints(const QString &            gamePath,
+                          ::std::shared_ptr<GameVFS> vfs);
 
   signals:
     /**
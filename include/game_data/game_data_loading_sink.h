@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QtCore/QString>
+
+/**
+ * @brief	Receiver of progress and errors while loading game data.
+ *
+ * @note	Methods may be called from any thread.
+ */
+class IGameDataLoadingSink {
+  public:
+    /**
+     * @brief		Show progress.
+     *
+     * @param[in]	text		Progress text.
+     */
+    virtual void setText(const QString &text) = 0;
+
+    /**
+     * @brief		Show error.
+     *
+     * @param[in]	message		Error message.
+     */
+    virtual void showError(const QString &message) = 0;
+
+    /**
+     * @brief		Ask for path of game.
+     *
+     * @param[in]	current		Current path of game.
+     * @param[out]	path		Path selected.
+     *
+     * @return		\c true if a path is selected, \c false if loading
+     *				should be aborted.
+     */
+    virtual bool askGamePath(const QString &current, QString &path) = 0;
+
+    /**
+     * @brief	Destructor.
+     */
+    virtual ~IGameDataLoadingSink() {}
+};
+
+/**
+ * @brief	Loading sink without GUI, progress and errors are written to
+ *			log.
+ */
+class HeadlessGameDataLoadingSink : public IGameDataLoadingSink {
+  private:
+    QString m_gamePath; ///< Path of game used if configured one fails.
+    bool    m_asked;    ///< Path of game has been asked.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	gamePath	Path of game, used if the configured path is
+     *							not available.
+     */
+    HeadlessGameDataLoadingSink(const QString &gamePath = "");
+
+    /**
+     * @brief		Show progress.
+     *
+     * @param[in]	text		Progress text.
+     */
+    virtual void setText(const QString &text) override;
+
+    /**
+     * @brief		Show error.
+     *
+     * @param[in]	message		Error message.
+     */
+    virtual void showError(const QString &message) override;
+
+    /**
+     * @brief		Ask for path of game, the path given to constructor is
+     *				returned once.
+     *
+     * @param[in]	current		Current path of game.
+     * @param[out]	path		Path selected.
+     *
+     * @return		\c true if a path is selected, \c false if loading
+     *				should be aborted.
+     */
+    virtual bool askGamePath(const QString &current, QString &path) override;
+
+    /**
+     * @brief	Destructor.
+     */
+    virtual ~HeadlessGameDataLoadingSink();
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include <game_data/game_components.h>
+#include <game_data/game_macros.h>
+#include <game_data/game_races.h>
+#include <game_data/game_station_modules.h>
+#include <game_data/game_texts.h>
+#include <game_data/game_wares.h>
+
+/// Magic number of snapshot file.
+#define GAME_DATA_SNAPSHOT_MAGIC 0x58345344
+
+/**
+ * @brief	Version of snapshot format. Increase it whenever the layout of
+ *			the snapshot or the result of loading game data changes.
+ */
+#define GAME_DATA_SNAPSHOT_VERSION 3
+
+/**
+ * @brief	Snapshot of loaded game data.
+ */
+class GameDataSnapshot {
+  public:
+    ::std::shared_ptr<GameTexts>          texts;          ///< Game texts.
+    ::std::shared_ptr<GameMacros>         macros;         ///< Game macros.
+    ::std::shared_ptr<GameComponents>     components;     ///< Game components.
+    ::std::shared_ptr<GameRaces>          races;          ///< Game races.
+    ::std::shared_ptr<GameWares>          wares;          ///< Game wares.
+    ::std::shared_ptr<GameStationModules> stationModules; ///< Station modules.
+    QMap<QString, QByteArray>
+        inputFingerprints; ///< Fingerprints of inputs of each loader.
+
+  public:
+    /**
+     * @brief		Compute fingerprint of game files, including loose inputs of
+     *			loaders in all subdirectories.
+     *
+     * @param[in]	gamePath	Path of the game.
+     *
+     * @return		Fingerprint.
+     */
+    static QByteArray fingerprint(const QString &gamePath);
+
+    /**
+     * @brief		Load snapshot.
+     *
+     * @param[in]	path		Path of the snapshot file.
+     * @param[in]	fingerprint	Fingerprint of game files.
+     *
+     * @return		\c true if the snapshot is loaded, otherwise returns
+     *				\c false.
+     */
+    bool load(const QString &path, const QByteArray &fingerprint);
+
+    /**
+     * @brief		Save snapshot.
+     *
+     * @param[in]	path		Path of the snapshot file.
+     * @param[in]	fingerprint	Fingerprint of game files.
+     *
+     * @return		\c true if the snapshot is saved, otherwise returns
+     *				\c false.
+     */
+    bool save(const QString &path, const QByteArray &fingerprint);
+};
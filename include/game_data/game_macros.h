@@ -7,6 +7,7 @@
 
 #include <common.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 
 class GameVFS;
 
@@ -16,10 +17,12 @@ class GameVFS;
 class GameMacros :
     public ILoadFactoryFunc<GameMacros,
                             ::std::shared_ptr<GameVFS>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameMacros> {
     LOAD_FUNC(GameMacros,
               ::std::shared_ptr<GameVFS>,
               ::std::function<void(const QString &)>);
+    SNAPSHOT_FUNC(GameMacros)
 
   private:
     QMap<QString, QString> m_macros; ///< Macros
@@ -34,6 +37,13 @@ class GameMacros :
     GameMacros(::std::shared_ptr<GameVFS>             vfs,
                ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     */
+    GameMacros(QDataStream &stream);
+
   public:
     /**
      * @brief	Get macro.
@@ -42,6 +52,13 @@ class GameMacros :
      */
     QString macro(const QString &id);
 
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <common/rate.h>
+#include <game_data/game_station_modules.h>
+
+/**
+ * @brief	Production balancing solver. Computes the integer amounts of
+ *			production and habitation modules of a whole production chain
+ *			which supply the target rates of products with the least surplus.
+ *
+ * @note	Each ware is produced by one production method. The method of each
+ *			ware is selected by branch-and-bound, the search stops at the time
+ *			limit and returns the best layout found.
+ */
+class GameProductionSolver {
+  public:
+    /**
+     * @brief	Options of solver.
+     */
+    struct Options {
+        QMap<QString, quint64>
+            workforce; ///< Share of workforce of each race. Production
+                       ///< modules run at full workforce and habitation
+                       ///< modules are added if not empty.
+        QVector<QString>
+            methodOrder; ///< Preferred production methods, the first one
+                         ///< is the most preferred one.
+        QSet<QString> resources;       ///< Wares bought instead of produced.
+        QMap<QString, Rate>
+            keptRates; ///< Net rates of wares of modules kept out of the
+                       ///< solver, products are positive and resources
+                       ///< are negative.
+        qint64 keptWorkforce = 0; ///< Workforce supplied minus workforce
+                                  ///< required by modules kept out of the
+                                  ///< solver.
+        qint64 timeLimit = 200;   ///< Time limit of searching(ms).
+    };
+
+    /**
+     * @brief	Result of solver.
+     */
+    struct Result {
+        QMap<QString, quint64> modules; ///< Amount of modules, indexed by
+                                        ///< macro.
+        QMap<QString, Rate> products;  ///< Surplus of wares produced per
+                                       ///< hour, including targets.
+        QMap<QString, Rate> resources; ///< Wares bought per hour.
+        quint64 workforce; ///< Workforce required.
+        bool    optimal;   ///< The search is complete.
+    };
+
+  private:
+    /**
+     * @brief	Resource consumed by a module.
+     */
+    struct Consumption {
+        int  ware; ///< Index of ware.
+        Rate rate; ///< Rate per module per hour.
+    };
+
+    /**
+     * @brief	Module which can produce a ware.
+     */
+    struct Candidate {
+        ::std::shared_ptr<GameStationModules::StationModule>
+                module;    ///< Station module.
+        Rate    rate;      ///< Product per module per hour.
+        quint64 workforce; ///< Workforce required per module.
+        QString method;    ///< Production method.
+        int     rank;      ///< Rank of the production method.
+        QVector<Consumption> resources; ///< Resources.
+    };
+
+    /**
+     * @brief	Habitation module of a race.
+     */
+    struct Habitation {
+        ::std::shared_ptr<GameStationModules::StationModule>
+                             module;    ///< Station module.
+        quint64              share;     ///< Share of workforce.
+        quint64              workforce; ///< Workforce supplied per module.
+        QVector<Consumption> resources; ///< Resources.
+    };
+
+    /**
+     * @brief	Selected candidate of a ware.
+     */
+    struct Choice {
+        int     candidate; ///< Index of candidate, -1 if the ware is bought.
+        quint64 amount;    ///< Amount of modules.
+    };
+
+    /**
+     * @brief	Cost of a layout, compared in order.
+     */
+    struct Cost {
+        qint64  waste;   ///< Idle modules, in 1/Rate::Scale modules.
+        quint64 rank;    ///< Sum of ranks of production methods.
+        quint64 modules; ///< Amount of modules.
+    };
+
+    /**
+     * @brief	Search context.
+     */
+    struct Context {
+        QVector<Rate>   demand;    ///< Demand of each ware.
+        QVector<Choice> choices;   ///< Current choices.
+        Cost            cost;      ///< Cost of current choices.
+        quint64         workforce; ///< Workforce of current choices.
+        QVector<Choice> best;      ///< Best choices.
+        Cost            bestCost;  ///< Cost of best choices.
+        bool            found;     ///< A layout has been found.
+        bool            timeout;   ///< Time limit reached.
+        quint64         nodes;     ///< Nodes searched.
+        QElapsedTimer   timer;     ///< Timer.
+    };
+
+  private:
+    Options m_options; ///< Options.
+    QMap<QString, QVector<Candidate>>
+        m_candidates; ///< Candidates of each ware, ordered by rank.
+    QVector<Habitation> m_habitations; ///< Habitation modules.
+    quint64             m_totalShare;  ///< Sum of shares of habitations.
+
+    // Index of wares, built by solve().
+    QVector<QString>   m_wares; ///< Wares, consumers come first.
+    QMap<QString, int> m_index; ///< Index of wares.
+    QVector<QVector<Candidate>>
+        m_wareCandidates; ///< Candidates of each ware, indexed by ware.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	modules		Modules can be used.
+     * @param[in]	options		Options.
+     */
+    GameProductionSolver(
+        const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+            &          modules,
+        const Options &options);
+
+    /**
+     * @brief		Solve.
+     *
+     * @param[in]	targets		Target rates of products per hour.
+     *
+     * @return		Result.
+     */
+    Result solve(const QMap<QString, Rate> &targets);
+
+  private:
+    /**
+     * @brief		Get rank of production method.
+     *
+     * @param[in]	method		Production method.
+     *
+     * @return		Rank, the smaller the more preferred.
+     */
+    int methodRank(const QString &method) const;
+
+    /**
+     * @brief		Index wares needed by targets, consumers come before
+     *				their resources.
+     *
+     * @param[in]	targets		Target rates of products per hour.
+     */
+    void indexWares(const QMap<QString, Rate> &targets);
+
+    /**
+     * @brief		Make resources indexed by wares.
+     *
+     * @param[in]	rates		Rates of resources.
+     * @param[in]	max			Use maximum rates.
+     *
+     * @return		Resources.
+     */
+    QVector<Consumption> makeConsumptions(
+        const QVector<GameStationModules::StationModule::WareRate> &rates,
+        bool                                                        max);
+
+    /**
+     * @brief		Get workforce habitation modules of the solver supply.
+     *
+     * @param[in]	workforce	Workforce required by production modules of
+     *							the solver.
+     *
+     * @return		Workforce not supplied by modules kept out of the solver.
+     */
+    quint64 requiredWorkforce(quint64 workforce) const;
+
+    /**
+     * @brief		Get amount of habitation modules.
+     *
+     * @param[in]	workforce	Workforce required.
+     *
+     * @return		Amount of each habitation module.
+     */
+    QVector<quint64> habitationAmounts(quint64 workforce) const;
+
+    /**
+     * @brief		Search layouts.
+     *
+     * @param[in]	context		Search context.
+     * @param[in]	index		Index of ware.
+     */
+    void search(Context &context, int index);
+
+    /**
+     * @brief		Compare costs.
+     *
+     * @param[in]	cost1		Cost 1.
+     * @param[in]	cost2		Cost 2.
+     *
+     * @return		\c true if cost1 is less than cost2.
+     */
+    static bool less(const Cost &cost1, const Cost &cost2);
+};
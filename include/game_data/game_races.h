@@ -9,6 +9,7 @@
 #include <common.h>
 #include <game_data/game_texts.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 
 class GameVFS;
 
@@ -19,11 +20,13 @@ class GameRaces :
     public ILoadFactoryFunc<GameRaces,
                             ::std::shared_ptr<GameVFS>,
                             ::std::shared_ptr<GameTexts>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameRaces> {
     LOAD_FUNC(GameRaces,
               ::std::shared_ptr<GameVFS>,
               ::std::shared_ptr<GameTexts>,
               ::std::function<void(const QString &)>);
+    SNAPSHOT_FUNC(GameRaces)
 
   public:
     /**
@@ -51,6 +54,13 @@ class GameRaces :
               ::std::shared_ptr<GameTexts>           texts,
               ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     */
+    GameRaces(QDataStream &stream);
+
   public:
     /**
      * @brief	Get race information.
@@ -66,6 +76,13 @@ class GameRaces :
      */
     static const QSet<QString> &playerRaces();
 
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
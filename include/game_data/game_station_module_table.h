@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <game_data/game_station_modules.h>
+
+/**
+ * @brief	Station modules in structure-of-arrays layout. Each attribute is
+ *			stored in a contiguous column indexed by a dense module ID, so a
+ *			station summary is a weighted sum of the columns.
+ */
+class GameStationModuleTable {
+  public:
+    /**
+     * @brief	Attributes, the counters of station modules come first.
+     */
+    enum Attribute {
+        Hull = GameStationModules::StationModule::CounterCount, ///< Hull.
+        ExplosionDamage, ///< Explosion damage.
+        AttributeCount   ///< Number of attributes.
+    };
+
+    typedef ::std::array<quint64, AttributeCount>
+        Sums; ///< Weighted sums of attributes.
+
+  private:
+    QVector<::std::shared_ptr<GameStationModules::StationModule>>
+                           m_modules; ///< Modules, indexed by ID.
+    QMap<QString, quint32> m_ids;     ///< Module IDs, indexed by macro.
+    quint32                m_size;    ///< Number of modules.
+    quint32                m_stride;  ///< Size of columns, padded.
+    QVector<quint32>       m_columns; ///< Columns, each has m_stride items.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	modules		Station modules, the index of the module is
+     *							used as ID.
+     */
+    GameStationModuleTable(
+        const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+            &modules);
+
+    /**
+     * @brief		Get number of modules.
+     *
+     * @return		Number of modules.
+     */
+    quint32 size() const;
+
+    /**
+     * @brief		Get ID of module.
+     *
+     * @param[in]	macro		Macro of the module.
+     *
+     * @return		ID of the module, or -1 if not found.
+     */
+    qint64 id(const QString &macro) const;
+
+    /**
+     * @brief		Get module.
+     *
+     * @param[in]	id			ID of the module.
+     *
+     * @return		Module.
+     */
+    ::std::shared_ptr<GameStationModules::StationModule>
+        module(quint32 id) const;
+
+    /**
+     * @brief		Get column of attribute.
+     *
+     * @param[in]	attribute	Attribute.
+     *
+     * @return		Values of the attribute, indexed by module ID.
+     */
+    const quint32 *column(Attribute attribute) const;
+
+    /**
+     * @brief		Make a weights vector which can be passed to sum().
+     *
+     * @return		Weights vector filled with 0.
+     */
+    QVector<quint32> makeWeights() const;
+
+    /**
+     * @brief		Compute weighted sums of all attributes in one pass.
+     *
+     * @param[in]	weights		Amount of each module, indexed by module ID,
+     *							created by makeWeights().
+     *
+     * @return		Weighted sums.
+     */
+    Sums sum(const QVector<quint32> &weights) const;
+};
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
 
 #include <common.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 
 #include <game_data/game_vfs.h>
 
@@ -21,6 +24,8 @@ class GameVFS;
 class GameMacros;
 class GameTexts;
 class GameWares;
+class GameStationModuleTable;
+class GameWareGraph;
 
 /**
  * @brief	Station modules in game.
@@ -32,7 +37,10 @@ class GameStationModules :
                             ::std::shared_ptr<GameTexts>,
                             ::std::shared_ptr<GameWares>,
                             ::std::shared_ptr<GameComponents>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameStationModules,
+                     ::std::shared_ptr<GameWares>,
+                     ::std::shared_ptr<GameTexts>> {
     LOAD_FUNC(GameStationModules,
               ::std::shared_ptr<GameVFS>,
               ::std::shared_ptr<GameMacros>,
@@ -40,6 +48,9 @@ class GameStationModules :
               ::std::shared_ptr<GameWares>,
               ::std::shared_ptr<GameComponents>,
               ::std::function<void(const QString &)>);
+    SNAPSHOT_FUNC(GameStationModules,
+                  ::std::shared_ptr<GameWares>,
+                  ::std::shared_ptr<GameTexts>)
 
   public:
     /**
@@ -117,6 +128,46 @@ class GameStationModules :
         quint32            explosiondamage; ///< Explosion damage.
         QMap<Property::Type, ::std::shared_ptr<Property>>
             properties; ///< Properties.
+
+        /**
+         * @brief	Index of numeric counters.
+         */
+        enum Counter {
+            MTurretCount,           ///< M turrets.
+            MShieldCount,           ///< M shields.
+            LTurretCount,           ///< L turrets.
+            LShieldCount,           ///< L shields.
+            SDockCount,             ///< S docking bays.
+            MDockCount,             ///< M docking bays.
+            LDockCount,             ///< L docking bays.
+            XLDockCount,            ///< XL docking bays.
+            LXLDockCount,           ///< L/XL docking bays.
+            SShipCargoCapacity,     ///< S ship cargo capacity.
+            MShipCargoCapacity,     ///< M ship cargo capacity.
+            SLaunchTubeCount,       ///< S launch tubes.
+            MLaunchTubeCount,       ///< M launch tubes.
+            SupplyWorkforceAmount,  ///< Workforce supplied.
+            RequireWorkforceAmount, ///< Workforce required.
+            ContainerCargoSize,     ///< Container cargo size(m^3).
+            SolidCargoSize,         ///< Solid cargo size(m^3).
+            LiquidCargoSize,        ///< Liquid cargo size(m^3).
+            CounterCount            ///< Number of counters.
+        };
+
+        /**
+         * @brief	Rate of a ware, per module per hour.
+         */
+        struct WareRate {
+            QString                  ware;          ///< Ware ID.
+            Rate                     min;           ///< Minimum rate.
+            Rate                     max;           ///< Maximum rate.
+            GameWares::TransportType transportType; ///< Transport type.
+        };
+
+        ::std::array<quint64, CounterCount>
+                          counters;  ///< Counters, built from properties.
+        QVector<WareRate> products;  ///< Products, built from properties.
+        QVector<WareRate> resources; ///< Resources, built from properties.
     };
 
     /**
@@ -429,12 +480,45 @@ class GameStationModules :
         enum { S, M, L, XL, L_XL } type; ///< Type.
     };
 
+    /**
+     * @brief	Parsed connection macro, shared by all modules which use the
+     *			macro.
+     */
+    struct ConnectionMacroInfo {
+        QVector<TmpDockingBayInfo> dockingBays; ///< Docking bays.
+    };
+
+    /**
+     * @brief	Parsed component, shared by all modules which use the
+     *			component.
+     */
+    struct ComponentInfo {
+        quint64 mTurretCount;  ///< Count of M turrets.
+        quint64 lTurretCount;  ///< Count of L turrets.
+        quint64 mShieldCount;  ///< Count of M shields.
+        quint64 lShieldCount;  ///< Count of L shields.
+        bool    hasProperties; ///< Component has properties, they are
+                               ///< parsed for each module.
+    };
+
   private:
     QVector<::std::shared_ptr<StationModule>> m_modules; ///< Station modules.
     QMap<QString, ::std::shared_ptr<StationModule>>
         m_modulesIndex; ///< Station modules index.
+    ::std::shared_ptr<GameStationModuleTable>
+        m_table; ///< Station modules in structure-of-arrays layout.
+    ::std::shared_ptr<GameWareGraph>
+        m_wareGraph; ///< Producers and consumers of wares.
     QMap<QString, QVector<::std::shared_ptr<StationModule>>>
         m_componentTmpIndex; ///< Temporart component index.
+    QStringList   m_macroTmpList; ///< Temporary list of macros to load.
+    QSet<QString> m_macroTmpSet;  ///< Macros in \c m_macroTmpList.
+    QMap<QString, ::std::shared_ptr<ConnectionMacroInfo>>
+           m_connectionMacroCache; ///< Parsed connection macros.
+    QMutex m_connectionMacroCacheLock; ///< Lock of parsed connection macros.
+    QMap<QString, ::std::shared_ptr<ComponentInfo>>
+           m_componentCache;     ///< Parsed components.
+    QMutex m_componentCacheLock; ///< Lock of parsed components.
     static QMap<QString, StationModule::StationModuleClass>
         _classMap; ///< Station module class map.
 
@@ -456,6 +540,17 @@ class GameStationModules :
                        ::std::shared_ptr<GameComponents>      components,
                        ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     * @param[in]	wares		Game wares.
+     * @param[in]	texts		Game texts.
+     */
+    GameStationModules(QDataStream &                stream,
+                       ::std::shared_ptr<GameWares> wares,
+                       ::std::shared_ptr<GameTexts> texts);
+
   public:
     /**
      * @brief		Get modules.
@@ -471,6 +566,27 @@ class GameStationModules :
      */
     ::std::shared_ptr<StationModule> module(const QString &macro);
 
+    /**
+     * @brief		Get modules in structure-of-arrays layout.
+     *
+     * @return		Table of modules.
+     */
+    ::std::shared_ptr<GameStationModuleTable> table() const;
+
+    /**
+     * @brief		Get producers and consumers of wares.
+     *
+     * @return		Ware graph.
+     */
+    ::std::shared_ptr<GameWareGraph> wareGraph() const;
+
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
@@ -536,13 +652,34 @@ class GameStationModules :
      * @param[in]	texts		Game texts.
      * @param[in]	wares		Game wares.
      * @param[in]	components	Game components.
+     *
+     * @return		Modules defined in the macro.
+     */
+    QVector<::std::shared_ptr<StationModule>>
+        loadMacro(const QString &                   macro,
+                  ::std::shared_ptr<GameVFS>        vfs,
+                  ::std::shared_ptr<GameMacros>     macros,
+                  ::std::shared_ptr<GameTexts>      texts,
+                  ::std::shared_ptr<GameWares>      wares,
+                  ::std::shared_ptr<GameComponents> components);
+
+    /**
+     * @brief		Limit races of modules share the same component. Racial
+     *				modules take their races away from generic modules.
+     *
+     * @param[in]	module		Module to add to the component index.
      */
-    void loadMacro(const QString &                   macro,
-                   ::std::shared_ptr<GameVFS>        vfs,
-                   ::std::shared_ptr<GameMacros>     macros,
-                   ::std::shared_ptr<GameTexts>      texts,
-                   ::std::shared_ptr<GameWares>      wares,
-                   ::std::shared_ptr<GameComponents> components);
+    void limitRacesByComponent(::std::shared_ptr<StationModule> module);
+
+    /**
+     * @brief		Build counters and rates of the module from its
+     *				properties.
+     *
+     * @param[in]	module		Module.
+     * @param[in]	wares		Wares.
+     */
+    static void buildCounters(::std::shared_ptr<StationModule> module,
+                              ::std::shared_ptr<GameWares>     wares);
 
     /**
      * @brief		Start element callback in module macro.
@@ -729,6 +866,21 @@ class GameStationModules :
                              ::std::shared_ptr<GameWares>      wares,
                              ::std::shared_ptr<GameComponents> components);
 
+    /**
+     * @brief		Get parsed connection macro, the macro is parsed when first
+     *				used.
+     *
+     * @param[in]	macro		Maro to load.
+     * @param[in]	vfs			Virtual filesystem of the game.
+     * @param[in]	macros		Game macros.
+     *
+     * @return		Parsed connection macro.
+     */
+    ::std::shared_ptr<ConnectionMacroInfo>
+        connectionMacroInfo(const QString &               macro,
+                            ::std::shared_ptr<GameVFS>    vfs,
+                            ::std::shared_ptr<GameMacros> macros);
+
     /**
      * @brief		Start element callback in connection macro.
      *
@@ -736,17 +888,17 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
-     * @param[in]	module		Station module.
+     * @param[in]	macroInfo	Parsed connection macro.
      *
      * @return		Return \c true if the parsing should be continued.
      *				otherwise returns \c false.
      */
     bool onStartElementInRootOfConnectionMacro(
-        XMLLoader &                      loader,
-        XMLLoader::Context &             context,
-        const QString &                  name,
-        const QMap<QString, QString> &   attr,
-        ::std::shared_ptr<StationModule> module);
+        XMLLoader &                            loader,
+        XMLLoader::Context &                   context,
+        const QString &                        name,
+        const QMap<QString, QString> &         attr,
+        ::std::shared_ptr<ConnectionMacroInfo> macroInfo);
 
     /**
      * @brief		Start element callback in connection macro.
@@ -755,17 +907,17 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
-     * @param[in]	module		Station module.
+     * @param[in]	macroInfo	Parsed connection macro.
      *
      * @return		Return \c true if the parsing should be continued.
      *				otherwise returns \c false.
      */
     bool onStartElementInMacrosOfConnectionMacro(
-        XMLLoader &                      loader,
-        XMLLoader::Context &             context,
-        const QString &                  name,
-        const QMap<QString, QString> &   attr,
-        ::std::shared_ptr<StationModule> module);
+        XMLLoader &                            loader,
+        XMLLoader::Context &                   context,
+        const QString &                        name,
+        const QMap<QString, QString> &         attr,
+        ::std::shared_ptr<ConnectionMacroInfo> macroInfo);
 
     /**
      * @brief		Start element callback in connection macro.
@@ -774,17 +926,17 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
-     * @param[in]	module		Station module.
+     * @param[in]	macroInfo	Parsed connection macro.
      *
      * @return		Return \c true if the parsing should be continued.
      *				otherwise returns \c false.
      */
     bool onStartElementInMacroOfConnectionMacro(
-        XMLLoader &                      loader,
-        XMLLoader::Context &             context,
-        const QString &                  name,
-        const QMap<QString, QString> &   attr,
-        ::std::shared_ptr<StationModule> module);
+        XMLLoader &                            loader,
+        XMLLoader::Context &                   context,
+        const QString &                        name,
+        const QMap<QString, QString> &         attr,
+        ::std::shared_ptr<ConnectionMacroInfo> macroInfo);
 
     /**
      * @brief		Start element callback in connection macro.
@@ -793,7 +945,6 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
-     * @param[in]	module		Station module.
      * @param[in]	info		Docking bay information.
      *
      * @return		Return \c true if the parsing should be continued.
@@ -804,7 +955,6 @@ class GameStationModules :
         XMLLoader::Context &                 context,
         const QString &                      name,
         const QMap<QString, QString> &       attr,
-        ::std::shared_ptr<StationModule>     module,
         ::std::shared_ptr<TmpDockingBayInfo> info);
 
     /**
@@ -826,6 +976,28 @@ class GameStationModules :
                        ::std::shared_ptr<GameWares>      wares,
                        ::std::shared_ptr<GameComponents> components);
 
+    /**
+     * @brief		Parse component.
+     *
+     * @param[in]	component	Component to load.
+     * @param[in]	info		Parsed component to fill, connections are
+     *							skipped if it is \c nullptr.
+     * @param[in]	module		Station module to apply properties to.
+     * @param[in]	vfs			Virtual filesystem of the game.
+     * @param[in]	macros		Game macros.
+     * @param[in]	texts		Game texts.
+     * @param[in]	wares		Game wares.
+     * @param[in]	components	Game components.
+     */
+    void parseComponent(const QString &                   component,
+                        ::std::shared_ptr<ComponentInfo>  info,
+                        ::std::shared_ptr<StationModule>  module,
+                        ::std::shared_ptr<GameVFS>        vfs,
+                        ::std::shared_ptr<GameMacros>     macros,
+                        ::std::shared_ptr<GameTexts>      texts,
+                        ::std::shared_ptr<GameWares>      wares,
+                        ::std::shared_ptr<GameComponents> components);
+
     /**
      * @brief		Start element callback in module component.
      *
@@ -833,6 +1005,7 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
+     * @param[in]	info		Parsed component.
      * @param[in]	module		Station module.
      *
      * @return		Return \c true if the parsing should be continued.
@@ -843,6 +1016,7 @@ class GameStationModules :
         XMLLoader::Context &             context,
         const QString &                  name,
         const QMap<QString, QString> &   attr,
+        ::std::shared_ptr<ComponentInfo> info,
         ::std::shared_ptr<StationModule> module);
 
     /**
@@ -852,6 +1026,7 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
+     * @param[in]	info		Parsed component.
      * @param[in]	module		Station module.
      *
      * @return		Return \c true if the parsing should be continued.
@@ -862,6 +1037,7 @@ class GameStationModules :
         XMLLoader::Context &             context,
         const QString &                  name,
         const QMap<QString, QString> &   attr,
+        ::std::shared_ptr<ComponentInfo> info,
         ::std::shared_ptr<StationModule> module);
 
     /**
@@ -871,6 +1047,7 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
+     * @param[in]	info		Parsed component.
      * @param[in]	module		Station module.
      *
      * @return		Return \c true if the parsing should be continued.
@@ -881,6 +1058,7 @@ class GameStationModules :
         XMLLoader::Context &             context,
         const QString &                  name,
         const QMap<QString, QString> &   attr,
+        ::std::shared_ptr<ComponentInfo> info,
         ::std::shared_ptr<StationModule> module);
 
     /**
@@ -890,7 +1068,7 @@ class GameStationModules :
      * @param[in]	context		Context.
      * @param[in]	name		Name of the element.
      * @param[in]	attr		Attributes.
-     * @param[in]	module		Station module.
+     * @param[in]	info		Parsed component.
      *
      * @return		Return \c true if the parsing should be continued.
      *				otherwise returns \c false.
@@ -900,5 +1078,5 @@ class GameStationModules :
         XMLLoader::Context &             context,
         const QString &                  name,
         const QMap<QString, QString> &   attr,
-        ::std::shared_ptr<StationModule> module);
+        ::std::shared_ptr<ComponentInfo> info);
 };
@@ -9,6 +9,7 @@
 
 #include <common.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 #include <QtCore/qregularexpression.h>
 
 class GameVFS;
@@ -19,10 +20,12 @@ class GameVFS;
 class GameTexts :
     public ILoadFactoryFunc<GameTexts,
                             ::std::shared_ptr<GameVFS>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameTexts> {
     LOAD_FUNC(GameTexts,
               ::std::shared_ptr<GameVFS>,
               ::std::function<void(const QString &)>)
+    SNAPSHOT_FUNC(GameTexts)
   public:
     /**
      * @brief	Game text id pair.
@@ -106,6 +109,13 @@ class GameTexts :
     GameTexts(::std::shared_ptr<GameVFS>             vfs,
               ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     */
+    GameTexts(QDataStream &stream);
+
   public:
     /**
      * @brief		Get text.
@@ -135,6 +145,13 @@ class GameTexts :
      */
     IDPair addText(const QString &str);
 
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
@@ -227,4 +244,31 @@ class GameTexts :
     QString parseEscape(const QString &s);
 };
 
+/**
+ * @brief		Write text id pair to stream.
+ *
+ * @param[in]	stream		Stream to write.
+ * @param[in]	idPair		ID pair.
+ *
+ * @return		Stream.
+ */
+inline QDataStream &operator<<(QDataStream &stream,
+                               const GameTexts::IDPair &idPair)
+{
+    return stream << idPair.pageID << idPair.textID;
+}
+
+/**
+ * @brief		Read text id pair from stream.
+ *
+ * @param[in]	stream		Stream to read.
+ * @param[out]	idPair		ID pair.
+ *
+ * @return		Stream.
+ */
+inline QDataStream &operator>>(QDataStream &stream, GameTexts::IDPair &idPair)
+{
+    return stream >> idPair.pageID >> idPair.textID;
+}
+
 #include <game_data/game_vfs.h>
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 #include <QtCore/QMap>
 #include <QtCore/QMutex>
@@ -167,6 +168,16 @@ class GameVFS : private IInitialized {
      */
     ::std::shared_ptr<DirReader> openDir(const QString &path);
 
+    /**
+     * @brief		Compute fingerprint of files, both packed files and normal
+     *				files are included. Directories are walked recursively.
+     *
+     * @param[in]	paths		Paths of files and directories.
+     *
+     * @return		Fingerprint.
+     */
+    QByteArray fingerprint(const QStringList &paths);
+
     /**
      * @brief	Destructor.
      */
@@ -181,6 +192,17 @@ class GameVFS : private IInitialized {
      * @return		Splitted data.
      */
     QStringList splitCatLine(const QString &line);
+
+    /**
+     * @brief		Add packed files to fingerprint.
+     *
+     * @param[in]	hash		Hash to update.
+     * @param[in]	path		Path of the entery.
+     * @param[in]	entry		Entery.
+     */
+    void addFingerprint(QCryptographicHash &                    hash,
+                        const QString &                         path,
+                        const ::std::shared_ptr<DatFileEntery> &entry);
 };
 
 /**
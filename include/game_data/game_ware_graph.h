@@ -0,0 +1,171 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <game_data/game_station_modules.h>
+
+/**
+ * @brief	Index of producers and consumers of wares. Wares have dense IDs,
+ *			modules are referred by the IDs of GameStationModuleTable, which
+ *			are the indices of the modules. Modules of each ware are stored in
+ *			contiguous ranges, so queries cost O(result).
+ */
+class GameWareGraph {
+  public:
+    /**
+     * @brief	Range of IDs of modules.
+     */
+    class IDRange {
+      private:
+        const quint32 *m_begin; ///< First ID.
+        const quint32 *m_end;   ///< End of IDs.
+
+      public:
+        /**
+         * @brief		Constructor.
+         *
+         * @param[in]	begin		First ID.
+         * @param[in]	end			End of IDs.
+         */
+        IDRange(const quint32 *begin, const quint32 *end) :
+            m_begin(begin), m_end(end)
+        {}
+
+        /**
+         * @brief		Get first ID.
+         *
+         * @return		Iterator of first ID.
+         */
+        const quint32 *begin() const
+        {
+            return m_begin;
+        }
+
+        /**
+         * @brief		Get end of IDs.
+         *
+         * @return		Iterator of end of IDs.
+         */
+        const quint32 *end() const
+        {
+            return m_end;
+        }
+
+        /**
+         * @brief		Get number of IDs.
+         *
+         * @return		Number of IDs.
+         */
+        int size() const
+        {
+            return static_cast<int>(m_end - m_begin);
+        }
+
+        /**
+         * @brief		Check if the range is empty.
+         *
+         * @return		\c true if empty.
+         */
+        bool empty() const
+        {
+            return m_begin == m_end;
+        }
+    };
+
+  private:
+    QVector<QString>       m_wares; ///< Wares, indexed by ID.
+    QMap<QString, quint32> m_ids;   ///< Ware IDs, indexed by ware.
+    QVector<quint32>
+        m_producerOffsets; ///< Offsets of producers of each ware, has one
+                           ///< more item than wares.
+    QVector<quint32> m_producers; ///< Producers of wares.
+    QVector<quint32>
+        m_consumerOffsets; ///< Offsets of consumers of each ware, has one
+                           ///< more item than wares.
+    QVector<quint32>     m_consumers; ///< Consumers of wares.
+    QVector<QStringList> m_methods;   ///< Production methods of each ware.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	modules		Station modules, the index of the module is
+     *							used as ID.
+     */
+    GameWareGraph(
+        const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+            &modules);
+
+    /**
+     * @brief		Get number of wares.
+     *
+     * @return		Number of wares.
+     */
+    quint32 size() const;
+
+    /**
+     * @brief		Get ID of ware.
+     *
+     * @param[in]	ware		Ware.
+     *
+     * @return		ID of ware, -1 if no module produces or consumes it.
+     */
+    qint64 id(const QString &ware) const;
+
+    /**
+     * @brief		Get ware.
+     *
+     * @param[in]	id			ID of ware.
+     *
+     * @return		Ware.
+     */
+    const QString &ware(quint32 id) const;
+
+    /**
+     * @brief		Get modules which produce a ware.
+     *
+     * @param[in]	id			ID of ware.
+     *
+     * @return		IDs of modules.
+     */
+    IDRange producers(quint32 id) const;
+
+    /**
+     * @brief		Get modules which consume a ware, including habitations.
+     *
+     * @param[in]	id			ID of ware.
+     *
+     * @return		IDs of modules.
+     */
+    IDRange consumers(quint32 id) const;
+
+    /**
+     * @brief		Get production methods of a ware used by modules.
+     *
+     * @param[in]	id			ID of ware.
+     *
+     * @return		Production methods.
+     */
+    const QStringList &methods(quint32 id) const;
+
+  private:
+    /**
+     * @brief		Build offsets and edges of modules.
+     *
+     * @param[in]	modules		Station modules.
+     * @param[in]	products	Index products if \c true, or resources.
+     * @param[out]	offsets		Offsets of each ware.
+     * @param[out]	edges		IDs of modules.
+     */
+    void buildEdges(
+        const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+            &             modules,
+        bool              products,
+        QVector<quint32> &offsets,
+        QVector<quint32> &edges);
+};
@@ -5,6 +5,7 @@
 
 #include <QtCore/QMap>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QVector>
 
@@ -12,6 +13,7 @@
 #include <game_data/game_texts.h>
 #include <game_data/game_vfs.h>
 #include <interfaces/i_load_factory_func.h>
+#include <interfaces/i_snapshot.h>
 
 class GameVFS;
 class GameTexts;
@@ -24,11 +26,13 @@ class GameWares :
     public ILoadFactoryFunc<GameWares,
                             ::std::shared_ptr<GameVFS>,
                             ::std::shared_ptr<GameTexts>,
-                            ::std::function<void(const QString &)>> {
+                            ::std::function<void(const QString &)>>,
+    public ISnapshot<GameWares> {
     LOAD_FUNC(GameWares,
               ::std::shared_ptr<GameVFS>,
               ::std::shared_ptr<GameTexts>,
               ::std::function<void(const QString &)>);
+    SNAPSHOT_FUNC(GameWares)
 
     Q_OBJECT
 
@@ -94,6 +98,7 @@ class GameWares :
   private:
     QMap<QString, ::std::shared_ptr<WareGroup>> m_wareGroups; ///< Ware groups.
     QMap<QString, ::std::shared_ptr<Ware>>      m_wares;      ///< Wares.
+    QMutex     m_lock;                 ///< Lock of wares and ware groups.
     QAtomicInt m_unknowWareIndex;      ///< Unknow ware index.
     QAtomicInt m_unknowWareGroupIndex; ///< Unknow ware group index.
 
@@ -109,6 +114,13 @@ class GameWares :
               ::std::shared_ptr<GameTexts>           texts,
               ::std::function<void(const QString &)> setTextFunc);
 
+    /**
+     * @brief		Constructor, load from snapshot.
+     *
+     * @param[in]	stream		Snapshot stream.
+     */
+    GameWares(QDataStream &stream);
+
   public:
     /**
      * @brief	Get ware group information.
@@ -133,6 +145,13 @@ class GameWares :
     ::std::shared_ptr<Ware> ware(const QString &              id,
                                  ::std::shared_ptr<GameTexts> texts = nullptr);
 
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) override;
+
     /**
      * @brief		Destructor.
      */
@@ -309,3 +328,24 @@ class GameWares :
                                        const QString &               name,
                                        const QMap<QString, QString> &attr);
 };
+
+/**
+ * @brief		Write production information to stream.
+ *
+ * @param[in]	stream		Stream to write.
+ * @param[in]	info		Production information.
+ *
+ * @return		Stream.
+ */
+QDataStream &operator<<(QDataStream &                     stream,
+                        const GameWares::ProductionInfo &info);
+
+/**
+ * @brief		Read production information from stream.
+ *
+ * @param[in]	stream		Stream to read.
+ * @param[out]	info		Production information.
+ *
+ * @return		Stream.
+ */
+QDataStream &operator>>(QDataStream &stream, GameWares::ProductionInfo &info);
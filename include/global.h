@@ -29,6 +29,8 @@ class Global : public ISingleton<Global, int &, char **&, int &> {
     ::std::map<char, ArgInfo> m_argMap;  ///< Arguments.
     QString                   m_execDir; ///< Path of current executable file.
     QString                   m_configPath;    ///< Path of config file.
+    QString                   m_snapshotPath;  ///< Path of game data snapshot.
+    QString                   m_traceStartupPath; ///< Path of startup trace.
     bool                      m_hasFileToOpen; ///< Has file to open.
     QString                   m_fileToOpen;    ///< File to open.
 
@@ -57,6 +59,20 @@ class Global : public ISingleton<Global, int &, char **&, int &> {
      */
     const QString &configPath() const;
 
+    /**
+     * @brief       Get path of game data snapshot.
+     *
+     * @return		Path of the file.
+     */
+    const QString &snapshotPath() const;
+
+    /**
+     * @brief       Get path of startup trace file.
+     *
+     * @return		Path of the file, empty if startup is not traced.
+     */
+    const QString &traceStartupPath() const;
+
     /**
      * @brief       Check if there is a file to open.
      *
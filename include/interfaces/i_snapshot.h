@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QDataStream>
+
+#include <interfaces/i_initialized.h>
+
+/**
+ * @brief	Interface for objects which can be written to and restored from
+ *			a snapshot.
+ *
+ * @tparam	T		Type of the class implements this interface.
+ * @tparam	Args	Types of the extra arguments of the snapshot constructor.
+ */
+template<class T, typename... Args>
+class ISnapshot : virtual protected IInitialized {
+  public:
+    /**
+     * @brief	Constructor.
+     */
+    ISnapshot() : IInitialized() {}
+
+    /**
+     * @brief		Load object from snapshot.
+     *
+     * @param[in]	stream		Stream to read.
+     * @param[in]	args		Extra arguments.
+     *
+     * @return		On success, a new object is reutnred. Otherwise returns
+     *				nullptr.
+     */
+    static ::std::shared_ptr<T> loadSnapshot(QDataStream &stream,
+                                             Args... args);
+
+    /**
+     * @brief		Write snapshot.
+     *
+     * @param[in]	stream		Stream to write.
+     */
+    virtual void saveSnapshot(QDataStream &stream) = 0;
+
+    /**
+     * @brief	Destructor..
+     */
+    virtual ~ISnapshot() {}
+};
+
+/**
+ * @brief		Load object from snapshot.
+ */
+template<class T, typename... Args>
+::std::shared_ptr<T> ISnapshot<T, Args...>::loadSnapshot(QDataStream &stream,
+                                                         Args... args)
+{
+    ::std::shared_ptr<T> ret(new T(stream, args...));
+
+    if (ret == nullptr || ! ret->initialized()
+        || stream.status() != QDataStream::Status::Ok) {
+        return nullptr;
+    } else {
+        return ret;
+    }
+}
+
+#define SNAPSHOT_FUNC(T, ...) friend class ISnapshot<T, ##__VA_ARGS__>;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <common/rate.h>
+#include <game_data/game_station_module_table.h>
+#include <game_data/game_wares.h>
+
+/**
+ * @brief	Time-stepped simulation of the storage of a station. Steps the
+ *			inventory of each ware over time to find when storage fills or
+ *			drains.
+ *
+ * Modules of the same macro are merged into a line. All lines run at the
+ * rates of their production cycles, scaled by the workforce. Each step a
+ * line runs as much as its resources and the free storage of its products
+ * allow. Lines are run in order and see the wares of the lines before them
+ * in the same step. Storage of each transport type is shared by all wares
+ * of the type. All habitations share one workforce, which moves in while
+ * the habitations are supplied and moves out otherwise.
+ *
+ * Amounts are integers of 1/Rate::Scale units, so results are the same on
+ * all platforms.
+ *
+ * @note	The class does not depend on Qt Widgets. run() is const and can be
+ *			called from several threads.
+ */
+class StationSimulation {
+  public:
+    /**
+     * @brief	Options of simulation.
+     */
+    struct Options {
+        qint64 duration       = 7 * 24 * 3600; ///< Time to simulate(s).
+        qint64 step           = 60;            ///< Time of each step(s).
+        qint64 sampleInterval = 3600; ///< Interval of samples(s), rounded
+                                      ///< to steps.
+        QMap<QString, quint64> stock;  ///< Initial stock of wares.
+        QMap<QString, Rate>    supply; ///< Wares bought per hour.
+        QMap<QString, Rate>    demand; ///< Wares sold per hour.
+        qint64 supplyStop = -1; ///< Time when the supply breaks(s), -1 if
+                                ///< the supply never breaks.
+        quint64 workforce = 0;  ///< Initial workforce, limited by capacity.
+        qint64  workforceGrowth
+            = Rate::Scale / 10; ///< Workforce moved in or out per hour, in
+                                ///< 1/Rate::Scale of the capacity.
+    };
+
+    /**
+     * @brief	Result of simulation. Samples are taken at the start and
+     *			after every sample interval.
+     */
+    struct Result {
+        QVector<QString> wares;     ///< Wares.
+        QVector<qint64>  times;     ///< Time of each sample(s).
+        QVector<quint64> workforce; ///< Workforce of each sample.
+        QVector<QVector<quint64>>
+            stock; ///< Stock of each ware of each sample, indexed by ware.
+        QVector<qint64> fullTime; ///< Time when the storage of each ware
+                                  ///< is full first(s), -1 if never.
+        QVector<qint64> emptyTime; ///< Time when each ware runs out first(s),
+                                   ///< -1 if never.
+        ::std::array<quint64, 3> storageCapacity; ///< Capacity of container,
+                                                  ///< solid and liquid
+                                                  ///< storage(m^3).
+        ::std::array<QVector<quint64>, 3>
+            storage; ///< Used container, solid and liquid storage of each
+                     ///< sample(m^3).
+    };
+
+  private:
+    /**
+     * @brief	What the rates of a line are scaled by.
+     */
+    enum class Scaling {
+        Efficiency, ///< Workforce share of production modules.
+        Occupancy   ///< Workforce share of habitation capacity.
+    };
+
+    /**
+     * @brief	Flow of a ware in a line, per hour.
+     */
+    struct Flow {
+        int  ware; ///< Index of ware.
+        Rate min;  ///< Rate without workforce or with empty habitations.
+        Rate max;  ///< Rate with full workforce or habitations.
+    };
+
+    /**
+     * @brief	Modules of the same macro.
+     */
+    struct Line {
+        Scaling scaling;   ///< Scaling of rates.
+        quint64 workforce; ///< Workforce supplied by habitations.
+        int     products;  ///< Index of first product.
+        int     resources; ///< Index of first resource.
+        int     end;       ///< End of resources.
+    };
+
+  private:
+    QVector<QString>   m_wares;   ///< Wares.
+    QMap<QString, int> m_index;   ///< Index of wares.
+    QVector<int>       m_types;   ///< Transport type of each ware, -1 if
+                                  ///< the ware needs no storage.
+    QVector<qint64>    m_volumes; ///< Volume of each ware(m^3).
+    QVector<Line>      m_lines;   ///< Lines.
+    QVector<Flow>      m_flows;   ///< Flows of lines, products come first.
+    ::std::array<quint64, 3> m_capacity;          ///< Storage capacity(m^3).
+    quint64                  m_requiredWorkforce; ///< Workforce required.
+    quint64                  m_workforceCapacity; ///< Workforce supplied.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	table		Table of modules.
+     * @param[in]	wares		Game wares.
+     * @param[in]	modules		Macros and amounts of modules in the station.
+     */
+    StationSimulation(::std::shared_ptr<GameStationModuleTable> table,
+                      ::std::shared_ptr<GameWares>              wares,
+                      const QVector<QPair<QString, quint64>> &  modules);
+
+    /**
+     * @brief		Run simulation.
+     *
+     * @param[in]	options		Options.
+     *
+     * @return		Result.
+     */
+    Result run(const Options &options) const;
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~StationSimulation();
+
+  private:
+    /**
+     * @brief		Get index of a ware, add the ware if not exists.
+     *
+     * @param[in]	id			Ware ID.
+     * @param[in]	wares		Game wares.
+     *
+     * @return		Index of ware.
+     */
+    int wareIndex(const QString &id, ::std::shared_ptr<GameWares> wares);
+
+    /**
+     * @brief		Add flows of a module to the flows.
+     *
+     * @param[in]	rates		Rates of the module.
+     * @param[in]	amount		Amount of the module.
+     * @param[in]	wares		Game wares.
+     */
+    void addFlows(
+        const QVector<GameStationModules::StationModule::WareRate> &rates,
+        quint64 amount, ::std::shared_ptr<GameWares> wares);
+};
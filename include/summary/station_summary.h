@@ -0,0 +1,185 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <common/rate.h>
+#include <common/types.h>
+#include <game_data/game_station_module_table.h>
+#include <game_data/game_wares.h>
+#include <save/save.h>
+
+/**
+ * @brief	Summary of a station. Keeps the weighted sums of the modules in
+ *			the station, which can be updated incrementally when amounts of
+ *			modules change.
+ *
+ * @note	The class does not depend on Qt Widgets and is not thread-safe,
+ *			each instance should be accessed by one thread at a time.
+ */
+class StationSummary {
+  public:
+    /**
+     * @brief   Summary information.
+     */
+    struct Info {
+        quint64 hull            = 0; ///< Hull.
+        quint64 explosionDamage = 0; ///< Explosion damage.
+        struct {
+            quint64 sLaunchTube = 0; ///< S launch tube..
+            quint64 mLaunchTube = 0; ///< M launch tube.
+            quint64 mTurret     = 0; ///< M turret.
+            quint64 lTurret     = 0; ///< L turret.
+        } weapons;                   ///< Weapons.
+        struct {
+            quint64 mShield = 0; ///< M shield.
+            quint64 lShield = 0; ///< L shield.
+        } shields;               ///< Shields
+        struct {
+            quint64 container = 0; ///< Container.
+            quint64 solid     = 0; ///< Solid.
+            quint64 liquid    = 0; ///< Liquid.
+        } storage;                 ///< Storage.
+        struct {
+            quint64 sDock   = 0; ///< S dock.
+            quint64 mDock   = 0; ///< M dock.
+            quint64 lDock   = 0; ///< L dock.
+            quint64 xlDock  = 0; ///< XL dock.
+            quint64 lXLDock = 0; ///< L/XL dock.
+        } dockingBay;            ///< Docking bay.
+        struct {
+            quint64 sShipCargo = 0;               ///< S ship cargo.
+            quint64 mShipCargo = 0;               ///< M ship cargo.
+        } shipStorage;                            ///< Ship storage.
+        quint64 workforce        = 0;             ///< Workforce.
+        qint64  surplusWorkforce = 0;             ///< Surplus workforce.
+        QMap<QString, Range<Rate>> resources;     ///< Resources.
+        QMap<QString, Range<Rate>> intermediates; ///< Intermediates.
+        QMap<QString, Range<Rate>> products;      ///< Products.
+        QMap<QString, qint64>
+            suggestedAmounts; ///< Suggested amounts to change, indexed by
+                              ///< macro of module.
+
+        struct {
+            bool requireContainerStorage
+                = false;                       ///< Require container storage.
+            bool requireSolidStorage  = false; ///< Require solid storage.
+            bool requireLiquidStorage = false; ///< Require liquid storage.
+        } requirements;                        ///< Requirements.
+    };
+
+  private:
+    /**
+     * @brief   Sum of a ware from all modules.
+     */
+    struct WareSummary {
+        Range<Rate>              range;         ///< Amount each hour.
+        qint64                   modules;       ///< Modules using the ware.
+        GameWares::TransportType transportType; ///< Transport type.
+    };
+
+  private:
+    ::std::shared_ptr<GameStationModuleTable>
+                                 m_table;     ///< Table of modules.
+    QVector<quint32>             m_weights;   ///< Amount of modules.
+    GameStationModuleTable::Sums m_sums;      ///< Sums of attributes.
+    QMap<QString, WareSummary>   m_products;  ///< Products.
+    QMap<QString, WareSummary>   m_resources; ///< Resources.
+
+  public:
+    /**
+     * @brief		Constructor, the summary is empty until reset() is called.
+     */
+    StationSummary();
+
+    /**
+     * @brief		Rebuild sums.
+     *
+     * @param[in]	table		Table of modules.
+     * @param[in]	modules		Macros and amounts of modules in the station.
+     */
+    void reset(::std::shared_ptr<GameStationModuleTable> table,
+               const QVector<QPair<QString, quint64>> &  modules);
+
+    /**
+     * @brief		Rebuild sums from a save.
+     *
+     * @param[in]	table		Table of modules.
+     * @param[in]	save		Save.
+     */
+    void reset(::std::shared_ptr<GameStationModuleTable> table,
+               ::std::shared_ptr<Save>                   save);
+
+    /**
+     * @brief		Add modules to the sums.
+     *
+     * @param[in]	macro		Macro of the module.
+     * @param[in]	amount		Amount to add, negative to remove.
+     */
+    void add(const QString &macro, qint64 amount);
+
+    /**
+     * @brief		Make summary from the sums.
+     *
+     * @return		Summary, suggested amounts are not solved.
+     */
+    Info make() const;
+
+    /**
+     * @brief		Solve amounts of production and habitation modules which
+     *				supply the products with the least surplus.
+     *
+     * @param[in,out]	summary		Summary made by make().
+     */
+    void solveSuggestedAmounts(Info &summary) const;
+
+    /**
+     * @brief		Check summary.
+     *
+     * @param[in]	summary		Summary.
+     *
+     * @return		IDs of warnings.
+     */
+    static QStringList check(const Info &summary);
+
+    /**
+     * @brief		Get net rates of wares, resources are negative.
+     *
+     * @param[in]	summary		Summary.
+     *
+     * @return		Net rates of wares each hour.
+     */
+    static QMap<QString, Range<Rate>> netWares(const Info &summary);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~StationSummary();
+
+  private:
+    /**
+     * @brief		Suggest amounts of habitation modules which correct the
+     *				surplus workforce and amounts of production modules which
+     *				correct the surplus of intermediates.
+     *
+     * @param[in,out]	summary		Summary made by make().
+     */
+    void suggestCorrectedAmounts(Info &summary) const;
+
+    /**
+     * @brief		Add rates of wares to the sums.
+     *
+     * @param[in]	wares		Sums of wares.
+     * @param[in]	rates		Rates of a module.
+     * @param[in]	amount		Amount of the module, negative to remove.
+     */
+    static void addWareRates(
+        QMap<QString, WareSummary> &                                wares,
+        const QVector<GameStationModules::StationModule::WareRate> &rates,
+        qint64                                                      amount);
+};
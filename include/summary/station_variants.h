@@ -0,0 +1,168 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <common/rate.h>
+#include <game_data/game_station_module_table.h>
+#include <game_data/game_wares.h>
+#include <save/save.h>
+#include <summary/station_summary.h>
+
+/**
+ * @brief	What-if batch evaluator. Evaluates the summaries of variants of a
+ *			station in parallel and ranks them.
+ *
+ * Variants are the combinations of the options of all sweeps, each option
+ * changes the amounts of some modules of the base station. Each variant is
+ * evaluated by updating a copy of the summary of the base station, so only
+ * the changed modules are summed.
+ *
+ * @note	The class does not depend on Qt Widgets and is not thread-safe,
+ *			each instance should be accessed by one thread at a time.
+ */
+class StationVariants {
+  public:
+    /**
+     * @brief	Keys to rank variants.
+     */
+    enum class RankBy {
+        Surplus,   ///< Value of products minus cost of resources, the
+                   ///< larger the better.
+        Cost,      ///< Cost of resources, the smaller the better.
+        Throughput ///< Value of products, the larger the better.
+    };
+
+    typedef QVector<QPair<QString, qint64>>
+        Changes; ///< Macros and changes of amounts of modules.
+
+    /**
+     * @brief	Sweep of a parameter.
+     */
+    struct Sweep {
+        QString          name;    ///< Name of the parameter.
+        QVector<Changes> options; ///< Options of the parameter.
+    };
+
+    /**
+     * @brief	Evaluated variant.
+     */
+    struct Variant {
+        QMap<QString, qint64> changes; ///< Changes of amounts of modules,
+                                       ///< indexed by macro.
+        qint64  surplus;          ///< Surplus per hour at full workforce(CR).
+        qint64  cost;             ///< Cost per hour at full workforce(CR).
+        qint64  throughput;       ///< Throughput per hour at full
+                                  ///< workforce(CR).
+        quint64 workforce;        ///< Workforce required.
+        qint64  surplusWorkforce; ///< Surplus workforce.
+        int     warnings;         ///< Number of warnings.
+    };
+
+  private:
+    ::std::shared_ptr<GameStationModuleTable>
+                                 m_table;   ///< Table of modules.
+    ::std::shared_ptr<GameWares> m_wares;   ///< Game wares.
+    QMap<QString, quint64>       m_amounts; ///< Amounts of modules in the
+                                            ///< base station.
+    StationSummary               m_summary; ///< Summary of the base station.
+    QVector<Sweep>               m_sweeps;  ///< Sweeps.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	table		Table of modules.
+     * @param[in]	wares		Game wares.
+     * @param[in]	save		Base station.
+     */
+    StationVariants(::std::shared_ptr<GameStationModuleTable> table,
+                    ::std::shared_ptr<GameWares>              wares,
+                    ::std::shared_ptr<Save>                   save);
+
+    /**
+     * @brief		Get amounts of modules in the base station.
+     *
+     * @return		Amounts of modules, indexed by macro.
+     */
+    const QMap<QString, quint64> &amounts() const;
+
+    /**
+     * @brief		Add a sweep.
+     *
+     * @param[in]	sweep		Sweep, sweeps without options are ignored.
+     */
+    void addSweep(const Sweep &sweep);
+
+    /**
+     * @brief		Add a sweep of the amount of a module.
+     *
+     * @param[in]	macro		Macro of the module.
+     * @param[in]	min			Minimum change.
+     * @param[in]	max			Maximum change.
+     */
+    void addAmountSweep(const QString &macro, qint64 min, qint64 max);
+
+    /**
+     * @brief		Add a sweep which replaces all modules of a macro in the
+     *				base station by other modules, such as habitations of
+     *				other races.
+     *
+     * @param[in]	macro			Macro of the module.
+     * @param[in]	alternatives	Macros of modules to replace with.
+     */
+    void addReplaceSweep(const QString &    macro,
+                         const QStringList &alternatives);
+
+    /**
+     * @brief		Clear sweeps.
+     */
+    void clearSweeps();
+
+    /**
+     * @brief		Get number of variants.
+     *
+     * @return		Number of variants, including invalid ones.
+     */
+    quint64 count() const;
+
+    /**
+     * @brief		Evaluate all variants in parallel and keep the best ones.
+     *
+     * @param[in]	rankBy		Key to rank variants.
+     * @param[in]	limit		Maximum number of variants kept.
+     * @param[in]	cancelled	Checked by worker threads between batches,
+     *							returns \c true to stop.
+     *
+     * @return		Variants, the best one comes first, empty if cancelled.
+     *				Variants with negative amounts of modules are dropped.
+     */
+    QVector<Variant> evaluate(RankBy                         rankBy,
+                              int                            limit,
+                              const ::std::function<bool()> &cancelled) const;
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~StationVariants();
+
+  private:
+    /**
+     * @brief		Evaluate a variant.
+     *
+     * @param[in]	index		Index of the variant.
+     * @param[in]	prices		Average prices of wares.
+     * @param[out]	variant		Variant.
+     *
+     * @return		\c false if the variant is invalid.
+     */
+    bool evaluate(quint64                       index,
+                  const QMap<QString, quint32> &prices,
+                  Variant &                     variant) const;
+};
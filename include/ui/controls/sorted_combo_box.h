@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QPair>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtWidgets/QComboBox>
+
+/**
+ * @brief	Combo box which keeps its items sorted by text with the collator of
+ *			current language.
+ */
+class SortedComboBox : public QComboBox {
+    Q_OBJECT
+  public:
+    typedef QPair<QString, QVariant> Item; ///< Text and data of an item.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	parent		Parent object.
+     */
+    SortedComboBox(QWidget *parent = nullptr);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~SortedComboBox();
+
+    /**
+     * @brief		Replace all items. The items are sorted and inserted at
+     *				once, the current item is kept if its data is still
+     *				present.
+     *
+     * @param[in]	items		Items.
+     */
+    void setItems(const QVector<Item> &items);
+
+    /**
+     * @brief		Change texts of all items and sort again.
+     *
+     * @param[in]	text		Function to get text from the data of an
+     *							item.
+     */
+    void setItemTexts(const ::std::function<QString(const QVariant &)> &text);
+
+    /**
+     * @brief		Sort items by text.
+     */
+    void sortItems();
+};
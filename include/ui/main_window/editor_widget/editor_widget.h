@@ -3,12 +3,14 @@
 #include <memory>
 
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtGui/QCloseEvent>
 #include <QtWidgets/QMdiSubWindow>
 #include <QtWidgets/QVBoxLayout>
 
 #include <common/generic_string.h>
 #include <save/save.h>
+#include <summary/station_summary.h>
 #include <ui/main_window/editor_widget/group_item.h>
 #include <ui/main_window/editor_widget/module_item.h>
 #include <ui/main_window/editor_widget/wares_item.h>
@@ -46,51 +48,7 @@ class EditorWidget : public QWidget {
         ModuleItemWidget *moduleWidget; ///< Widget.
     };
 
-    /**
-     * @brief   Summary information.
-     */
-    struct SummaryInfo {
-        quint64 hull            = 0; ///< Hull.
-        quint64 explosionDamage = 0; ///< Explosion damage.
-        struct {
-            quint64 sLaunchTube = 0; ///< S launch tube..
-            quint64 mLaunchTube = 0; ///< M launch tube.
-            quint64 mTurret     = 0; ///< M turret.
-            quint64 lTurret     = 0; ///< L turret.
-        } weapons;                   ///< Weapons.
-        struct {
-            quint64 mShield = 0; ///< M shield.
-            quint64 lShield = 0; ///< L shield.
-        } shields;               ///< Shields
-        struct {
-            quint64 container = 0; ///< Container.
-            quint64 solid     = 0; ///< Solid.
-            quint64 liquid    = 0; ///< Liquid.
-        } storage;                 ///< Storage.
-        struct {
-            quint64 sDock   = 0; ///< S dock.
-            quint64 mDock   = 0; ///< M dock.
-            quint64 lDock   = 0; ///< L dock.
-            quint64 xlDock  = 0; ///< XL dock.
-            quint64 lXLDock = 0; ///< L/XL dock.
-        } dockingBay;            ///< Docking bay.
-        struct {
-            quint64 sShipCargo = 0;                      ///< S ship cargo.
-            quint64 mShipCargo = 0;                      ///< M ship cargo.
-        } shipStorage;                                   ///< Ship storage.
-        quint64 workforce        = 0;                    ///< Workforce.
-        qint64  surplusWorkforce = 0;                    ///< Surplus workforce.
-        QMap<QString, Range<long double>> resources;     ///< Resources.
-        QMap<QString, Range<long double>> intermediates; ///< Intermediates.
-        QMap<QString, Range<long double>> products;      ///< Products.
-
-        struct {
-            bool requireContainerStorage
-                = false;                       ///< Require container storage.
-            bool requireSolidStorage  = false; ///< Require solid storage.
-            bool requireLiquidStorage = false; ///< Require liquid storage.
-        } requirements;                        ///< Requirements.
-    };
+    typedef StationSummary::Info SummaryInfo; ///< Summary information.
 
   private:
     StationModulesWidget *m_stationModulesWidget; ///< Station modules widget.
@@ -105,12 +63,31 @@ class EditorWidget : public QWidget {
     QVBoxLayout *m_layout; ///< Layout.
 
     QVector<WarningWidget *> m_widgetsWarningInfos; ///< Warning informations.
+    QStringList              m_warnings;            ///< IDs of warnings.
     QTreeWidget *            m_treeEditor;          ///< Editor.
 
     // Operation stack.
     QVector<::std::shared_ptr<Operation>> m_undoStack; ///< Undo stack.
     QVector<::std::shared_ptr<Operation>> m_redoStack; ///< Redo stack.
 
+    // Summary requests, guarded by m_summaryRequestLock.
+    QMutex  m_summaryRequestLock;    ///< Lock of summary requests.
+    bool    m_summaryResetRequested; ///< Rebuild of summary requested.
+    quint64 m_summaryRequestSerial;  ///< Serial of the newest request.
+    ::std::shared_ptr<GameStationModuleTable>
+        m_summaryRequestTable; ///< Table of modules to rebuild summary.
+    QVector<QPair<QString, quint64>>
+        m_summaryRequestModules; ///< Modules in the save to rebuild summary.
+    QMap<QString, qint64>
+        m_summaryRequestChanges; ///< Changes of amounts requested.
+
+    // Summary sums, only accessed by summary task.
+    StationSummary m_stationSummary; ///< Sums of modules in the station.
+
+    // Summary shown.
+    SummaryInfo m_summary;          ///< Summary shown.
+    bool        m_summaryForceShow; ///< Show all items of next summary.
+
     // Items
     QTreeWidgetItem *m_itemGroups; ///< Station module groups.
 
@@ -189,6 +166,13 @@ class EditorWidget : public QWidget {
     virtual ~EditorWidget();
 
   public:
+    /**
+     * @brief	Get path of the save file.
+     *
+     * @return	Path of the save file, empty if not saved yet.
+     */
+    QString path() const;
+
     /**
      * @brief	Close save file.
      *
@@ -224,6 +208,24 @@ class EditorWidget : public QWidget {
      */
     void filterByResource(QString ware);
 
+    /**
+     * @brief       Emit when net rates of wares of the station changed.
+     *
+     * @param[in]   editor      Editor widget.
+     * @param[in]   wares       Net rates of wares each hour, products are
+     *                          positive and resources are negative.
+     */
+    void waresChanged(EditorWidget *editor, QMap<QString, Range<Rate>> wares);
+
+    /**
+     * @brief       Emit when the station is saved to another file.
+     *
+     * @param[in]   editor      Editor widget.
+     * @param[in]   oldPath     Old path, empty if not saved before.
+     * @param[in]   newPath     New path.
+     */
+    void pathChanged(EditorWidget *editor, QString oldPath, QString newPath);
+
   private slots:
     /**
      * @brief		Do operation.
@@ -286,30 +288,51 @@ class EditorWidget : public QWidget {
     void updateSummary();
 
     /**
-     * @brief       Disable suggested amounts.
+     * @brief       Update summary after an operation is done or undone,
+     *              only the changes made by the operation is applied if
+     *              possible.
+     *
+     * @param[in]   operation   Operation.
+     * @param[in]   undo        \c true if the operation is undone.
      */
-    void disableSuggestedAmounts();
+    void updateSummary(::std::shared_ptr<Operation> operation, bool undo);
 
     /**
-     * @brief       Update suggested amounts.
+     * @brief       Compute summary of requests, called in summary task.
+     */
+    void computeSummary();
+
+    /**
+     * @brief       Show summary computed by summary task.
      *
-     * @param[out]  summary     Summary.
+     * @param[in]   summary     Summary.
+     * @param[in]   serial      Serial of the newest request computed.
+     * @param[in]   reset       Summary has been rebuilt.
      */
-    void updateSuggestedAmounts(SummaryInfo &summary);
+    void publishSummary(const SummaryInfo &summary,
+                        quint64            serial,
+                        bool               reset);
 
     /**
-     * @brief       Make summary.
+     * @brief       Disable suggested amounts.
+     */
+    void disableSuggestedAmounts();
+
+    /**
+     * @brief       Update suggested amounts.
      *
-     * @param[out]  summary     Summary.
+     * @param[in]   summary     Summary.
      */
-    void makeSummary(SummaryInfo &summary);
+    void updateSuggestedAmounts(const SummaryInfo &summary);
 
     /**
-     * @brief       Show summary.
+     * @brief       Show summary, only items changed since last summary
+     *              shown are updated.
      *
      * @param[in]   summary     Summary.
+     * @param[in]   force       Update all items.
      */
-    void showSummary(const SummaryInfo &summary);
+    void showSummary(const SummaryInfo &summary, bool force);
 
     /**
      * @brief       Check summary.
@@ -398,6 +421,11 @@ class EditorWidget : public QWidget {
      */
     void exportAsHTML();
 
+    /**
+     * @brief		Compare variants of the station.
+     */
+    void whatIf();
+
     /**
      * @brief		Change language.
      */
@@ -110,10 +110,10 @@ class ModuleItemWidget : public QWidget {
     /**
      * @brief       Set suggested amount to change.
      *
-     * @param[in]   productPerHourToChange      Suggested value to change of the
-     *                                          amount of product each hour.
+     * @param[in]   amountToChange      Suggested value to change of the
+     *                                  amount of module.
      */
-    void setSuggestedAmountToChange(qint64 productPerHourToChange);
+    void setSuggestedAmountToChange(int amountToChange);
 
   private slots:
     /**
@@ -178,15 +178,4 @@ class ModuleItemWidget : public QWidget {
      * @param[in]   item            Item.
      */
     void changeAmount(quint64 oldAmount, quint64 newAmount, ModuleItem *item);
-
-  private:
-    /**
-     * @brief       Compute suggested amount to change.
-     *
-     * @param[in]   productPerHourToChange      Suggested value to change of the
-     *                                          amount of product each hour.
-     *
-     * @return      Suggested amount.
-     */
-    int suggestedAmountToChange(qint64 productPerHourToChange);
 };
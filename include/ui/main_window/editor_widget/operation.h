@@ -43,6 +43,20 @@ class EditorWidget::Operation {
      */
     virtual void undoOperation() = 0;
 
+    /**
+     * @brief		Get changes of module amounts made by the operation.
+     *
+     * @param[out]	changes		Changes of amounts, indexed by macro of
+     *							modules.
+     *
+     * @return		\c true if all changes are reported, \c false if the
+     *				summary should be rebuilt.
+     */
+    virtual bool amountChanges(QMap<QString, qint64> &) const
+    {
+        return false;
+    }
+
     /**
      * @brief	Destructor.
      */
@@ -60,6 +60,16 @@ class EditorWidget::ChangeModuleAmountOperation :
      */
     virtual void undoOperation() override;
 
+    /**
+     * @brief		Get changes of module amounts made by the operation.
+     *
+     * @param[out]	changes		Changes of amounts, indexed by macro of
+     *							modules.
+     *
+     * @return		\c true.
+     */
+    virtual bool amountChanges(QMap<QString, qint64> &changes) const override;
+
     /**
      * @brief	Destructor.
      */
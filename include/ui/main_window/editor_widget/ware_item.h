@@ -31,6 +31,13 @@ class WareItem : public QTreeWidgetItem {
      */
     const QString &ware() const;
 
+    /**
+     * @brief       Get range.
+     *
+     * @return      Range of the amount each hour.
+     */
+    const Range<qint64> &range() const;
+
     /**
      * @brief       Set range.
      *
@@ -54,7 +54,17 @@ class WaresItem : public QTreeWidgetItem {
      *
      * @param[in]   wares       Macros and ranges of the wares.
      */
-    void update(const QMap<QString, Range<long double>> &wares);
+    void update(const QMap<QString, Range<Rate>> &wares);
+
+    /**
+     * @brief       Check if the item is showing the wares.
+     *
+     * @param[in]   wares       Macros and ranges of the wares.
+     *
+     * @return      \c true if update() with the wares changes nothing,
+     *              otherwise returns \c false.
+     */
+    bool isShowing(const QMap<QString, Range<Rate>> &wares) const;
 
     /**
      * @brief		Change language.
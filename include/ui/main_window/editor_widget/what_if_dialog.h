@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QGridLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+
+#include <common/multi_threading.h>
+#include <save/save.h>
+#include <summary/station_variants.h>
+
+/**
+ * @brief	What-if dialog. Compares variants of a station with changed
+ *			amounts of modules or habitations of other races.
+ */
+class WhatIfDialog : public QDialog {
+    Q_OBJECT
+  private:
+    QGridLayout *m_layout;      ///< Layout.
+    QTreeWidget *m_treeModules; ///< Modules to sweep.
+    QLabel *     m_lblRange;    ///< Label "Range".
+    QSpinBox *   m_spinRange;   ///< Range of changes.
+    QCheckBox *  m_chkRaces;    ///< Try habitations of other races.
+    QLabel *     m_lblRankBy;   ///< Label "Rank By".
+    QComboBox *  m_comboRankBy; ///< Key to rank variants.
+    QLabel *     m_lblCount;    ///< Number of variants.
+    QPushButton *m_btnEvaluate; ///< Button "Evaluate".
+    QTreeWidget *m_treeResults; ///< Ranked variants.
+
+    ::std::shared_ptr<StationVariants> m_variants; ///< Variants.
+
+    BackgroundTask *       m_evaluateTask;   ///< Evaluating task.
+    ::std::atomic<quint64> m_evaluateSerial; ///< Newest evaluation.
+    bool                   m_evaluating;     ///< Evaluating.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	save		Base station.
+     * @param[in]	parent		Parent widget.
+     */
+    WhatIfDialog(::std::shared_ptr<Save> save, QWidget *parent = nullptr);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~WhatIfDialog();
+
+  private:
+    /**
+     * @brief		Make sweeps from the options.
+     */
+    void updateSweeps();
+
+    /**
+     * @brief		Get name of a module.
+     *
+     * @param[in]	macro		Macro of the module.
+     *
+     * @return		Name of the module.
+     */
+    static QString moduleName(const QString &macro);
+
+    /**
+     * @brief		Enable or disable options while evaluating.
+     *
+     * @param[in]	evaluating	\c true if evaluating.
+     */
+    void setEvaluating(bool evaluating);
+
+    /**
+     * @brief		Show evaluated variants.
+     *
+     * @param[in]	variants	Variants, the best one comes first.
+     * @param[in]	serial		Serial of the evaluation.
+     */
+    void onVariantsEvaluated(const QVector<StationVariants::Variant> &variants,
+                             quint64                                  serial);
+
+  private slots:
+    /**
+     * @brief		Change language.
+     */
+    void onLanguageChanged();
+
+    /**
+     * @brief		On button "Evaluate" clicked, cancels the evaluation if
+     *				evaluating.
+     */
+    void onBtnEvaluateClicked();
+};
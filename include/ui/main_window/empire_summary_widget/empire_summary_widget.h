@@ -0,0 +1,180 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtWidgets/QGridLayout>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QTreeWidget>
+
+#include <common/rate.h>
+#include <common/types.h>
+#include <save/save.h>
+#include <ui/main_window/action_control_dock_widget.h>
+
+class EditorWidget;
+
+/**
+ * @brief	Aggregate summary of all open stations and stations in a folder.
+ */
+class EmpireSummaryWidget : public ActionControlDockWidget {
+    Q_OBJECT
+
+  private:
+    /**
+     * @brief	Station in the summary.
+     */
+    struct Station {
+        QString name; ///< Name.
+        QMap<QString, Range<Rate>> wares; ///< Net rates of wares each hour.
+    };
+
+    /**
+     * @brief	Sum of a ware from all stations.
+     */
+    struct WareTotal {
+        Range<Rate> supply; ///< Supply each hour.
+        Range<Rate> demand; ///< Demand each hour.
+        QMap<QString, Range<Rate>>
+            stations; ///< Net rates of stations, indexed by key of station.
+    };
+
+  protected:
+    QWidget *    m_widget;          ///< Widget.
+    QGridLayout *m_layout;          ///< Layout.
+    QPushButton *m_btnAddFolder;    ///< Button "Add Folder".
+    QPushButton *m_btnClearFolders; ///< Button "Clear Folders".
+    QTreeWidget *m_treeSummary;     ///< Summary tree widget.
+
+    QMap<QString, Station>           m_stations;  ///< Stations.
+    QMap<QString, WareTotal>         m_totals;    ///< Totals of wares.
+    QMap<QString, QTreeWidgetItem *> m_wareItems; ///< Items of wares.
+    QStringList                      m_folders;   ///< Folders of saves.
+    QMap<QString, QString>
+        m_editorPaths; ///< Paths of saves in editors, indexed by key of
+                       ///< station.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	statusAction	Action to control the visibility of the
+     *								widget.
+     * @param[in]	parent			Parent object.
+     * @param[in]	flags			Window flags.
+     */
+    EmpireSummaryWidget(QAction *       statusAction,
+                        QWidget *       parent = nullptr,
+                        Qt::WindowFlags flags  = Qt::WindowFlags());
+
+    /**
+     * @brief		Add an editor, the summary follows the changes of the
+     *				station until the editor is destroyed.
+     *
+     * @param[in]	editor		Editor widget.
+     */
+    void addEditor(EditorWidget *editor);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~EmpireSummaryWidget();
+
+  public slots:
+    /**
+     * @brief		Change language.
+     */
+    void onLanguageChanged();
+
+  private:
+    /**
+     * @brief		Get key of an editor.
+     *
+     * @param[in]	editor		Editor widget.
+     *
+     * @return		Key of the station.
+     */
+    static QString editorKey(const QObject *editor);
+
+    /**
+     * @brief		Compute net rates of wares of a save.
+     *
+     * @param[in]	save		Save.
+     *
+     * @return		Net rates of wares each hour.
+     */
+    static QMap<QString, Range<Rate>>
+        computeWares(::std::shared_ptr<Save> save);
+
+    /**
+     * @brief		Set net rates of a station, only the wares changed are
+     *				updated.
+     *
+     * @param[in]	key			Key of the station.
+     * @param[in]	name		Name of the station.
+     * @param[in]	wares		Net rates of wares each hour.
+     */
+    void setStation(const QString &                   key,
+                    const QString &                   name,
+                    const QMap<QString, Range<Rate>> &wares);
+
+    /**
+     * @brief		Remove a station.
+     *
+     * @param[in]	key			Key of the station.
+     */
+    void removeStation(const QString &key);
+
+    /**
+     * @brief		Rename a station.
+     *
+     * @param[in]	key			Key of the station.
+     * @param[in]	name		Name of the station.
+     */
+    void renameStation(const QString &key, const QString &name);
+
+    /**
+     * @brief		Load saves in folders.
+     */
+    void loadFolders();
+
+    /**
+     * @brief		Check if a save is in the folders.
+     *
+     * @param[in]	path		Path of the save.
+     *
+     * @return		\c true if the save is in one of the folders.
+     */
+    bool inFolders(const QString &path) const;
+
+    /**
+     * @brief		Update items of wares.
+     *
+     * @param[in]	wares		Wares to update.
+     */
+    void updateWareItems(const QSet<QString> &wares);
+
+    /**
+     * @brief		Update item of a ware.
+     *
+     * @param[in]	ware		Ware.
+     */
+    void updateWareItem(const QString &ware);
+
+  private slots:
+    /**
+     * @brief		On button "Add Folder" clicked.
+     */
+    void onBtnAddFolderClicked();
+
+    /**
+     * @brief		On button "Clear Folders" clicked.
+     */
+    void onBtnClearFoldersClicked();
+
+    /**
+     * @brief		Reload game data.
+     */
+    void onDataReloaded();
+};
@@ -4,6 +4,7 @@
 #include <QtWidgets/QMainWindow>
 #include <QMdiSubWindow>
 
+#include <ui/main_window/empire_summary_widget/empire_summary_widget.h>
 #include <ui/main_window/info_widget/info_widget.h>
 #include <ui/main_window/station_modules_widget/station_modules_widget.h>
 #include <update_checker.h>
@@ -40,6 +41,7 @@ class MainWindow : public QMainWindow {
         QAction *actionEditCopy;     ///< Menu "Edit->Copy".
         QAction *actionEditPaste;    ///< Menu "Edit->Paste".
         QAction *actionEditRemove;   ///< Menu "Edit->Remove".
+        QAction *actionEditWhatIf;   ///< Menu "Edit->What-If Analysis".
     };
 
   private:
@@ -65,6 +67,7 @@ class MainWindow : public QMainWindow {
     QMenu *  m_menuView;                 ///< Menu "View".
     QAction *m_actionViewStationModules; ///< Menu "View->Station Modules".
     QAction *m_actionViewInfo;           ///< Menu "View->Info".
+    QAction *m_actionViewEmpireSummary;  ///< Menu "View->Empire Summary".
 
     // Help menu
     QMenu *  m_menuHelp;        ///< Menu "Help".
@@ -79,6 +82,9 @@ class MainWindow : public QMainWindow {
     // Info widget.
     InfoWidget *m_infoWidget; ///< Information widget.
 
+    // Empire summary widget.
+    EmpireSummaryWidget *m_empireSummaryWidget; ///< Empire summary widget.
+
     // Central widget
     QMdiArea *m_centralWidget; ///< Central widget.
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QtCore/QBitArray>
+#include <QtCore/QCollator>
+#include <QtCore/QCollatorSortKey>
+#include <QtCore/QSortFilterProxyModel>
+#include <QtCore/QVector>
+
+#include <ui/main_window/station_modules_widget/station_modules_model.h>
+
+/**
+ * @brief	Sorts modules of StationModulesModel by rank and name, and hides
+ *			modules not in a bitset of module IDs. Groups keep their order and
+ *			are always shown.
+ */
+class StationModulesFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+  private:
+    QBitArray    m_visibleModules; ///< Visible modules, indexed by module ID,
+                                   ///< empty to show all modules.
+    QVector<int> m_ranks;          ///< Ranks of modules, indexed by module ID,
+                                   ///< empty to sort by name only.
+    QCollator    m_collator;       ///< Collator to compare names.
+    mutable QVector<QCollatorSortKey>
+        m_sortKeys; ///< Sort keys of names, indexed by module ID, built
+                    ///< when sorting.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	parent		Parent object.
+     */
+    StationModulesFilterModel(QObject *parent = nullptr);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~StationModulesFilterModel();
+
+    /**
+     * @brief		Set visible modules.
+     *
+     * @param[in]	visibleModules	Visible modules, indexed by module ID.
+     * @param[in]	ranks			Ranks of modules, indexed by module ID.
+     *								Modules are sorted by rank, then by name.
+     */
+    void setVisibleModules(const QBitArray &   visibleModules,
+                           const QVector<int> &ranks = {});
+
+    /**
+     * @brief		Set collator and sort again.
+     *
+     * @param[in]	collator		Collator to compare names.
+     */
+    void setCollator(const QCollator &collator);
+
+    /**
+     * @brief		Set source model.
+     *
+     * @param[in]	sourceModel		Source model, must be a
+     *								StationModulesModel.
+     */
+    virtual void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+  protected:
+    /**
+     * @brief		Check if a row is shown.
+     *
+     * @param[in]	sourceRow		Row in the source model.
+     * @param[in]	sourceParent	Parent in the source model.
+     *
+     * @return		\c true if shown.
+     */
+    virtual bool
+        filterAcceptsRow(int                sourceRow,
+                         const QModelIndex &sourceParent) const override;
+
+    /**
+     * @brief		Compare rows.
+     *
+     * @param[in]	left		Left index in the source model.
+     * @param[in]	right		Right index in the source model.
+     *
+     * @return		\c true if \c left is less than \c right.
+     */
+    virtual bool lessThan(const QModelIndex &left,
+                          const QModelIndex &right) const override;
+
+  private:
+    /**
+     * @brief		Build sort keys of names of listed modules, each name is
+     *				resolved and transformed once.
+     */
+    void buildSortKeys() const;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QVector>
+
+#include <game_data/game_station_module_table.h>
+
+/**
+ * @brief	Model of station modules grouped by module class. Rows refer to the
+ *			dense IDs of GameStationModuleTable, names are resolved when a view
+ *			asks for them.
+ */
+class StationModulesModel : public QAbstractItemModel {
+    Q_OBJECT
+  public:
+    /**
+     * @brief	Groups of modules, in display order.
+     */
+    enum Group {
+        Build,      ///< Build modules.
+        Dock,       ///< Dock modules.
+        Production, ///< Production modules.
+        Storage,    ///< Storage modules.
+        Habitation, ///< Habitation modules.
+        Defence,    ///< Defence modules.
+        Connect,    ///< Connect modules.
+        Welfare,    ///< Welfare modules.
+        Radar,      ///< Radar modules.
+        Processing, ///< Processing modules.
+        GroupCount  ///< Number of groups.
+    };
+
+  private:
+    ::std::shared_ptr<GameStationModuleTable> m_table; ///< Station modules.
+    QVector<quint32>         m_groups[GroupCount]; ///< Module IDs of groups.
+    QVector<bool>            m_listed; ///< Whether each module is listed.
+    mutable QVector<QString> m_names;  ///< Names of modules, null if not
+                                       ///< resolved yet.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	parent		Parent object.
+     */
+    StationModulesModel(QObject *parent = nullptr);
+
+    /**
+     * @brief		Destructor.
+     */
+    virtual ~StationModulesModel();
+
+    /**
+     * @brief		Reload station modules from game data.
+     */
+    void reload();
+
+    /**
+     * @brief		Get station modules.
+     *
+     * @return		Station modules.
+     */
+    const ::std::shared_ptr<GameStationModuleTable> &table() const;
+
+    /**
+     * @brief		Check if a module is listed.
+     *
+     * @param[in]	id			ID of the module.
+     *
+     * @return		\c true if listed.
+     */
+    bool listed(quint32 id) const;
+
+    /**
+     * @brief		Get ID of the module of an index.
+     *
+     * @param[in]	index		Index.
+     *
+     * @return		ID of the module, or -1 if the index is a group.
+     */
+    qint64 moduleID(const QModelIndex &index) const;
+
+    /**
+     * @brief		Get name of a module, resolved on first use.
+     *
+     * @param[in]	id			ID of the module.
+     *
+     * @return		Name of the module.
+     */
+    const QString &name(quint32 id) const;
+
+    /**
+     * @brief		Change language.
+     */
+    void onLanguageChanged();
+
+    /**
+     * @brief		Get index.
+     *
+     * @param[in]	row			Row.
+     * @param[in]	column		Column.
+     * @param[in]	parent		Parent index.
+     *
+     * @return		Index.
+     */
+    virtual QModelIndex
+        index(int                row,
+              int                column,
+              const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief		Get parent index.
+     *
+     * @param[in]	index		Index.
+     *
+     * @return		Parent index.
+     */
+    virtual QModelIndex parent(const QModelIndex &index) const override;
+
+    /**
+     * @brief		Get number of rows.
+     *
+     * @param[in]	parent		Parent index.
+     *
+     * @return		Number of rows.
+     */
+    virtual int
+        rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief		Get number of columns.
+     *
+     * @param[in]	parent		Parent index.
+     *
+     * @return		Number of columns.
+     */
+    virtual int
+        columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief		Get data.
+     *
+     * @param[in]	index		Index.
+     * @param[in]	role		Role.
+     *
+     * @return		Data.
+     */
+    virtual QVariant data(const QModelIndex &index,
+                          int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief		Get item flags.
+     *
+     * @param[in]	index		Index.
+     *
+     * @return		Flags.
+     */
+    virtual Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+  private:
+    /**
+     * @brief		Get group of a module.
+     *
+     * @param[in]	module		Module.
+     *
+     * @return		Group, or -1 if the module is not listed.
+     */
+    static int group(const GameStationModules::StationModule &module);
+};
@@ -1,13 +1,20 @@
 #pragma once
+#include <atomic>
+#include <memory>
+
+#include <QBitArray>
 #include <QPushButton>
 #include <QCheckBox>
-#include <QComboBox>
 #include <QGridLayout>
-#include <QTreeWidgetItem>
+#include <QTreeView>
 #include <QVBoxLayout>
 
+#include <common/fuzzy_index.h>
+#include <common/multi_threading.h>
+#include <ui/controls/sorted_combo_box.h>
 #include <ui/main_window/action_control_dock_widget.h>
-#include <ui/main_window/station_modules_widget/station_modules_tree_widget_item.h>
+#include <ui/main_window/station_modules_widget/station_modules_filter_model.h>
+#include <ui/main_window/station_modules_widget/station_modules_model.h>
 
 /**
  * @brief	Station module.
@@ -28,35 +35,44 @@ class StationModulesWidget : public ActionControlDockWidget {
     QWidget *    m_widgetFilters; ///< Filters widget.
     QGridLayout *m_layoutFilters; ///< Filters layout.
 
-    QCheckBox *m_chkByRace;    ///< By race checkbox.
-    QComboBox *m_comboByRaces; ///< Combobox to select race.
+    QCheckBox *     m_chkByRace;    ///< By race checkbox.
+    SortedComboBox *m_comboByRaces; ///< Combobox to select race.
 
-    QCheckBox *m_chkByProduction;   ///< By production checkbox.
-    QComboBox *m_comboByProduction; ///< Combobox to select production.
+    QCheckBox *     m_chkByProduction;   ///< By production checkbox.
+    SortedComboBox *m_comboByProduction; ///< Combobox to select production.
 
-    QCheckBox *m_chkByResource;   ///< By resource checkbox.
-    QComboBox *m_comboByResource; ///< Combobox to select resource.
+    QCheckBox *     m_chkByResource;   ///< By resource checkbox.
+    SortedComboBox *m_comboByResource; ///< Combobox to select resource.
 
     QCheckBox *m_chkByKeyword; ///< By production checkbox.
     QLineEdit *m_txtKeyword;   ///< Text box to input keyword.
 
     // Station modules.
-    QTreeWidget *m_treeStationModules; ///< Tree view to select station module.
-    QTreeWidgetItem *m_itemBuild;      ///< Build modules root item.
-    QTreeWidgetItem *m_itemDock;       ///< Dock modules root item.
-    QTreeWidgetItem *m_itemProduction; ///< Production modules root item.
-    QTreeWidgetItem *m_itemStorage;    ///< Storage modules root item.
-    QTreeWidgetItem *m_itemHabitation; ///< Habitation modules root item.
-    QTreeWidgetItem *m_itemDefence;    ///< Defence modules root item.
-    QTreeWidgetItem *m_itemConnect;    ///< Connect modules root item.
-    QTreeWidgetItem *m_itemWelfare;    ///< Welfare modules root item.
-    QTreeWidgetItem *m_itemRadar;      ///< Radar modules root item.
-    QTreeWidgetItem *m_itemProcessing; ///< Processing modules root item.
-
-    QVector<StationModulesTreeWidgetItem *> m_moduleItems; ///< Module items.
-    QSet<QString>                           m_races;       ///< Races.
-    QSet<QString>                           m_products;    ///< Products.
-    QSet<QString>                           m_resources;   ///< Resources.
+    QTreeView *                m_treeStationModules; ///< Modules view.
+    StationModulesModel *      m_modulesModel;       ///< Modules model.
+    StationModulesFilterModel *m_modulesFilter;      ///< Filtered modules.
+
+    QSet<QString> m_races;     ///< Races.
+    QSet<QString> m_products;  ///< Products.
+    QSet<QString> m_resources; ///< Resources.
+
+    // Filter indices, bit i refers to the module with ID i.
+    QBitArray                m_productionModules; ///< Production modules.
+    QMap<QString, QBitArray> m_raceModules;       ///< Modules of each race.
+    QMap<QString, QBitArray> m_productModules;    ///< Producers of each ware.
+    QMap<QString, QBitArray> m_resourceModules;   ///< Consumers of each ware.
+
+    // Keyword search.
+    BackgroundTask *              m_searchTask;     ///< Searching task.
+    ::std::shared_ptr<FuzzyIndex> m_searchIndex;    ///< Search index.
+    ::std::atomic<quint64>        m_searchSerial;   ///< Newest search.
+    QString                       m_searchQuery;    ///< Query of the newest
+                                                    ///< search, null if not
+                                                    ///< searching.
+    QBitArray                     m_keywordModules; ///< Modules found by the
+                                                    ///< latest search finished.
+    QVector<int>                  m_keywordRanks;   ///< Ranks of the modules
+                                                    ///< found.
 
   public:
     /**
@@ -121,9 +137,27 @@ class StationModulesWidget : public ActionControlDockWidget {
     void loadStationModules();
 
     /**
-     * @brief	Sort combobox.
+     * @brief	Build index of names of modules, macros of modules and names of
+     *			wares for keyword search.
+     */
+    void buildSearchIndex();
+
+    /**
+     * @brief		Search modules in background, the latest search cancels
+     *				the others.
+     *
+     * @param[in]	query		Keyword.
+     */
+    void searchModules(const QString &query);
+
+    /**
+     * @brief		Apply results of a search.
+     *
+     * @param[in]	matches		Modules found.
+     * @param[in]	serial		Serial of the search.
      */
-    void sortComboBox(QComboBox *combo);
+    void onModulesSearched(const QVector<FuzzyIndex::Match> &matches,
+                           quint64                          serial);
 
   private slots:
 
@@ -178,7 +212,12 @@ class StationModulesWidget : public ActionControlDockWidget {
     /**
      * @brief		On item clicked.
      *
-     * @param[in]	item		Item clicked.
+     * @param[in]	index		Index of the item clicked.
+     */
+    void onItemClicked(const QModelIndex &index);
+
+    /**
+     * @brief		Reload station modules after game data reloaded.
      */
-    void onItemClicked(QTreeWidgetItem *item);
+    void onGameDataReloaded();
 };
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <game_data/game_data_loading_sink.h>
+
+class SplashWidget;
+
+/**
+ * @brief	Loading sink which shows progress in splash widget and errors in
+ *			message boxes.
+ */
+class SplashLoadingSink : public IGameDataLoadingSink {
+  private:
+    SplashWidget *m_splash; ///< Splash widget.
+
+  public:
+    /**
+     * @brief		Constructor.
+     *
+     * @param[in]	splash		Splash widget.
+     */
+    SplashLoadingSink(SplashWidget *splash);
+
+    /**
+     * @brief		Show progress.
+     *
+     * @param[in]	text		Progress text.
+     */
+    virtual void setText(const QString &text) override;
+
+    /**
+     * @brief		Show error.
+     *
+     * @param[in]	message		Error message.
+     */
+    virtual void showError(const QString &message) override;
+
+    /**
+     * @brief		Ask for path of game.
+     *
+     * @param[in]	current		Current path of game.
+     * @param[out]	path		Path selected.
+     *
+     * @return		\c true if a path is selected, \c false if loading
+     *				should be aborted.
+     */
+    virtual bool askGamePath(const QString &current, QString &path) override;
+
+    /**
+     * @brief	Destructor.
+     */
+    virtual ~SplashLoadingSink();
+};
@@ -0,0 +1,269 @@
+#include <algorithm>
+
+#include <common/fuzzy_index.h>
+
+/// Queries with fewer trigrams are scored against all documents.
+#define FUZZY_INDEX_MIN_TRIGRAMS 3
+
+/// Trigrams of the query a typo may break.
+#define FUZZY_INDEX_TYPO_TRIGRAMS 3
+
+/// Documents scored between two checks of cancellation.
+#define FUZZY_INDEX_CHECK_INTERVAL 64
+
+/// Base score of texts containing the query.
+#define FUZZY_INDEX_SUBSTRING_SCORE 30000
+
+/// Base score of texts containing the query as a subsequence.
+#define FUZZY_INDEX_SUBSEQUENCE_SCORE 10000
+
+/**
+ * @brief		Constructor.
+ */
+FuzzyIndex::FuzzyIndex(const QVector<QStringList> &documents)
+{
+    // Fields and distinct trigrams of each document.
+    QVector<QVector<quint64>> documentTrigrams;
+    documentTrigrams.reserve(documents.size());
+    m_documents.reserve(documents.size());
+    for (const auto &fields : documents) {
+        QStringList      foldedFields;
+        QVector<quint64> trigrams;
+        for (const auto &field : fields) {
+            foldedFields.append(field.toCaseFolded());
+            trigrams.append(FuzzyIndex::trigrams(foldedFields.back()));
+        }
+        ::std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(::std::unique(trigrams.begin(), trigrams.end()),
+                       trigrams.end());
+        m_documents.append(foldedFields);
+        documentTrigrams.append(trigrams);
+    }
+
+    // Count documents of each trigram.
+    m_postingOffsets.append(0);
+    for (const auto &trigrams : documentTrigrams) {
+        for (quint64 trigram : trigrams) {
+            auto iter = m_trigramIDs.find(trigram);
+            if (iter == m_trigramIDs.end()) {
+                iter = m_trigramIDs.insert(
+                    trigram, static_cast<quint32>(m_postingOffsets.size() - 1));
+                m_postingOffsets.append(0);
+            }
+            ++m_postingOffsets[*iter + 1];
+        }
+    }
+    for (int i = 1; i < m_postingOffsets.size(); ++i) {
+        m_postingOffsets[i] += m_postingOffsets[i - 1];
+    }
+
+    // Fill documents.
+    QVector<quint32> next(m_postingOffsets.begin(),
+                          m_postingOffsets.end() - 1);
+    m_postings.resize(m_postingOffsets.back());
+    for (quint32 id = 0; id < static_cast<quint32>(documentTrigrams.size());
+         ++id) {
+        for (quint64 trigram : documentTrigrams[id]) {
+            m_postings[next[m_trigramIDs[trigram]]++] = id;
+        }
+    }
+}
+
+/**
+ * @brief		Get number of documents.
+ */
+quint32 FuzzyIndex::size() const
+{
+    return static_cast<quint32>(m_documents.size());
+}
+
+/**
+ * @brief		Search documents.
+ */
+QVector<FuzzyIndex::Match>
+    FuzzyIndex::search(const QString &                query,
+                       const ::std::function<bool()> &cancelled) const
+{
+    QString folded = query.toCaseFolded();
+    if (folded.isEmpty()) {
+        return {};
+    }
+    QVector<quint64> queryTrigrams = FuzzyIndex::trigrams(folded);
+
+    // Candidates. A typo breaks a few trigrams of the query, so documents
+    // sharing the other trigrams are candidates. Subsequences share few
+    // trigrams, documents containing the query in order are candidates as
+    // well.
+    QVector<quint32> candidates;
+    if (queryTrigrams.size() < FUZZY_INDEX_MIN_TRIGRAMS) {
+        candidates.reserve(m_documents.size());
+        for (quint32 id = 0; id < this->size(); ++id) {
+            candidates.append(id);
+        }
+    } else {
+        QVector<quint32> hits(m_documents.size(), 0);
+        for (quint64 trigram : queryTrigrams) {
+            auto iter = m_trigramIDs.find(trigram);
+            if (iter == m_trigramIDs.end()) {
+                continue;
+            }
+            for (quint32 i = m_postingOffsets[*iter];
+                 i < m_postingOffsets[*iter + 1]; ++i) {
+                ++hits[m_postings[i]];
+            }
+        }
+
+        quint32 required = static_cast<quint32>(::std::max(
+            1, static_cast<int>(queryTrigrams.size())
+                   - FUZZY_INDEX_TYPO_TRIGRAMS));
+        for (quint32 id = 0; id < this->size(); ++id) {
+            if (id % FUZZY_INDEX_CHECK_INTERVAL == 0 && cancelled()) {
+                return {};
+            }
+            if (hits[id] >= required) {
+                candidates.append(id);
+                continue;
+            }
+            for (const auto &field : m_documents[id]) {
+                if (FuzzyIndex::subsequence(folded, field)) {
+                    candidates.append(id);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Score.
+    QVector<Match> ret;
+    for (int i = 0; i < candidates.size(); ++i) {
+        if (i % FUZZY_INDEX_CHECK_INTERVAL == 0 && cancelled()) {
+            return {};
+        }
+
+        qint32 bestScore = 0;
+        for (const auto &field : m_documents[candidates[i]]) {
+            bestScore = ::std::max(
+                bestScore, FuzzyIndex::score(folded, queryTrigrams, field));
+        }
+        if (bestScore > 0) {
+            ret.append({candidates[i], bestScore});
+        }
+    }
+    ::std::stable_sort(ret.begin(), ret.end(),
+                       [](const Match &match1, const Match &match2) -> bool {
+                           return match1.score > match2.score;
+                       });
+
+    return ret;
+}
+
+/**
+ * @brief		Get trigrams of a text.
+ */
+QVector<quint64> FuzzyIndex::trigrams(const QString &text)
+{
+    QVector<quint64> ret;
+    for (int i = 0; i + 3 <= text.size(); ++i) {
+        ret.append((static_cast<quint64>(text[i].unicode()) << 32)
+                   | (static_cast<quint64>(text[i + 1].unicode()) << 16)
+                   | static_cast<quint64>(text[i + 2].unicode()));
+    }
+    ::std::sort(ret.begin(), ret.end());
+    ret.erase(::std::unique(ret.begin(), ret.end()), ret.end());
+
+    return ret;
+}
+
+/**
+ * @brief		Check if characters of the query are in a text in order.
+ */
+bool FuzzyIndex::subsequence(const QString &query, const QString &text)
+{
+    int next = 0;
+    for (int i = 0; i < text.size() && next < query.size(); ++i) {
+        if (text[i] == query[next]) {
+            ++next;
+        }
+    }
+
+    return next == query.size();
+}
+
+/**
+ * @brief		Score a text.
+ */
+qint32 FuzzyIndex::score(const QString &         query,
+                         const QVector<quint64> &queryTrigrams,
+                         const QString &         text)
+{
+    auto wordStart = [&text](int index) -> bool {
+        return index == 0 || ! text[index - 1].isLetterOrNumber();
+    };
+
+    // Substring, earlier, at the start of a word and in shorter texts is
+    // better.
+    int pos = text.indexOf(query);
+    if (pos >= 0) {
+        qint32 ret
+            = FUZZY_INDEX_SUBSTRING_SCORE - ::std::min(pos, 100) * 10
+              - ::std::min(static_cast<int>(text.size() - query.size()), 1000);
+        if (wordStart(pos)) {
+            ret += 5000;
+        }
+        if (text.size() == query.size()) {
+            ret += 5000;
+        }
+        return ret;
+    }
+
+    // Subsequence, consecutive characters and starts of words are better,
+    // gaps are worse.
+    qint32 bonus = 0;
+    int    last  = -1;
+    int    next  = 0;
+    for (int i = 0; i < text.size() && next < query.size(); ++i) {
+        if (text[i] != query[next]) {
+            continue;
+        }
+        bonus += 10;
+        if (i == last + 1) {
+            bonus += 20;
+        }
+        if (wordStart(i)) {
+            bonus += 30;
+        }
+        if (last >= 0) {
+            bonus -= ::std::min(i - last - 1, 10);
+        }
+        last = i;
+        ++next;
+    }
+    if (next == query.size()) {
+        return FUZZY_INDEX_SUBSEQUENCE_SCORE
+               + ::std::clamp(bonus, 1,
+                              FUZZY_INDEX_SUBSTRING_SCORE
+                                  - FUZZY_INDEX_SUBSEQUENCE_SCORE - 2001);
+    }
+
+    // Typo, most trigrams of the query are in the text.
+    if (queryTrigrams.size() < FUZZY_INDEX_MIN_TRIGRAMS) {
+        return 0;
+    }
+    QVector<quint64> textTrigrams = FuzzyIndex::trigrams(text);
+    int              shared       = 0;
+    auto             iter         = textTrigrams.begin();
+    for (quint64 trigram : queryTrigrams) {
+        iter = ::std::lower_bound(iter, textTrigrams.end(), trigram);
+        if (iter != textTrigrams.end() && *iter == trigram) {
+            ++shared;
+        }
+    }
+    if (shared == 0
+        || shared < queryTrigrams.size() - FUZZY_INDEX_TYPO_TRIGRAMS) {
+        return 0;
+    }
+
+    return 1
+           + (FUZZY_INDEX_SUBSEQUENCE_SCORE - 2) * shared
+                 / static_cast<qint32>(queryTrigrams.size());
+}
@@ -117,7 +117,12 @@ void BackgroundTask::wait()
  */
 BackgroundTask::~BackgroundTask()
 {
-    this->wait();
+    // The finished signal of task threads is delivered by the event loop of
+    // this thread, so wait for the threads directly instead of wait().
+    this->cancle();
+    for (auto thread : this->findChildren<BackgroundTaskThread *>()) {
+        thread->wait();
+    }
 }
 
 /**
@@ -156,6 +161,7 @@ void BackgroundTask::nextTask()
             // Run task
             BackgroundTaskThread *taskThread
                 = new BackgroundTaskThread(::std::move(m_newestTask), this);
+            m_newestTask = nullptr;
             this->connect(taskThread, &BackgroundTaskThread::finished, this,
                           &BackgroundTask::onTaskFinished,
                           Qt::ConnectionType::QueuedConnection);
@@ -3,6 +3,7 @@
 #include <QtCore/QDebug>
 
 #include <common/multi_threading/multi_run.h>
+#include <common/trace.h>
 
 /**
  * @brief		Constructor.
@@ -21,6 +22,7 @@ MultiRunThread::~MultiRunThread() {}
  */
 void MultiRunThread::run()
 {
+    Trace::Scope scope(this->objectName());
     m_task();
 }
 
@@ -31,7 +33,9 @@ MultiRun::MultiRun(::std::function<void()> task)
 {
     size_t threadNum = ::std::thread::hardware_concurrency();
     for (size_t i = 0; i < threadNum + 1; i++) {
-        m_threads.push_back(new MultiRunThread(task, this));
+        MultiRunThread *thread = new MultiRunThread(task, this);
+        thread->setObjectName(QString("MultiRun worker %1").arg(i));
+        m_threads.push_back(thread);
     }
 }
 
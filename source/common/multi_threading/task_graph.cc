@@ -0,0 +1,167 @@
+#include <thread>
+
+#include <QtCore/QDebug>
+
+#include <common/multi_threading/multi_run.h>
+#include <common/multi_threading/task_graph.h>
+#include <common/trace.h>
+
+/**
+ * @brief		Constructor.
+ */
+TaskGraph::TaskGraph() :
+    m_runningCount(0), m_finishedCount(0), m_failedTask(-1)
+{}
+
+/**
+ * @brief		Add task.
+ */
+int TaskGraph::addTask(const QString &     name,
+                       TaskFunc            func,
+                       const QVector<int> &dependencies)
+{
+    int id = m_tasks.size();
+
+    Task task;
+    task.name         = name;
+    task.func         = func;
+    task.dependencies = 0;
+    task.remaining    = 0;
+    m_tasks.push_back(task);
+
+    for (int dependency : dependencies) {
+        Q_ASSERT(dependency >= 0 && dependency < id);
+        m_tasks[dependency].dependents.push_back(id);
+        ++m_tasks[id].dependencies;
+    }
+
+    return id;
+}
+
+/**
+ * @brief		Get number of tasks.
+ */
+int TaskGraph::taskCount() const
+{
+    return m_tasks.size();
+}
+
+/**
+ * @brief		Get name of the task.
+ */
+const QString &TaskGraph::taskName(int id) const
+{
+    return m_tasks[id].name;
+}
+
+/**
+ * @brief		Run all tasks and wait until finished.
+ */
+bool TaskGraph::run(bool signleThread)
+{
+    // Reset status.
+    m_readyTasks.clear();
+    m_runningCount  = 0;
+    m_finishedCount = 0;
+    m_failedTask    = -1;
+    for (int id = 0; id < m_tasks.size(); ++id) {
+        m_tasks[id].remaining = m_tasks[id].dependencies;
+        if (m_tasks[id].remaining == 0) {
+            m_readyTasks.enqueue(id);
+        }
+    }
+
+    // Start threads, no more than the number of tasks.
+    int threadNum = 1;
+    if (! signleThread) {
+        threadNum = static_cast<int>(::std::thread::hardware_concurrency());
+        if (threadNum > m_tasks.size()) {
+            threadNum = m_tasks.size();
+        }
+        if (threadNum < 1) {
+            threadNum = 1;
+        }
+    }
+
+    QVector<MultiRunThread *> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        MultiRunThread *thread
+            = new MultiRunThread(::std::bind(&TaskGraph::work, this), nullptr);
+        thread->setObjectName(QString("TaskGraph worker %1").arg(i));
+        threads.push_back(thread);
+    }
+
+    for (auto &thread : threads) {
+        thread->start();
+    }
+
+    qDebug() << "Task graph started, number of task is" << m_tasks.size()
+             << ", number of thread is " << threads.size() << ".";
+
+    for (auto &thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    return m_failedTask < 0 && m_finishedCount == m_tasks.size();
+}
+
+/**
+ * @brief		Get the task which failed.
+ */
+int TaskGraph::failedTask() const
+{
+    return m_failedTask;
+}
+
+/**
+ * @brief	Destructor.
+ */
+TaskGraph::~TaskGraph() {}
+
+/**
+ * @brief	Worker thread function.
+ */
+void TaskGraph::work()
+{
+    QMutexLocker locker(&m_lock);
+    while (true) {
+        // Wait for a task.
+        while (m_readyTasks.empty() && m_runningCount > 0 && m_failedTask < 0) {
+            m_cond.wait(&m_lock);
+        }
+
+        if (m_failedTask >= 0 || m_readyTasks.empty()) {
+            m_cond.wakeAll();
+            return;
+        }
+
+        int id = m_readyTasks.dequeue();
+        ++m_runningCount;
+
+        // Run task.
+        locker.unlock();
+        bool succeed;
+        {
+            Trace::Scope scope(m_tasks[id].name);
+            succeed = m_tasks[id].func();
+        }
+        locker.relock();
+
+        --m_runningCount;
+        if (succeed) {
+            ++m_finishedCount;
+            for (int dependent : m_tasks[id].dependents) {
+                --m_tasks[dependent].remaining;
+                if (m_tasks[dependent].remaining == 0) {
+                    m_readyTasks.enqueue(dependent);
+                }
+            }
+        } else {
+            qWarning() << "Task" << m_tasks[id].name << "failed.";
+            m_failedTask = id;
+        }
+
+        m_cond.wakeAll();
+    }
+}
@@ -0,0 +1,168 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+
+#include <common/trace.h>
+
+::std::atomic<bool>    Trace::_enabled(false);
+QElapsedTimer          Trace::_timer;
+QMutex                 Trace::_lock;
+QVector<Trace::Event>  Trace::_events;
+QMap<quint64, QString> Trace::_threadNames;
+
+/**
+ * @brief		Constructor.
+ */
+Trace::Scope::Scope(const char *name) : m_enabled(Trace::enabled()), m_begin(0)
+{
+    if (m_enabled) {
+        m_name  = name;
+        m_begin = Trace::now();
+    }
+}
+
+/**
+ * @brief		Constructor.
+ */
+Trace::Scope::Scope(const QString &name) :
+    m_enabled(Trace::enabled()), m_begin(0)
+{
+    if (m_enabled) {
+        m_name  = name;
+        m_begin = Trace::now();
+    }
+}
+
+/**
+ * @brief		Destructor.
+ */
+Trace::Scope::~Scope()
+{
+    if (m_enabled) {
+        Trace::record(m_name, m_begin, Trace::now());
+    }
+}
+
+/**
+ * @brief	Enable trace.
+ */
+void Trace::enable()
+{
+    QMutexLocker locker(&_lock);
+    _timer.start();
+    _enabled = true;
+}
+
+/**
+ * @brief	Disable trace and free recorded events.
+ */
+void Trace::disable()
+{
+    QMutexLocker locker(&_lock);
+    _enabled = false;
+    _events  = QVector<Event>();
+    _threadNames.clear();
+}
+
+/**
+ * @brief		Check if trace is enabled.
+ */
+bool Trace::enabled()
+{
+    return _enabled;
+}
+
+/**
+ * @brief		Write trace.
+ */
+bool Trace::save(const QString &path)
+{
+    QJsonArray traceEvents;
+    {
+        QMutexLocker locker(&_lock);
+
+        // Names of threads.
+        for (auto iter = _threadNames.begin(); iter != _threadNames.end();
+             ++iter) {
+            QJsonObject event;
+            event["name"] = "thread_name";
+            event["ph"]   = "M";
+            event["pid"]  = 1;
+            event["tid"]  = static_cast<qint64>(iter.key());
+            event["args"] = QJsonObject({{"name", iter.value()}});
+            traceEvents.append(event);
+        }
+
+        // Spans.
+        for (auto &e : _events) {
+            QJsonObject event;
+            event["name"] = e.name;
+            event["cat"]  = "startup";
+            event["ph"]   = "X";
+            event["pid"]  = 1;
+            event["tid"]  = static_cast<qint64>(e.threadId);
+            event["ts"]   = e.begin;
+            event["dur"]  = e.duration;
+            traceEvents.append(event);
+        }
+    }
+
+    QSaveFile file(path);
+    if (! file.open(QIODevice::OpenModeFlag::WriteOnly)) {
+        qWarning() << "Failed to open trace file" << path << ".";
+        return false;
+    }
+
+    file.write(QJsonDocument(QJsonObject({{"traceEvents", traceEvents},
+                                          {"displayTimeUnit", "ms"}}))
+                   .toJson(QJsonDocument::JsonFormat::Compact));
+    if (! file.commit()) {
+        qWarning() << "Failed to write trace file" << path << ".";
+        return false;
+    }
+
+    qDebug() << "Trace written to" << path << ".";
+    return true;
+}
+
+/**
+ * @brief		Get current time.
+ */
+qint64 Trace::now()
+{
+    return _timer.nsecsElapsed() / 1000;
+}
+
+/**
+ * @brief		Record an event.
+ */
+void Trace::record(const QString &name, qint64 begin, qint64 end)
+{
+    QThread *thread   = QThread::currentThread();
+    quint64  threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    // Scopes begun before trace disabled are dropped.
+    QMutexLocker locker(&_lock);
+    if (! _enabled) {
+        return;
+    }
+    if (_threadNames.find(threadId) == _threadNames.end()) {
+        QString threadName = thread->objectName();
+        if (threadName.isEmpty()) {
+            if (QCoreApplication::instance() != nullptr
+                && thread == QCoreApplication::instance()->thread()) {
+                threadName = "Main";
+            } else {
+                threadName = QString("Thread %1").arg(_threadNames.size());
+            }
+        }
+        _threadNames[threadId] = threadName;
+    }
+
+    _events.append({name, threadId, begin, end - begin});
+}
@@ -60,12 +60,33 @@ GameComponents::GameComponents(
     this->setInitialized();
 }
 
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameComponents::GameComponents(QDataStream &stream)
+{
+    stream >> m_components;
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    this->setInitialized();
+}
+
 /**
  * @brief	Get component.
  */
 QString GameComponents::component(const QString &id)
 {
-    return m_components[id];
+    return m_components.value(id);
+}
+
+/**
+ * @brief		Write snapshot.
+ */
+void GameComponents::saveSnapshot(QDataStream &stream)
+{
+    stream << m_components;
 }
 
 /**
@@ -1,28 +1,37 @@
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QFile>
-#include <QtWidgets/QFileDialog>
-#include <QtWidgets/QMessageBox>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 
 #include <config.h>
 #include <game_data/game_data.h>
+#include <game_data/game_data_snapshot.h>
 #include <game_data/game_texts.h>
+#include <global.h>
 #include <locale/string_table.h>
 
 /**
  * @brief		Constructor.
  */
-GameData::GameData(SplashWidget* splash) : QObject(nullptr)
+GameData::GameData(IGameDataLoadingSink* sink) :
+    QObject(nullptr), m_watcher(nullptr), m_reloadTimer(nullptr),
+    m_reloadTask(nullptr)
 {
     while (true) {
-        splash->setText(STR("STR_CHECKING_GAME_PATH"));
+        sink->setText(STR("STR_CHECKING_GAME_PATH"));
 
         // Check game path
         m_gamePath = Config::instance()->getString("/gamePath", "");
         QMap<QString, GameVFS::CatFileInfo> catFiles;
         if (!checkGamePath(m_gamePath, catFiles)) {
-            if (splash->callFunc(::std::function<bool()>(
-                ::std::bind(&GameData::askGamePath, this)))) {
+            QString path;
+            if (sink->askGamePath(m_gamePath, path)) {
+                m_gamePath = path;
+                Config::instance()->setString("/gamePath", m_gamePath);
                 continue;
             }
             else {
@@ -30,127 +39,216 @@ GameData::GameData(SplashWidget* splash) : QObject(nullptr)
             }
         }
 
-        // Load vfs
-        splash->setText(STR("STR_LOADING_VFS"));
-        ::std::shared_ptr<GameVFS> vfs = GameVFS::create(
-            m_gamePath, catFiles,
-            [&](const QString& s) -> void {
-                splash->setText(STR("STR_LOADING_VFS") + "\n" + s);
-            },
-            [&](const QString& s) -> void {
-                splash->callFunc(::std::function<void()>([&]() -> void {
-                    QMessageBox::critical(splash, STR("STR_ERROR"), s);
-                    }));
-            });
-        if (vfs == nullptr) {
-            Config::instance()->setString("/gamePath", "");
-            continue;
+        m_catFiles = catFiles;
+
+        // Load snapshot, the virtual filesystem is not required in this case
+        // and will be loaded when it is used.
+        sink->setText(STR("STR_LOADING_SNAPSHOT"));
+        QByteArray       fingerprint = GameDataSnapshot::fingerprint(m_gamePath);
+        GameDataSnapshot snapshot;
+        bool             snapshotLoaded;
+        {
+            Trace::Scope scope("Load snapshot");
+            snapshotLoaded = snapshot.load(Global::instance()->snapshotPath(),
+                                           fingerprint);
         }
-
-        // Load text
-        ::std::shared_ptr<GameTexts> texts
-            = GameTexts::load(vfs, [&](const QString& s) -> void {
-            splash->setText(STR("STR_LOADING_TEXTS") + "\n" + s);
-                });
-
-        if (texts == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_STRINGS"));
-                }));
-            Config::instance()->setString("/gamePath", "");
-            continue;
+        if (snapshotLoaded) {
+            m_texts             = snapshot.texts;
+            m_macros            = snapshot.macros;
+            m_components        = snapshot.components;
+            m_races             = snapshot.races;
+            m_wares             = snapshot.wares;
+            m_stationModules    = snapshot.stationModules;
+            m_inputFingerprints = snapshot.inputFingerprints;
+
+            break;
         }
 
-        // Load game macros
-        ::std::shared_ptr<GameMacros> macros
-            = GameMacros::load(vfs, [&](const QString& s) -> void {
-            splash->setText(s);
+        // Load vfs
+        sink->setText(STR("STR_LOADING_VFS"));
+        ::std::shared_ptr<GameVFS> vfs;
+        {
+            Trace::Scope scope("VFS");
+            vfs = GameVFS::create(
+                m_gamePath, catFiles,
+                [&](const QString& s) -> void {
+                    sink->setText(STR("STR_LOADING_VFS") + "\n" + s);
+                },
+                [&](const QString& s) -> void {
+                    sink->showError(s);
                 });
-
-        if (macros == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_MACROS"));
-                }));
+        }
+        if (vfs == nullptr) {
             Config::instance()->setString("/gamePath", "");
             continue;
         }
 
-        // Load game components
-        ::std::shared_ptr<GameComponents> components
-            = GameComponents::load(vfs, [&](const QString& s) -> void {
-            splash->setText(s);
-                });
-
-        if (components == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_COMPONENTS"));
-                }));
+        // Load game data.
+        if (! this->loadGameData(vfs, sink, snapshot, {})) {
             Config::instance()->setString("/gamePath", "");
             continue;
         }
 
-        // Load game races
-        ::std::shared_ptr<GameRaces> races
-            = GameRaces::load(vfs, texts, [&](const QString& s) -> void {
-            splash->setText(s);
-                });
-
-        if (races == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_RACES"));
-                }));
-            Config::instance()->setString("/gamePath", "");
-            continue;
+        // Set value
+        m_vfs               = vfs;
+        m_texts             = snapshot.texts;
+        m_macros            = snapshot.macros;
+        m_components        = snapshot.components;
+        m_races             = snapshot.races;
+        m_wares             = snapshot.wares;
+        m_stationModules    = snapshot.stationModules;
+        m_inputFingerprints = GameData::inputFingerprints(m_gamePath, vfs);
+
+        // Save snapshot
+        sink->setText(STR("STR_SAVING_SNAPSHOT"));
+        snapshot.inputFingerprints = m_inputFingerprints;
+        {
+            Trace::Scope scope("Save snapshot");
+            snapshot.save(Global::instance()->snapshotPath(), fingerprint);
         }
 
-        // Load game wares
-        ::std::shared_ptr<GameWares> wares
-            = GameWares::load(vfs, texts, [&](const QString& s) -> void {
-            splash->setText(s);
-                });
+        break;
+    }
 
-        if (wares == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_WARES"));
-                }));
-            Config::instance()->setString("/gamePath", "");
-            continue;
-        }
+    // Timers and watchers of hot reloading live in the thread of the
+    // application.
+    if (QCoreApplication::instance() != nullptr) {
+        this->moveToThread(QCoreApplication::instance()->thread());
+    }
 
-        // Load station modules
-        ::std::shared_ptr<GameStationModules> stationModules
-            = GameStationModules::load(vfs, macros, texts, wares, components,
-                [&](const QString& s) -> void {
-                    splash->setText(s);
-                });
+    this->setInitialized();
+}
 
-        if (stationModules == nullptr) {
-            splash->callFunc(::std::function<void()>([&]() -> void {
-                QMessageBox::critical(splash, STR("STR_ERROR"),
-                STR("STR_FAILED_LOAD_STATION_MODULES"));
-                }));
-            Config::instance()->setString("/gamePath", "");
-            continue;
+/**
+ * @brief		Load game data.
+ */
+bool GameData::loadGameData(::std::shared_ptr<GameVFS> vfs,
+    IGameDataLoadingSink*                               sink,
+    GameDataSnapshot&                                   data,
+    const QSet<QString>&                                keep)
+{
+    // Texts, macros and components are independent, races and wares require
+    // texts, station modules require all of them.
+    TaskGraph              taskGraph;
+    QMap<int, QString>     errorStrings;
+    QMutex                 progressLock;
+    QMap<QString, QString> progress;
+    int                    finishedCount = 0;
+
+    // Show progress of all running tasks, empty string means finished.
+    auto setProgress = [&](const QString &name, const QString &s) -> void {
+        QMutexLocker locker(&progressLock);
+        if (s.isEmpty()) {
+            progress.remove(name);
+            ++finishedCount;
+        } else {
+            progress[name] = s;
         }
 
-        // Set value
-        m_vfs = vfs;
-        m_texts = texts;
-        m_macros = macros;
-        m_components = components;
-        m_races = races;
-        m_wares = wares;
-        m_stationModules = stationModules;
-
-        break;
+        QStringList lines;
+        lines.append(STR("STR_LOADING_GAME_DATA")
+                         .arg(finishedCount)
+                         .arg(taskGraph.taskCount()));
+        for (auto &line : progress) {
+            lines.append(line);
+        }
+        sink->setText(lines.join("\n"));
+    };
+
+    // Load text
+    int textsTask = taskGraph.addTask("texts", [&]() -> bool {
+        if (! keep.contains("texts")) {
+            data.texts = GameTexts::load(vfs, [&](const QString &s) -> void {
+                setProgress("texts", STR("STR_LOADING_TEXTS") + "\n" + s);
+            });
+        }
+        setProgress("texts", "");
+        return data.texts != nullptr;
+    });
+    errorStrings[textsTask] = "STR_FAILED_LOAD_STRINGS";
+
+    // Load game macros
+    int macrosTask = taskGraph.addTask("macros", [&]() -> bool {
+        if (! keep.contains("macros")) {
+            data.macros = GameMacros::load(vfs, [&](const QString &s) -> void {
+                setProgress("macros", s);
+            });
+        }
+        setProgress("macros", "");
+        return data.macros != nullptr;
+    });
+    errorStrings[macrosTask] = "STR_FAILED_LOAD_MACROS";
+
+    // Load game components
+    int componentsTask = taskGraph.addTask("components", [&]() -> bool {
+        if (! keep.contains("components")) {
+            data.components
+                = GameComponents::load(vfs, [&](const QString &s) -> void {
+                      setProgress("components", s);
+                  });
+        }
+        setProgress("components", "");
+        return data.components != nullptr;
+    });
+    errorStrings[componentsTask] = "STR_FAILED_LOAD_COMPONENTS";
+
+    // Load game races
+    int racesTask = taskGraph.addTask(
+        "races",
+        [&]() -> bool {
+            if (! keep.contains("races")) {
+                data.races = GameRaces::load(vfs, data.texts,
+                                             [&](const QString &s) -> void {
+                                                 setProgress("races", s);
+                                             });
+            }
+            setProgress("races", "");
+            return data.races != nullptr;
+        },
+        {textsTask});
+    errorStrings[racesTask] = "STR_FAILED_LOAD_RACES";
+
+    // Load game wares
+    int waresTask = taskGraph.addTask(
+        "wares",
+        [&]() -> bool {
+            if (! keep.contains("wares")) {
+                data.wares = GameWares::load(vfs, data.texts,
+                                             [&](const QString &s) -> void {
+                                                 setProgress("wares", s);
+                                             });
+            }
+            setProgress("wares", "");
+            return data.wares != nullptr;
+        },
+        {textsTask});
+    errorStrings[waresTask] = "STR_FAILED_LOAD_WARES";
+
+    // Load station modules
+    int stationModulesTask = taskGraph.addTask(
+        "stationModules",
+        [&]() -> bool {
+            if (! keep.contains("stationModules")) {
+                data.stationModules = GameStationModules::load(
+                    vfs, data.macros, data.texts, data.wares, data.components,
+                    [&](const QString &s) -> void {
+                        setProgress("stationModules", s);
+                    });
+            }
+            setProgress("stationModules", "");
+            return data.stationModules != nullptr;
+        },
+        {textsTask, macrosTask, componentsTask, racesTask, waresTask});
+    errorStrings[stationModulesTask] = "STR_FAILED_LOAD_STATION_MODULES";
+
+    if (! taskGraph.run()) {
+        QString errorString = errorStrings.value(taskGraph.failedTask(),
+                                                 "STR_FAILED_LOAD_STRINGS");
+        sink->showError(STR(errorString));
+        return false;
     }
 
-    this->setInitialized();
+    return true;
 }
 
 /**
@@ -177,6 +275,270 @@ bool GameData::setGamePath(const QString& path)
     return true;
 }
 
+/**
+ * @brief		Enable hot reloading.
+ */
+void GameData::enableHotReload()
+{
+    if (m_watcher != nullptr) {
+        return;
+    }
+
+    m_reloadTask  = new BackgroundTask(BackgroundTask::RunType::Newest, this);
+    m_reloadTimer = new QTimer(this);
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(GAME_DATA_RELOAD_DELAY);
+    this->connect(m_reloadTimer, &QTimer::timeout, this,
+                  &GameData::requestReload);
+
+    m_watcher = new QFileSystemWatcher(this);
+    auto onChanged = [this](const QString &path) -> void {
+        qDebug() << "Game file changed :" << path << ".";
+        m_reloadTimer->start();
+    };
+    this->connect(m_watcher, &QFileSystemWatcher::directoryChanged, this,
+                  onChanged);
+    this->connect(m_watcher, &QFileSystemWatcher::fileChanged, this,
+                  onChanged);
+
+    this->updateWatchedPaths();
+}
+
+/**
+ * @brief		Reload game data in background.
+ */
+void GameData::requestReload()
+{
+    if (m_reloadTask == nullptr) {
+        return;
+    }
+
+    QString gamePath = Config::instance()->getString("/gamePath", "");
+    m_reloadTask->runTask([this, gamePath]() -> void {
+        this->reload(gamePath);
+    });
+}
+
+/**
+ * @brief		Reload game data.
+ */
+void GameData::reload(const QString& gamePath)
+{
+    Trace::Scope scope("Reload");
+    qDebug() << "Reloading game data...";
+
+    QMap<QString, GameVFS::CatFileInfo> catFiles;
+    if (! this->checkGamePath(gamePath, catFiles)) {
+        qWarning() << "Illegal game path :" << gamePath << ".";
+        return;
+    }
+
+    // Index game files.
+    HeadlessGameDataLoadingSink sink;
+    ::std::shared_ptr<GameVFS>  vfs = GameVFS::create(
+        gamePath, catFiles,
+        [&](const QString& s) -> void {
+            sink.setText(s);
+        },
+        [&](const QString& s) -> void {
+            sink.showError(s);
+        });
+    if (vfs == nullptr) {
+        return;
+    }
+
+    // Current data.
+    GameDataSnapshot          data;
+    QMap<QString, QByteArray> oldFingerprints;
+    QString                   oldGamePath;
+    {
+        QMutexLocker locker(&m_vfsLock);
+        oldGamePath = m_gamePath;
+    }
+    {
+        QMutexLocker locker(&m_dataLock);
+        data.texts          = m_texts;
+        data.macros         = m_macros;
+        data.components     = m_components;
+        data.races          = m_races;
+        data.wares          = m_wares;
+        data.stationModules = m_stationModules;
+        oldFingerprints     = m_inputFingerprints;
+    }
+
+    // Keep loaders whose inputs and dependencies are not changed.
+    static const QVector<QPair<QString, QStringList>> loaders = {
+        {"texts", {}},
+        {"macros", {}},
+        {"components", {}},
+        {"races", {"texts"}},
+        {"wares", {"texts"}},
+        {"stationModules",
+         {"texts", "macros", "components", "races", "wares"}}};
+    QMap<QString, QByteArray> fingerprints
+        = GameData::inputFingerprints(gamePath, vfs);
+    QSet<QString> keep;
+    if (gamePath == oldGamePath) {
+        for (auto &loader : loaders) {
+            QByteArray oldFingerprint = oldFingerprints.value(loader.first);
+            if (oldFingerprint.isEmpty()
+                || oldFingerprint != fingerprints.value(loader.first)) {
+                continue;
+            }
+
+            bool dependenciesKept = true;
+            for (auto &dependency : loader.second) {
+                if (! keep.contains(dependency)) {
+                    dependenciesKept = false;
+                    break;
+                }
+            }
+            if (dependenciesKept) {
+                keep.insert(loader.first);
+            }
+        }
+    }
+    if (keep.size() == loaders.size()) {
+        qDebug() << "Game data not changed.";
+        return;
+    }
+    qDebug() << "Loaders kept :" << keep.values() << ".";
+
+    if (! this->loadGameData(vfs, &sink, data, keep)) {
+        return;
+    }
+
+    // Swap data.
+    {
+        QMutexLocker vfsLocker(&m_vfsLock);
+        QMutexLocker dataLocker(&m_dataLock);
+        m_gamePath          = gamePath;
+        m_catFiles          = catFiles;
+        m_vfs               = vfs;
+        m_texts             = data.texts;
+        m_macros            = data.macros;
+        m_components        = data.components;
+        m_races             = data.races;
+        m_wares             = data.wares;
+        m_stationModules    = data.stationModules;
+        m_inputFingerprints = fingerprints;
+    }
+
+    // Save snapshot.
+    data.inputFingerprints = fingerprints;
+    data.save(Global::instance()->snapshotPath(),
+              GameDataSnapshot::fingerprint(gamePath));
+
+    QMetaObject::invokeMethod(
+        this, [this]() -> void { this->updateWatchedPaths(); },
+        Qt::ConnectionType::QueuedConnection);
+
+    qDebug() << "Game data reloaded.";
+    emit this->dataReloaded();
+}
+
+/**
+ * @brief		Update paths watched for hot reloading.
+ */
+void GameData::updateWatchedPaths()
+{
+    QString                             gamePath;
+    QMap<QString, GameVFS::CatFileInfo> catFiles;
+    {
+        QMutexLocker locker(&m_vfsLock);
+        gamePath = m_gamePath;
+        catFiles = m_catFiles;
+    }
+
+    QStringList paths;
+    QDir        dir(gamePath);
+    paths.append(dir.absolutePath());
+    paths.append(dir.absoluteFilePath("extensions"));
+    for (auto &extension :
+         QDir(dir.absoluteFilePath("extensions"))
+             .entryInfoList(QDir::Filter::Dirs | QDir::Filter::NoDotAndDotDot,
+                            QDir::SortFlag::Name)) {
+        paths.append(extension.absoluteFilePath());
+    }
+    for (auto &catFile : catFiles) {
+        paths.append(dir.absoluteFilePath(catFile.cat));
+        paths.append(dir.absoluteFilePath(catFile.dat));
+    }
+    // The watcher is not recursive, subdirectories of loose inputs are
+    // watched as well.
+    for (auto &loaderPaths : GameData::inputPaths(gamePath)) {
+        for (auto &path : loaderPaths) {
+            paths.append(dir.absoluteFilePath(path));
+            QDirIterator iter(dir.absoluteFilePath(path),
+                              QDir::Filter::Dirs | QDir::Filter::NoDotAndDotDot,
+                              QDirIterator::IteratorFlag::Subdirectories);
+            while (iter.hasNext()) {
+                paths.append(iter.next());
+            }
+        }
+    }
+
+    QStringList existingPaths;
+    for (auto &path : paths) {
+        if (QFileInfo::exists(path)) {
+            existingPaths.append(path);
+        }
+    }
+
+    QStringList watched = m_watcher->files() + m_watcher->directories();
+    if (! watched.empty()) {
+        m_watcher->removePaths(watched);
+    }
+    m_watcher->addPaths(existingPaths);
+}
+
+/**
+ * @brief		Get paths of inputs of each loader.
+ */
+QMap<QString, QStringList> GameData::inputPaths(const QString& gamePath)
+{
+    QStringList prefixes = {""};
+    QDir        extensionsDir(QDir(gamePath).absoluteFilePath("extensions"));
+    for (auto &extension : extensionsDir.entryInfoList(
+             QDir::Filter::Dirs | QDir::Filter::NoDotAndDotDot,
+             QDir::SortFlag::Name)) {
+        prefixes.append(QString("extensions/%1/").arg(extension.fileName()));
+    }
+
+    QMap<QString, QStringList> ret;
+    for (auto &prefix : prefixes) {
+        ret["texts"].append(prefix + "t");
+        ret["macros"].append(prefix + "index/macros.xml");
+        ret["components"].append(prefix + "index/components.xml");
+        ret["races"].append(prefix + "libraries/races.xml");
+        ret["wares"].append(prefix + "libraries/waregroups.xml");
+        ret["wares"].append(prefix + "libraries/wares.xml");
+        ret["stationModules"].append(prefix + "libraries/modulegroups.xml");
+        ret["stationModules"].append(prefix + "content.xml");
+        ret["stationModules"].append(prefix + "assets");
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Compute fingerprints of inputs of each loader.
+ */
+QMap<QString, QByteArray>
+    GameData::inputFingerprints(const QString&             gamePath,
+                                ::std::shared_ptr<GameVFS> vfs)
+{
+    Trace::Scope scope("Input fingerprints");
+
+    QMap<QString, QStringList> paths = GameData::inputPaths(gamePath);
+    QMap<QString, QByteArray>  ret;
+    for (auto iter = paths.begin(); iter != paths.end(); ++iter) {
+        ret[iter.key()] = vfs->fingerprint(*iter);
+    }
+
+    return ret;
+}
+
 /**
  * @brief Destructor.
  */
@@ -300,35 +662,20 @@ bool GameData::checkGamePath(const QString& path,
     return true;
 }
 
-/**
- * @brief		Ask game path.
- */
-bool GameData::askGamePath()
-{
-    QFileDialog fileDialog(nullptr, STR("STR_TITLE_SELECT_GAME_PATH"),
-        m_gamePath, "*");
-    fileDialog.setAcceptMode(QFileDialog::AcceptMode::AcceptOpen);
-    fileDialog.setFileMode(QFileDialog::FileMode::Directory);
-    fileDialog.setFilter(QDir::Filter::Dirs | QDir::Filter::Hidden
-        | QDir::Filter::System);
-    if (fileDialog.exec() != QDialog::DialogCode::Accepted
-        || fileDialog.selectedFiles().empty()) {
-        return false;
-    }
-    QString str = QDir(fileDialog.selectedFiles()[0]).absolutePath();
-    qDebug() << "Selected:" << str;
-
-    m_gamePath = str;
-    Config::instance()->setString("/gamePath", m_gamePath);
-
-    return true;
-}
-
 /*
  * @brief	Get game VFS.
  */
 ::std::shared_ptr<GameVFS> GameData::vfs()
 {
+    QMutexLocker locker(&m_vfsLock);
+    if (m_vfs == nullptr) {
+        m_vfs = GameVFS::create(
+            m_gamePath, m_catFiles, [](const QString &) -> void {},
+            [](const QString &s) -> void {
+                qWarning() << s;
+            });
+    }
+
     return m_vfs;
 }
 
@@ -337,6 +684,7 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameTexts> GameData::texts()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_texts;
 }
 
@@ -345,6 +693,7 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameMacros> GameData::macros()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_macros;
 }
 
@@ -353,6 +702,7 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameComponents> GameData::components()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_components;
 }
 
@@ -361,6 +711,7 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameRaces> GameData::races()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_races;
 }
 
@@ -369,6 +720,7 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameWares> GameData::wares()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_wares;
 }
 
@@ -377,5 +729,6 @@ bool GameData::askGamePath()
  */
 ::std::shared_ptr<GameStationModules> GameData::stationModules()
 {
+    QMutexLocker locker(&m_dataLock);
     return m_stationModules;
 }
@@ -0,0 +1,49 @@
+#include <QtCore/QDebug>
+
+#include <game_data/game_data_loading_sink.h>
+
+/**
+ * @brief		Constructor.
+ */
+HeadlessGameDataLoadingSink::HeadlessGameDataLoadingSink(
+    const QString &gamePath) :
+    m_gamePath(gamePath),
+    m_asked(false)
+{}
+
+/**
+ * @brief		Show progress.
+ */
+void HeadlessGameDataLoadingSink::setText(const QString &text)
+{
+    qDebug().noquote() << text;
+}
+
+/**
+ * @brief		Show error.
+ */
+void HeadlessGameDataLoadingSink::showError(const QString &message)
+{
+    qWarning().noquote() << message;
+}
+
+/**
+ * @brief		Ask for path of game.
+ */
+bool HeadlessGameDataLoadingSink::askGamePath(const QString &current,
+                                              QString &      path)
+{
+    if (m_asked || m_gamePath.isEmpty() || m_gamePath == current) {
+        qWarning() << "No available game path.";
+        return false;
+    }
+
+    m_asked = true;
+    path    = m_gamePath;
+    return true;
+}
+
+/**
+ * @brief	Destructor.
+ */
+HeadlessGameDataLoadingSink::~HeadlessGameDataLoadingSink() {}
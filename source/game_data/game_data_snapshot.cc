@@ -0,0 +1,197 @@
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+#include <game_data/game_data.h>
+#include <game_data/game_data_snapshot.h>
+
+/**
+ * @brief		Compute fingerprint of game files.
+ */
+QByteArray GameDataSnapshot::fingerprint(const QString &gamePath)
+{
+    QCryptographicHash hash(QCryptographicHash::Algorithm::Sha1);
+    QDir               dir(gamePath);
+
+    auto addEntry = [&](const QString &name, const QFileInfo &info) -> void {
+        hash.addData(name.toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(
+            QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    };
+
+    hash.addData(dir.absolutePath().toUtf8());
+
+    // Cat/dat files and loose files in game directory.
+    for (auto &entry :
+         dir.entryInfoList(QDir::Filter::Files | QDir::Filter::Dirs
+                               | QDir::Filter::NoDotAndDotDot,
+                           QDir::SortFlag::Name)) {
+        addEntry(entry.fileName(), entry);
+    }
+
+    // Extensions.
+    QDir extensionsDir(dir.absoluteFilePath("extensions"));
+    for (auto &modEntry : extensionsDir.entryInfoList(
+             QDir::Filter::Dirs | QDir::Filter::NoDotAndDotDot,
+             QDir::SortFlag::Name)) {
+        QDir modDir(modEntry.absoluteFilePath());
+        for (auto &modFile : modDir.entryInfoList(
+                 QDir::Filter::Files | QDir::Filter::Dirs
+                     | QDir::Filter::NoDotAndDotDot,
+                 QDir::SortFlag::Name)) {
+            addEntry(QString("extensions/%1/%2")
+                         .arg(modEntry.fileName(), modFile.fileName()),
+                     modFile);
+        }
+    }
+
+    // Loose inputs of loaders, files in directories are walked recursively
+    // so editing them in place changes the fingerprint.
+    QStringList inputs;
+    for (auto &paths : GameData::inputPaths(gamePath)) {
+        inputs.append(paths);
+    }
+    inputs.sort();
+    inputs.removeDuplicates();
+    for (auto &input : inputs) {
+        QFileInfo info(dir.absoluteFilePath(input));
+        if (info.isFile()) {
+            addEntry(input, info);
+        } else if (info.isDir()) {
+            QDirIterator iter(info.absoluteFilePath(), QDir::Filter::Files,
+                              QDirIterator::IteratorFlag::Subdirectories);
+            QStringList  files;
+            while (iter.hasNext()) {
+                files.append(iter.next());
+            }
+            files.sort();
+            for (auto &file : files) {
+                addEntry(dir.relativeFilePath(file), QFileInfo(file));
+            }
+        }
+    }
+
+    return hash.result();
+}
+
+/**
+ * @brief		Load snapshot.
+ */
+bool GameDataSnapshot::load(const QString &path, const QByteArray &fingerprint)
+{
+    qDebug() << "Loading game data snapshot" << path << "...";
+
+    QFile file(path);
+    if (! file.open(QIODevice::OpenModeFlag::ReadOnly)) {
+        qDebug() << "No snapshot.";
+        return false;
+    }
+
+    // Map file.
+    QByteArray data;
+    uchar *    mapped = file.map(0, file.size());
+    if (mapped != nullptr) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                       static_cast<qsizetype>(file.size()));
+    } else {
+        data = file.readAll();
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+
+    // Check header.
+    quint32    magic   = 0;
+    quint32    version = 0;
+    QByteArray snapshotFingerprint;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok
+        || magic != GAME_DATA_SNAPSHOT_MAGIC
+        || version != GAME_DATA_SNAPSHOT_VERSION) {
+        qDebug() << "Snapshot version mismatch.";
+        return false;
+    }
+
+    stream >> snapshotFingerprint;
+    if (stream.status() != QDataStream::Ok
+        || snapshotFingerprint != fingerprint) {
+        qDebug() << "Game files changed since the snapshot was written.";
+        return false;
+    }
+
+    stream >> inputFingerprints;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // Load data.
+    texts = GameTexts::loadSnapshot(stream);
+    if (texts == nullptr) {
+        return false;
+    }
+    macros = GameMacros::loadSnapshot(stream);
+    if (macros == nullptr) {
+        return false;
+    }
+    components = GameComponents::loadSnapshot(stream);
+    if (components == nullptr) {
+        return false;
+    }
+    races = GameRaces::loadSnapshot(stream);
+    if (races == nullptr) {
+        return false;
+    }
+    wares = GameWares::loadSnapshot(stream);
+    if (wares == nullptr) {
+        return false;
+    }
+    stationModules = GameStationModules::loadSnapshot(stream, wares, texts);
+    if (stationModules == nullptr) {
+        return false;
+    }
+
+    qDebug() << "Snapshot loaded.";
+    return true;
+}
+
+/**
+ * @brief		Save snapshot.
+ */
+bool GameDataSnapshot::save(const QString &path, const QByteArray &fingerprint)
+{
+    qDebug() << "Saving game data snapshot" << path << "...";
+
+    QSaveFile file(path);
+    if (! file.open(QIODevice::OpenModeFlag::WriteOnly)) {
+        qWarning() << "Failed to open snapshot file" << path << ".";
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+
+    stream << static_cast<quint32>(GAME_DATA_SNAPSHOT_MAGIC)
+           << static_cast<quint32>(GAME_DATA_SNAPSHOT_VERSION) << fingerprint
+           << inputFingerprints;
+    texts->saveSnapshot(stream);
+    macros->saveSnapshot(stream);
+    components->saveSnapshot(stream);
+    races->saveSnapshot(stream);
+    wares->saveSnapshot(stream);
+    stationModules->saveSnapshot(stream);
+
+    if (stream.status() != QDataStream::Ok || ! file.commit()) {
+        qWarning() << "Failed to write snapshot file" << path << ".";
+        return false;
+    }
+
+    qDebug() << "Snapshot saved.";
+    return true;
+}
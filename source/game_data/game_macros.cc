@@ -62,12 +62,33 @@ GameMacros::GameMacros(::std::shared_ptr<GameVFS>             vfs,
     this->setInitialized();
 }
 
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameMacros::GameMacros(QDataStream &stream)
+{
+    stream >> m_macros;
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    this->setInitialized();
+}
+
 /**
  * @brief	Get macro.
  */
 QString GameMacros::macro(const QString &id)
 {
-    return m_macros[id];
+    return m_macros.value(id);
+}
+
+/**
+ * @brief		Write snapshot.
+ */
+void GameMacros::saveSnapshot(QDataStream &stream)
+{
+    stream << m_macros;
 }
 
 /**
@@ -0,0 +1,442 @@
+#include <algorithm>
+#include <functional>
+
+#include <game_data/game_production_solver.h>
+
+/// Maximum iterations to settle the demand of cycles and habitations.
+#define PRODUCTION_SOLVER_MAX_ITERATIONS 16
+
+/**
+ * @brief		Constructor.
+ */
+GameProductionSolver::GameProductionSolver(
+    const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+        &          modules,
+    const Options &options) :
+    m_options(options), m_totalShare(0)
+{
+    typedef GameStationModules::StationModule StationModule;
+
+    // Share of the workforce of the races of the module.
+    auto raceShare = [this](const ::std::shared_ptr<StationModule> &module)
+        -> quint64 {
+        quint64 ret = 0;
+        for (const auto &race : module->races) {
+            ret = ::std::max(ret, m_options.workforce.value(race, 0));
+        }
+        return ret;
+    };
+
+    // Habitation modules, the largest one of each race.
+    QMap<QString, Habitation> habitations;
+    for (const auto &module : modules) {
+        quint64 workforce
+            = module->counters[StationModule::SupplyWorkforceAmount];
+        if (! module->playerModule || workforce == 0) {
+            continue;
+        }
+        for (const auto &race : module->races) {
+            quint64 share = m_options.workforce.value(race, 0);
+            if (share == 0) {
+                continue;
+            }
+            auto iter = habitations.find(race);
+            if (iter == habitations.end() || iter->workforce < workforce) {
+                habitations[race] = {module, share, workforce, {}};
+            }
+        }
+    }
+    m_habitations = habitations.values();
+    for (const auto &habitation : m_habitations) {
+        m_totalShare += habitation.share;
+    }
+    bool useWorkforce = ! m_habitations.empty();
+
+    // Production modules, one of each production method.
+    for (const auto &module : modules) {
+        auto iter = module->properties.find(
+            GameStationModules::Property::SupplyProduct);
+        if (! module->playerModule || iter == module->properties.end()
+            || module->products.empty()) {
+            continue;
+        }
+        auto &productionInfo
+            = ::std::static_pointer_cast<GameStationModules::SupplyProduct>(
+                  *iter)
+                  ->productionInfo;
+        const auto &product = module->products.front();
+
+        Candidate candidate
+            = {module,
+               useWorkforce ? product.max : product.min,
+               module->counters[StationModule::RequireWorkforceAmount],
+               productionInfo->method,
+               this->methodRank(productionInfo->method),
+               {}};
+        if (candidate.rate <= Rate()) {
+            continue;
+        }
+
+        // Modules of the same method produce at the same rate, prefer the
+        // race with the largest share of workforce.
+        auto &candidates = m_candidates[product.ware];
+        auto  sameMethod = ::std::find_if(
+            candidates.begin(), candidates.end(),
+            [&](const Candidate &c) -> bool {
+                return c.method == candidate.method;
+            });
+        if (sameMethod == candidates.end()) {
+            candidates.push_back(candidate);
+        } else if (raceShare(module) > raceShare(sameMethod->module)) {
+            *sameMethod = candidate;
+        }
+    }
+
+    // Try preferred methods first, then faster ones.
+    for (auto &candidates : m_candidates) {
+        ::std::stable_sort(
+            candidates.begin(), candidates.end(),
+            [](const Candidate &c1, const Candidate &c2) -> bool {
+                if (c1.rank != c2.rank) {
+                    return c1.rank < c2.rank;
+                }
+                return c1.rate > c2.rate;
+            });
+    }
+}
+
+/**
+ * @brief		Solve.
+ */
+GameProductionSolver::Result
+    GameProductionSolver::solve(const QMap<QString, Rate> &targets)
+{
+    // Modules kept out of the solver supply a part of the targets and
+    // consume resources.
+    QMap<QString, Rate> demand = targets;
+    for (auto iter = m_options.keptRates.begin();
+         iter != m_options.keptRates.end(); ++iter) {
+        demand[iter.key()] -= iter.value();
+    }
+
+    this->indexWares(demand);
+    int count = m_wares.size();
+
+    QVector<Rate> base(count);
+    for (auto iter = demand.begin(); iter != demand.end(); ++iter) {
+        base[m_index[iter.key()]] += iter.value();
+    }
+
+    // Demand of cycles and habitation modules is unknown until the layout is
+    // known, so search again until it settles.
+    Context context;
+    context.nodes   = 0;
+    context.timeout = false;
+    context.timer.start();
+
+    QVector<Rate> extra(count);
+    for (int iteration = 0; iteration < PRODUCTION_SOLVER_MAX_ITERATIONS;
+         ++iteration) {
+        context.demand.resize(count);
+        for (int i = 0; i < count; ++i) {
+            context.demand[i] = base[i] + extra[i];
+        }
+        context.choices   = QVector<Choice>(count, {-1, 0});
+        context.cost      = {0, 0, 0};
+        context.workforce = 0;
+        context.found     = false;
+        this->search(context, 0);
+
+        // Demand which is not counted by the search.
+        QVector<Rate> newExtra(count);
+        quint64       workforce = 0;
+        for (int i = 0; i < count; ++i) {
+            const Choice &choice = context.best[i];
+            if (choice.candidate < 0) {
+                continue;
+            }
+            const Candidate &candidate = m_wareCandidates[i][choice.candidate];
+            workforce += candidate.workforce * choice.amount;
+            for (const auto &resource : candidate.resources) {
+                if (resource.ware <= i) {
+                    newExtra[resource.ware] += resource.rate * choice.amount;
+                }
+            }
+        }
+        QVector<quint64> habitationAmounts
+            = this->habitationAmounts(this->requiredWorkforce(workforce));
+        for (int i = 0; i < m_habitations.size(); ++i) {
+            for (const auto &resource : m_habitations[i].resources) {
+                newExtra[resource.ware]
+                    += resource.rate * habitationAmounts[i];
+            }
+        }
+
+        bool settled = newExtra == extra;
+        extra.swap(newExtra);
+        if (settled) {
+            break;
+        }
+    }
+
+    // Make result.
+    Result result;
+    result.workforce = 0;
+    result.optimal   = ! context.timeout;
+
+    QVector<Rate> supply(count);
+    QVector<Rate> consumption(base);
+    auto addModules = [&](const QString &             macro,
+                          const QVector<Consumption> &resources,
+                          quint64                     amount) -> void {
+        result.modules[macro] += amount;
+        for (const auto &resource : resources) {
+            consumption[resource.ware] += resource.rate * amount;
+        }
+    };
+    for (int i = 0; i < count; ++i) {
+        const Choice &choice = context.best[i];
+        if (choice.candidate >= 0) {
+            const Candidate &candidate = m_wareCandidates[i][choice.candidate];
+            supply[i] += candidate.rate * choice.amount;
+            result.workforce += candidate.workforce * choice.amount;
+            addModules(candidate.module->macro, candidate.resources,
+                       choice.amount);
+        }
+    }
+    QVector<quint64> habitationAmounts
+        = this->habitationAmounts(this->requiredWorkforce(result.workforce));
+    for (int i = 0; i < m_habitations.size(); ++i) {
+        if (habitationAmounts[i] > 0) {
+            addModules(m_habitations[i].module->macro,
+                       m_habitations[i].resources, habitationAmounts[i]);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (context.best[i].candidate >= 0) {
+            result.products[m_wares[i]] = supply[i] - consumption[i];
+        } else if (consumption[i] > Rate()) {
+            result.resources[m_wares[i]] = consumption[i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief		Get rank of production method.
+ */
+int GameProductionSolver::methodRank(const QString &method) const
+{
+    // Same order as the new factory wizard, the first method, then the
+    // default method, then the others.
+    int index = m_options.methodOrder.indexOf(method);
+    if (index == 0) {
+        return 0;
+    } else if (method == "default") {
+        return 1;
+    } else if (index > 0) {
+        return index + 1;
+    } else {
+        return m_options.methodOrder.size() + 1;
+    }
+}
+
+/**
+ * @brief		Index wares needed by targets.
+ */
+void GameProductionSolver::indexWares(const QMap<QString, Rate> &targets)
+{
+    // Post-order of resources.
+    QVector<QString> order;
+    QSet<QString>    visited;
+
+    ::std::function<void(const QString &)> visit;
+    visit = [&](const QString &ware) -> void {
+        if (visited.contains(ware)) {
+            return;
+        }
+        visited.insert(ware);
+
+        if (! m_options.resources.contains(ware)) {
+            for (const auto &candidate : m_candidates.value(ware)) {
+                for (const auto &resource : candidate.module->resources) {
+                    visit(resource.ware);
+                }
+            }
+        }
+        order.push_back(ware);
+    };
+    for (auto iter = targets.begin(); iter != targets.end(); ++iter) {
+        visit(iter.key());
+    }
+    for (const auto &habitation : m_habitations) {
+        for (const auto &resource : habitation.module->resources) {
+            visit(resource.ware);
+        }
+    }
+
+    // Consumers come first.
+    m_wares.clear();
+    m_index.clear();
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter) {
+        m_index[*iter] = m_wares.size();
+        m_wares.push_back(*iter);
+    }
+
+    // Resources.
+    bool useWorkforce = ! m_habitations.empty();
+    m_wareCandidates.clear();
+    for (const auto &ware : m_wares) {
+        QVector<Candidate> candidates;
+        if (! m_options.resources.contains(ware)) {
+            candidates = m_candidates.value(ware);
+            for (auto &candidate : candidates) {
+                candidate.resources = this->makeConsumptions(
+                    candidate.module->resources, useWorkforce);
+            }
+        }
+        m_wareCandidates.push_back(candidates);
+    }
+    for (auto &habitation : m_habitations) {
+        habitation.resources
+            = this->makeConsumptions(habitation.module->resources, true);
+    }
+}
+
+/**
+ * @brief		Make resources indexed by wares.
+ */
+QVector<GameProductionSolver::Consumption>
+    GameProductionSolver::makeConsumptions(
+        const QVector<GameStationModules::StationModule::WareRate> &rates,
+        bool                                                        max)
+{
+    QVector<Consumption> ret;
+    for (const auto &rate : rates) {
+        ret.push_back({m_index[rate.ware], max ? rate.max : rate.min});
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Get workforce habitation modules of the solver supply.
+ */
+quint64 GameProductionSolver::requiredWorkforce(quint64 workforce) const
+{
+    qint64 ret = static_cast<qint64>(workforce) - m_options.keptWorkforce;
+    return ret > 0 ? static_cast<quint64>(ret) : 0;
+}
+
+/**
+ * @brief		Get amount of habitation modules.
+ */
+QVector<quint64>
+    GameProductionSolver::habitationAmounts(quint64 workforce) const
+{
+    QVector<quint64> ret;
+    for (const auto &habitation : m_habitations) {
+        quint64 divisor = m_totalShare * habitation.workforce;
+        ret.push_back((workforce * habitation.share + divisor - 1) / divisor);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Search layouts.
+ */
+void GameProductionSolver::search(Context &context, int index)
+{
+    // Stop at the time limit, but always find the first layout.
+    if (context.found) {
+        if (! context.timeout && (++context.nodes & 0xFF) == 0
+            && context.timer.elapsed() >= m_options.timeLimit) {
+            context.timeout = true;
+        }
+        if (context.timeout) {
+            return;
+        }
+    }
+
+    // Layout found.
+    if (index == m_wares.size()) {
+        Cost             cost      = context.cost;
+        quint64          workforce = this->requiredWorkforce(context.workforce);
+        QVector<quint64> amounts   = this->habitationAmounts(workforce);
+        for (int i = 0; i < m_habitations.size(); ++i) {
+            const Habitation &habitation = m_habitations[i];
+            quint64 divisor = m_totalShare * habitation.workforce;
+            cost.waste += static_cast<qint64>(
+                (amounts[i] * divisor - workforce * habitation.share)
+                * Rate::Scale / divisor);
+            cost.modules += amounts[i];
+        }
+
+        if (! context.found || less(cost, context.bestCost)) {
+            context.best     = context.choices;
+            context.bestCost = cost;
+            context.found    = true;
+        }
+        return;
+    }
+
+    // Bought or not needed.
+    Rate                      demand     = context.demand[index];
+    const QVector<Candidate> &candidates = m_wareCandidates[index];
+    if (demand <= Rate() || candidates.empty()) {
+        context.choices[index] = {-1, 0};
+        this->search(context, index + 1);
+        return;
+    }
+
+    // Branch on candidates.
+    Cost    cost      = context.cost;
+    quint64 workforce = context.workforce;
+    for (int i = 0; i < candidates.size(); ++i) {
+        const Candidate &candidate = candidates[i];
+        quint64          amount    = demand.ceilDiv(candidate.rate);
+
+        // Bound, costs never decrease in deeper levels.
+        context.cost
+            = {cost.waste
+                   + (candidate.rate * amount - demand).ratio(candidate.rate),
+               cost.rank + candidate.rank, cost.modules + amount};
+        if (context.found && ! less(context.cost, context.bestCost)) {
+            continue;
+        }
+        context.workforce      = workforce + candidate.workforce * amount;
+        context.choices[index] = {i, amount};
+
+        // Resources of cycles are counted by solve().
+        for (const auto &resource : candidate.resources) {
+            if (resource.ware > index) {
+                context.demand[resource.ware] += resource.rate * amount;
+            }
+        }
+        this->search(context, index + 1);
+        for (const auto &resource : candidate.resources) {
+            if (resource.ware > index) {
+                context.demand[resource.ware] -= resource.rate * amount;
+            }
+        }
+    }
+    context.cost      = cost;
+    context.workforce = workforce;
+}
+
+/**
+ * @brief		Compare costs.
+ */
+bool GameProductionSolver::less(const Cost &cost1, const Cost &cost2)
+{
+    if (cost1.waste != cost2.waste) {
+        return cost1.waste < cost2.waste;
+    } else if (cost1.rank != cost2.rank) {
+        return cost1.rank < cost2.rank;
+    } else {
+        return cost1.modules < cost2.modules;
+    }
+}
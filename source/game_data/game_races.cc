@@ -46,6 +46,26 @@ GameRaces::GameRaces(::std::shared_ptr<GameVFS>             vfs,
     this->setInitialized();
 }
 
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameRaces::GameRaces(QDataStream &stream)
+{
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        Race race;
+        stream >> race.id >> race.name >> race.description;
+        m_races[race.id] = race;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    this->setInitialized();
+}
+
 /**
  * @brief	Get race information.
  */
@@ -62,6 +82,17 @@ const QSet<QString> &GameRaces::playerRaces()
     return _playerRaces;
 }
 
+/**
+ * @brief		Write snapshot.
+ */
+void GameRaces::saveSnapshot(QDataStream &stream)
+{
+    stream << static_cast<quint32>(m_races.size());
+    for (auto &race : m_races) {
+        stream << race.id << race.name << race.description;
+    }
+}
+
 /**
  * @brief		Destructor.
  */
@@ -0,0 +1,188 @@
+#include <limits>
+
+#include <QtCore/QDebug>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define STATION_MODULE_TABLE_SSE2
+    #include <emmintrin.h>
+#endif
+
+#include <game_data/game_station_module_table.h>
+
+/// Columns are padded to a multiple of this.
+#define STATION_MODULE_TABLE_ALIGN 8
+
+/**
+ * @brief		Constructor.
+ */
+GameStationModuleTable::GameStationModuleTable(
+    const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+        &modules) :
+    m_modules(modules),
+    m_size(static_cast<quint32>(modules.size())),
+    m_stride((m_size + STATION_MODULE_TABLE_ALIGN - 1)
+             / STATION_MODULE_TABLE_ALIGN * STATION_MODULE_TABLE_ALIGN),
+    m_columns(m_stride * AttributeCount, 0)
+{
+    auto setValue = [this](int attribute, quint32 id, quint64 value) -> void {
+        if (value > ::std::numeric_limits<quint32>::max()) {
+            qWarning() << "Attribute" << attribute << "of module"
+                       << m_modules[id]->macro << "overflows, clamped.";
+            value = ::std::numeric_limits<quint32>::max();
+        }
+        m_columns[attribute * m_stride + id] = static_cast<quint32>(value);
+    };
+
+    for (quint32 id = 0; id < m_size; ++id) {
+        auto &module = m_modules[id];
+        m_ids[module->macro] = id;
+
+        for (int counter = 0;
+             counter < GameStationModules::StationModule::CounterCount;
+             ++counter) {
+            setValue(counter, id, module->counters[counter]);
+        }
+        setValue(Hull, id, module->hull);
+        setValue(ExplosionDamage, id, module->explosiondamage);
+    }
+}
+
+/**
+ * @brief		Get number of modules.
+ */
+quint32 GameStationModuleTable::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief		Get ID of module.
+ */
+qint64 GameStationModuleTable::id(const QString &macro) const
+{
+    auto iter = m_ids.find(macro);
+    if (iter == m_ids.end()) {
+        return -1;
+    }
+
+    return *iter;
+}
+
+/**
+ * @brief		Get module.
+ */
+::std::shared_ptr<GameStationModules::StationModule>
+    GameStationModuleTable::module(quint32 id) const
+{
+    return m_modules[id];
+}
+
+/**
+ * @brief		Get column of attribute.
+ */
+const quint32 *GameStationModuleTable::column(Attribute attribute) const
+{
+    return m_columns.constData() + attribute * m_stride;
+}
+
+/**
+ * @brief		Make a weights vector.
+ */
+QVector<quint32> GameStationModuleTable::makeWeights() const
+{
+    return QVector<quint32>(m_stride, 0);
+}
+
+/**
+ * @brief		Compute weighted sums of all attributes.
+ */
+GameStationModuleTable::Sums
+    GameStationModuleTable::sum(const QVector<quint32> &weights) const
+{
+    Q_ASSERT(static_cast<quint32>(weights.size()) == m_stride);
+
+    Sums           sums    = {};
+    const quint32 *w       = weights.constData();
+    const quint32 *columns = m_columns.constData();
+
+#if defined(__AVX2__)
+    // 8 modules per step, the products of even and odd lanes are
+    // accumulated separately in 64-bit lanes.
+    __m256i acc[AttributeCount];
+    for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+        acc[attribute] = _mm256_setzero_si256();
+    }
+    for (quint32 i = 0; i < m_stride; i += 8) {
+        __m256i weight = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(w + i));
+        if (_mm256_testz_si256(weight, weight)) {
+            continue;
+        }
+        __m256i weightOdd = _mm256_srli_epi64(weight, 32);
+        for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+                columns + attribute * m_stride + i));
+            acc[attribute] = _mm256_add_epi64(
+                acc[attribute],
+                _mm256_add_epi64(
+                    _mm256_mul_epu32(value, weight),
+                    _mm256_mul_epu32(_mm256_srli_epi64(value, 32), weightOdd)));
+        }
+    }
+    for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+        alignas(32) quint64 lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc[attribute]);
+        sums[attribute] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+#elif defined(STATION_MODULE_TABLE_SSE2)
+    // 4 modules per step, the products of even and odd lanes are
+    // accumulated separately in 64-bit lanes.
+    __m128i acc[AttributeCount];
+    for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+        acc[attribute] = _mm_setzero_si128();
+    }
+    for (quint32 i = 0; i < m_stride; i += 4) {
+        __m128i weight
+            = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(weight, _mm_setzero_si128()))
+            == 0xFFFF) {
+            continue;
+        }
+        __m128i weightOdd = _mm_srli_epi64(weight, 32);
+        for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                columns + attribute * m_stride + i));
+            acc[attribute] = _mm_add_epi64(
+                acc[attribute],
+                _mm_add_epi64(
+                    _mm_mul_epu32(value, weight),
+                    _mm_mul_epu32(_mm_srli_epi64(value, 32), weightOdd)));
+        }
+    }
+    for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+        alignas(16) quint64 lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc[attribute]);
+        sums[attribute] = lanes[0] + lanes[1];
+    }
+
+#else
+    // Scalar fallback.
+    for (quint32 i = 0; i < m_stride; ++i) {
+        if (w[i] == 0) {
+            continue;
+        }
+        for (int attribute = 0; attribute < AttributeCount; ++attribute) {
+            sums[attribute]
+                += static_cast<quint64>(columns[attribute * m_stride + i])
+                   * w[i];
+        }
+    }
+
+#endif
+
+    return sums;
+}
@@ -1,10 +1,15 @@
+#include <atomic>
 #include <cmath>
 
 #include <QtCore/QDebug>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QSet>
 
+#include <game_data/game_station_module_table.h>
 #include <game_data/game_station_modules.h>
+#include <game_data/game_ware_graph.h>
 
 #include "game_data/game_races.h"
 
@@ -36,6 +41,8 @@ GameStationModules::GameStationModules(
 {
     qDebug() << "Loading station modules...";
     setTextFunc(STR("STR_LOADING_STATION_MODULES"));
+
+    // Collect macros of modules from module groups.
     // Open
     ::std::shared_ptr<GameVFS::FileReader> fileReader
         = vfs->open("/libraries/modulegroups.xml");
@@ -49,11 +56,6 @@ GameStationModules::GameStationModules(
         ::std::bind(&GameStationModules::onStartElementInRootOfModuleGroups,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
             ::std::placeholders::_3, ::std::placeholders::_4));
-    loader["vfs"] = vfs;
-    loader["macros"] = macros;
-    loader["texts"] = texts;
-    loader["wares"] = wares;
-    loader["components"] = components;
     loader.parse(reader, ::std::move(context));
 
     // Parse extension files
@@ -84,7 +86,232 @@ GameStationModules::GameStationModules(
         }
     }
 
+    // Load macros of modules.
+    QVector<QVector<::std::shared_ptr<StationModule>>> loadedModules(
+        m_macroTmpList.size());
+    QVector<::std::shared_ptr<StationModule>>* results = loadedModules.data();
+    int                    nextMacro = 0;
+    QMutex                 nextMacroLock;
+    ::std::atomic<quint64> finishedCount;
+    int                    total = m_macroTmpList.size();
+    finishedCount = 0;
+    MultiRun loadTask(::std::function<void()>([&]() -> void {
+        while (true) {
+            // Get macro
+            int index;
+            {
+                QMutexLocker locker(&nextMacroLock);
+                if (nextMacro >= total) {
+                    return;
+                }
+                index = nextMacro;
+                ++nextMacro;
+            }
+
+            // Load macro
+            Trace::Scope scope(m_macroTmpList.at(index));
+            results[index] = this->loadMacro(
+                m_macroTmpList.at(index), vfs, macros, texts, wares, components);
+
+            finishedCount += 1;
+            setTextFunc(STR("STR_LOADING_STATION_MODULE_MACRO")
+                .arg(finishedCount)
+                .arg(total));
+        }
+    }));
+
+    setTextFunc(
+        STR("STR_LOADING_STATION_MODULE_MACRO").arg(finishedCount).arg(total));
+    loadTask.run();
+
+    // Merge modules in the order of macros.
+    for (auto& modules : loadedModules) {
+        for (auto& module : modules) {
+            this->limitRacesByComponent(module);
+            buildCounters(module, wares);
+            if (module->playerModule
+                && m_modulesIndex.find(module->macro) == m_modulesIndex.end()) {
+                m_modulesIndex[module->macro] = module;
+                m_modules.push_back(module);
+            }
+        }
+    }
+
+    m_macroTmpList.clear();
+    m_macroTmpSet.clear();
     m_componentTmpIndex.clear();
+    m_connectionMacroCache.clear();
+    m_componentCache.clear();
+    m_table     = ::std::make_shared<GameStationModuleTable>(m_modules);
+    m_wareGraph = ::std::make_shared<GameWareGraph>(m_modules);
+    this->setInitialized();
+}
+
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameStationModules::GameStationModules(QDataStream& stream,
+    ::std::shared_ptr<GameWares> wares,
+    ::std::shared_ptr<GameTexts> texts)
+{
+    quint32 moduleCount = 0;
+    stream >> moduleCount;
+    for (quint32 i = 0;
+        i < moduleCount && stream.status() == QDataStream::Ok; ++i) {
+        ::std::shared_ptr<StationModule> module(new StationModule);
+        qint32                           moduleClass = 0;
+        quint32                          propertyCount = 0;
+        stream >> module->macro >> module->component >> module->name
+            >> moduleClass >> module->playerModule >> module->description
+            >> module->racialLimited >> module->races >> module->hull
+            >> module->explosiondamage >> propertyCount;
+        module->moduleClass
+            = static_cast<StationModule::StationModuleClass>(moduleClass);
+
+        for (quint32 j = 0;
+            j < propertyCount && stream.status() == QDataStream::Ok; ++j) {
+            qint32 type = 0;
+            stream >> type;
+            switch (static_cast<Property::Type>(type)) {
+            case Property::Type::MTurret: {
+                ::std::shared_ptr<HasMTurret> property(new HasMTurret);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::MShield: {
+                ::std::shared_ptr<HasMShield> property(new HasMShield);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::LTurret: {
+                ::std::shared_ptr<HasLTurret> property(new HasLTurret);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::LShield: {
+                ::std::shared_ptr<HasLShield> property(new HasLShield);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::SDock: {
+                ::std::shared_ptr<HasSDock> property(new HasSDock);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::SShipCargo: {
+                ::std::shared_ptr<HasSShipCargo> property(new HasSShipCargo);
+                stream >> property->capacity;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::MDock: {
+                ::std::shared_ptr<HasMDock> property(new HasMDock);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::MShipCargo: {
+                ::std::shared_ptr<HasMShipCargo> property(new HasMShipCargo);
+                stream >> property->capacity;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::LDock: {
+                ::std::shared_ptr<HasLDock> property(new HasLDock);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::XLDock: {
+                ::std::shared_ptr<HasXLDock> property(new HasXLDock);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::LXLDock: {
+                ::std::shared_ptr<HasLXLDock> property(new HasLXLDock);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::SLaunchTube: {
+                ::std::shared_ptr<HasSLaunchTube> property(new HasSLaunchTube);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::MLaunchTube: {
+                ::std::shared_ptr<HasMLaunchTube> property(new HasMLaunchTube);
+                stream >> property->count;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::SupplyWorkforce: {
+                ::std::shared_ptr<SupplyWorkforce> property(
+                    new SupplyWorkforce);
+                property->supplyInfo
+                    = ::std::shared_ptr<GameWares::ProductionInfo>(
+                        new GameWares::ProductionInfo);
+                stream >> property->workforce >> *(property->supplyInfo);
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::RequireWorkforce: {
+                ::std::shared_ptr<RequireWorkforce> property(
+                    new RequireWorkforce);
+                stream >> property->workforce;
+                module->properties[property->type] = property;
+            } break;
+
+            case Property::Type::SupplyProduct: {
+                // Production information is shared with the ware.
+                ::std::shared_ptr<SupplyProduct> property(new SupplyProduct);
+                QString                          method;
+                stream >> property->product >> method;
+                ::std::shared_ptr<GameWares::Ware> ware
+                    = wares->ware(property->product, texts);
+                auto infoIter = ware->productionInfos.find(method);
+                if (infoIter == ware->productionInfos.end()) {
+                    infoIter = ware->productionInfos.find("default");
+                }
+                if (infoIter != ware->productionInfos.end()) {
+                    property->productionInfo = *infoIter;
+                    module->properties[property->type] = property;
+                }
+            } break;
+
+            case Property::Type::Cargo: {
+                ::std::shared_ptr<HasCargo> property(new HasCargo);
+                qint32                      cargoType = 0;
+                stream >> cargoType >> property->cargoSize;
+                property->cargoType
+                    = static_cast<GameWares::TransportType>(cargoType);
+                module->properties[property->type] = property;
+            } break;
+
+            default:
+                qWarning() << "Unknow property type in snapshot :" << type
+                    << ".";
+                return;
+            }
+        }
+
+        buildCounters(module, wares);
+        m_modulesIndex[module->macro] = module;
+        m_modules.push_back(module);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    m_table     = ::std::make_shared<GameStationModuleTable>(m_modules);
+    m_wareGraph = ::std::make_shared<GameWareGraph>(m_modules);
     this->setInitialized();
 }
 
@@ -116,6 +343,120 @@ GameStationModules::module(const QString& macro)
     }
 }
 
+/**
+ * @brief		Get modules in structure-of-arrays layout.
+ */
+::std::shared_ptr<GameStationModuleTable> GameStationModules::table() const
+{
+    return m_table;
+}
+
+/**
+ * @brief		Get producers and consumers of wares.
+ */
+::std::shared_ptr<GameWareGraph> GameStationModules::wareGraph() const
+{
+    return m_wareGraph;
+}
+
+/**
+ * @brief		Write snapshot.
+ */
+void GameStationModules::saveSnapshot(QDataStream& stream)
+{
+    stream << static_cast<quint32>(m_modules.size());
+    for (auto& module : m_modules) {
+        stream << module->macro << module->component << module->name
+            << static_cast<qint32>(module->moduleClass)
+            << module->playerModule << module->description
+            << module->racialLimited << module->races << module->hull
+            << module->explosiondamage
+            << static_cast<quint32>(module->properties.size());
+
+        for (auto& baseProperty : module->properties) {
+            stream << static_cast<qint32>(baseProperty->type);
+            switch (baseProperty->type) {
+            case Property::Type::MTurret:
+                stream << ::std::static_pointer_cast<HasMTurret>(baseProperty)->count;
+                break;
+
+            case Property::Type::MShield:
+                stream << ::std::static_pointer_cast<HasMShield>(baseProperty)->count;
+                break;
+
+            case Property::Type::LTurret:
+                stream << ::std::static_pointer_cast<HasLTurret>(baseProperty)->count;
+                break;
+
+            case Property::Type::LShield:
+                stream << ::std::static_pointer_cast<HasLShield>(baseProperty)->count;
+                break;
+
+            case Property::Type::SDock:
+                stream << ::std::static_pointer_cast<HasSDock>(baseProperty)->count;
+                break;
+
+            case Property::Type::SShipCargo:
+                stream << ::std::static_pointer_cast<HasSShipCargo>(baseProperty)->capacity;
+                break;
+
+            case Property::Type::MDock:
+                stream << ::std::static_pointer_cast<HasMDock>(baseProperty)->count;
+                break;
+
+            case Property::Type::MShipCargo:
+                stream << ::std::static_pointer_cast<HasMShipCargo>(baseProperty)->capacity;
+                break;
+
+            case Property::Type::LDock:
+                stream << ::std::static_pointer_cast<HasLDock>(baseProperty)->count;
+                break;
+
+            case Property::Type::XLDock:
+                stream << ::std::static_pointer_cast<HasXLDock>(baseProperty)->count;
+                break;
+
+            case Property::Type::LXLDock:
+                stream << ::std::static_pointer_cast<HasLXLDock>(baseProperty)->count;
+                break;
+
+            case Property::Type::SLaunchTube:
+                stream << ::std::static_pointer_cast<HasSLaunchTube>(baseProperty)->count;
+                break;
+
+            case Property::Type::MLaunchTube:
+                stream << ::std::static_pointer_cast<HasMLaunchTube>(baseProperty)->count;
+                break;
+
+            case Property::Type::SupplyWorkforce: {
+                ::std::shared_ptr<SupplyWorkforce> property
+                    = ::std::static_pointer_cast<SupplyWorkforce>(baseProperty);
+                stream << property->workforce << *(property->supplyInfo);
+            } break;
+
+            case Property::Type::RequireWorkforce:
+                stream << ::std::static_pointer_cast<RequireWorkforce>(
+                    baseProperty)->workforce;
+                break;
+
+            case Property::Type::SupplyProduct: {
+                ::std::shared_ptr<SupplyProduct> property
+                    = ::std::static_pointer_cast<SupplyProduct>(baseProperty);
+                stream << property->product
+                    << property->productionInfo->method;
+            } break;
+
+            case Property::Type::Cargo: {
+                ::std::shared_ptr<HasCargo> property
+                    = ::std::static_pointer_cast<HasCargo>(baseProperty);
+                stream << static_cast<qint32>(property->cargoType)
+                    << property->cargoSize;
+            } break;
+            }
+        }
+    }
+}
+
 /**
  * @brief		Destructor.
  */
@@ -172,21 +513,11 @@ bool GameStationModules::onStartElementInGroupOfModuleGroups(
     const QString& name,
     const QMap<QString, QString>& attr)
 {
-    ::std::shared_ptr<GameVFS> vfs
-        = ::std::any_cast<::std::shared_ptr<GameVFS>>(loader["vfs"]);
-    ::std::shared_ptr<GameMacros> macros
-        = ::std::any_cast<::std::shared_ptr<GameMacros>>(loader["macros"]);
-    ::std::shared_ptr<GameTexts> texts
-        = ::std::any_cast<::std::shared_ptr<GameTexts>>(loader["texts"]);
-    ::std::shared_ptr<GameWares> wares
-        = ::std::any_cast<::std::shared_ptr<GameWares>>(loader["wares"]);
-    ::std::shared_ptr<GameComponents> components
-        = ::std::any_cast<::std::shared_ptr<GameComponents>>(
-            loader["components"]);
     if (name == "select") {
         auto iter = attr.find("macro");
-        if (iter != attr.end()) {
-            this->loadMacro(*iter, vfs, macros, texts, wares, components);
+        if (iter != attr.end() && (!m_macroTmpSet.contains(*iter))) {
+            m_macroTmpSet.insert(*iter);
+            m_macroTmpList.append(*iter);
         }
     }
     loader.pushContext(XMLLoader::Context::create());
@@ -196,24 +527,23 @@ bool GameStationModules::onStartElementInGroupOfModuleGroups(
 /**
  * @brief		Load macro.
  */
-void GameStationModules::loadMacro(const QString& macro,
+QVector<::std::shared_ptr<GameStationModules::StationModule>>
+GameStationModules::loadMacro(const QString& macro,
     ::std::shared_ptr<GameVFS>        vfs,
     ::std::shared_ptr<GameMacros>     macros,
     ::std::shared_ptr<GameTexts>      texts,
     ::std::shared_ptr<GameWares>      wares,
     ::std::shared_ptr<GameComponents> components)
 {
-    if (m_modulesIndex.find(macro) != m_modulesIndex.end()) {
-        return;
-    }
-
     qDebug() << "Loading station module macro" << macro << "...";
     ::std::shared_ptr<GameVFS::FileReader> file
         = vfs->open(macros->macro(macro) + ".xml");
     if (file == nullptr) {
-        return;
+        return {};
     }
 
+    ::std::shared_ptr<QVector<::std::shared_ptr<StationModule>>> modules(
+        new QVector<::std::shared_ptr<StationModule>>());
     QXmlStreamReader                      reader(file->readAll());
     XMLLoader                             loader;
     ::std::unique_ptr<XMLLoader::Context> context
@@ -227,7 +557,202 @@ void GameStationModules::loadMacro(const QString& macro,
     loader["texts"] = texts;
     loader["wares"] = wares;
     loader["components"] = components;
+    loader["modules"] = modules;
     loader.parse(reader, ::std::move(context));
+
+    return *modules;
+}
+
+/**
+ * @brief		Limit races of modules share the same component.
+ */
+void GameStationModules::limitRacesByComponent(
+    ::std::shared_ptr<StationModule> module)
+{
+    if (module->component.isEmpty()) {
+        return;
+    }
+
+    auto componentIter = m_componentTmpIndex.find(module->component);
+    if (componentIter == m_componentTmpIndex.end()) {
+        m_componentTmpIndex[module->component] = { module };
+        return;
+    }
+
+    for (auto& otherModule : *componentIter) {
+        if (module->racialLimited && (!otherModule->racialLimited)) {
+            for (auto& race : module->races) {
+                auto iter = otherModule->races.find(race);
+                if (iter != otherModule->races.end()) {
+                    otherModule->races.erase(iter);
+                }
+            }
+        }
+        if ((!module->racialLimited) && otherModule->racialLimited) {
+            for (auto& race : otherModule->races) {
+                auto iter = module->races.find(race);
+                if (iter != module->races.end()) {
+                    module->races.erase(iter);
+                }
+            }
+        }
+    }
+    componentIter->push_back(module);
+}
+
+/**
+ * @brief		Build counters and rates of the module.
+ */
+void GameStationModules::buildCounters(::std::shared_ptr<StationModule> module,
+    ::std::shared_ptr<GameWares> wares)
+{
+    auto& counters = module->counters;
+    counters.fill(0);
+    module->products.clear();
+    module->resources.clear();
+
+    auto transportType = [&](const QString& id) -> GameWares::TransportType {
+        auto ware = wares->ware(id);
+        return ware == nullptr ? GameWares::TransportType::Unknow
+                               : ware->transportType;
+    };
+
+    for (auto& property : module->properties) {
+        switch (property->type) {
+        case Property::Type::MTurret:
+            counters[StationModule::MTurretCount]
+                += static_cast<HasMTurret*>(property.get())->count;
+            break;
+
+        case Property::Type::MShield:
+            counters[StationModule::MShieldCount]
+                += static_cast<HasMShield*>(property.get())->count;
+            break;
+
+        case Property::Type::LTurret:
+            counters[StationModule::LTurretCount]
+                += static_cast<HasLTurret*>(property.get())->count;
+            break;
+
+        case Property::Type::LShield:
+            counters[StationModule::LShieldCount]
+                += static_cast<HasLShield*>(property.get())->count;
+            break;
+
+        case Property::Type::SDock:
+            counters[StationModule::SDockCount]
+                += static_cast<HasSDock*>(property.get())->count;
+            break;
+
+        case Property::Type::SShipCargo:
+            counters[StationModule::SShipCargoCapacity]
+                += static_cast<HasSShipCargo*>(property.get())->capacity;
+            break;
+
+        case Property::Type::MDock:
+            counters[StationModule::MDockCount]
+                += static_cast<HasMDock*>(property.get())->count;
+            break;
+
+        case Property::Type::MShipCargo:
+            counters[StationModule::MShipCargoCapacity]
+                += static_cast<HasMShipCargo*>(property.get())->capacity;
+            break;
+
+        case Property::Type::LDock:
+            counters[StationModule::LDockCount]
+                += static_cast<HasLDock*>(property.get())->count;
+            break;
+
+        case Property::Type::XLDock:
+            counters[StationModule::XLDockCount]
+                += static_cast<HasXLDock*>(property.get())->count;
+            break;
+
+        case Property::Type::LXLDock:
+            counters[StationModule::LXLDockCount]
+                += static_cast<HasLXLDock*>(property.get())->count;
+            break;
+
+        case Property::Type::SLaunchTube:
+            counters[StationModule::SLaunchTubeCount]
+                += static_cast<HasSLaunchTube*>(property.get())->count;
+            break;
+
+        case Property::Type::MLaunchTube:
+            counters[StationModule::MLaunchTubeCount]
+                += static_cast<HasMLaunchTube*>(property.get())->count;
+            break;
+
+        case Property::Type::SupplyWorkforce: {
+            auto supplyWorkforce
+                = static_cast<SupplyWorkforce*>(property.get());
+            counters[StationModule::SupplyWorkforceAmount]
+                += supplyWorkforce->workforce;
+
+            // Resources consumed by workforce.
+            auto& supplyInfo = supplyWorkforce->supplyInfo;
+            for (auto& resource : supplyInfo->resources) {
+                module->resources.push_back(
+                    { resource->id, Rate(),
+                        Rate::perCycle((qint64)(resource->amount)
+                                           * supplyWorkforce->workforce,
+                            (qint64)(supplyInfo->amount) * supplyInfo->time),
+                        transportType(resource->id) });
+            }
+        } break;
+
+        case Property::Type::RequireWorkforce:
+            counters[StationModule::RequireWorkforceAmount]
+                += static_cast<RequireWorkforce*>(property.get())->workforce;
+            break;
+
+        case Property::Type::SupplyProduct: {
+            auto& productionInfo
+                = static_cast<SupplyProduct*>(property.get())->productionInfo;
+            qint64 workEffect
+                = Rate::Scale
+                  + qRound64(productionInfo->workEffect * Rate::Scale);
+
+            // Product.
+            Rate rate
+                = Rate::perCycle(productionInfo->amount, productionInfo->time);
+            module->products.push_back({ productionInfo->id, rate,
+                rate.scaled(workEffect, Rate::Scale),
+                transportType(productionInfo->id) });
+
+            // Resources.
+            for (auto& resource : productionInfo->resources) {
+                rate = Rate::perCycle(resource->amount, productionInfo->time);
+                module->resources.push_back({ resource->id, rate,
+                    rate.scaled(workEffect, Rate::Scale),
+                    transportType(resource->id) });
+            }
+        } break;
+
+        case Property::Type::Cargo: {
+            auto hasCargo = static_cast<HasCargo*>(property.get());
+            switch (hasCargo->cargoType) {
+            case GameWares::TransportType::Container:
+                counters[StationModule::ContainerCargoSize]
+                    += hasCargo->cargoSize;
+                break;
+
+            case GameWares::TransportType::Solid:
+                counters[StationModule::SolidCargoSize] += hasCargo->cargoSize;
+                break;
+
+            case GameWares::TransportType::Liquid:
+                counters[StationModule::LiquidCargoSize]
+                    += hasCargo->cargoSize;
+                break;
+
+            default:
+                break;
+            }
+        } break;
+        }
+    }
 }
 
 /**
@@ -304,11 +829,13 @@ bool GameStationModules::onStartElementInMacrosOfModuleMacro(
                 & currentContext,
                 const QString& name) -> bool {
                     if (name == "macro") {
-                        if (module->playerModule) {
-                            // Add module.
-                            m_modulesIndex[module->macro] = module;
-                            m_modules.push_back(module);
+                        // Add module.
+                        ::std::any_cast<::std::shared_ptr<
+                            QVector<::std::shared_ptr<StationModule>>>>(
+                            loader["modules"])
+                            ->push_back(module);
 
+                        if (module->playerModule) {
                             // Print information
                             ::std::shared_ptr<GameTexts> texts
                                 = ::std::any_cast<::std::shared_ptr<GameTexts>>(
@@ -486,14 +1013,6 @@ bool GameStationModules::onStartElementInMacroOfModuleMacro(
 
     if (name == "component") {
         module->component = attr["ref"];
-        auto iter = m_componentTmpIndex.find(attr["ref"]);
-        if (iter == m_componentTmpIndex.end()) {
-            m_componentTmpIndex[module->component] = { module };
-        }
-        else {
-            m_componentTmpIndex[module->component].push_back(module);
-        }
-
         this->loadComponent(attr["ref"], module, vfs, macros, texts, wares,
             components);
     }
@@ -542,27 +1061,6 @@ bool GameStationModules::onStartElementInPropertiesOfModuleMacro(
             module->races = { *iter };
             module->racialLimited = true;
         }
-        for (auto& otherModule : m_componentTmpIndex[module->component]) {
-            if (otherModule == module) {
-                continue;
-            }
-            if (module->racialLimited && (!otherModule->racialLimited)) {
-                for (auto& race : module->races) {
-                    auto iter = otherModule->races.find(race);
-                    if (iter != otherModule->races.end()) {
-                        otherModule->races.erase(iter);
-                    }
-                }
-            }
-            if ((!module->racialLimited) && otherModule->racialLimited) {
-                for (auto& race : otherModule->races) {
-                    auto iter = module->races.find(race);
-                    if (iter != module->races.end()) {
-                        module->races.erase(iter);
-                    }
-                }
-            }
-        }
     }
     else if (name == "build") {
         context->setOnStartElement(::std::bind(
@@ -882,6 +1380,32 @@ bool GameStationModules::onStartElementInConnectionOfModuleMacro(
     return true;
 }
 
+/**
+ * @brief		Add value to a field of a property of station module, the
+ *				property is created if not exists.
+ */
+template<class T>
+static void addPropertyValue(
+    ::std::shared_ptr<GameStationModules::StationModule> module,
+    quint64 T::*field,
+    quint64                                              value)
+{
+    if (value == 0) {
+        return;
+    }
+
+    ::std::shared_ptr<T> property;
+    auto                 iter = module->properties.find(T().type);
+    if (iter == module->properties.end()) {
+        property = ::std::shared_ptr<T>(new T);
+        module->properties[property->type] = property;
+    }
+    else {
+        property = ::std::static_pointer_cast<T>(*iter);
+    }
+    (*property).*field += value;
+}
+
 /**
  * @brief		Load macro in connections of module macro.
  */
@@ -890,31 +1414,84 @@ void GameStationModules::loadConnectionMacro(
     ::std::shared_ptr<StationModule>  module,
     ::std::shared_ptr<GameVFS>        vfs,
     ::std::shared_ptr<GameMacros>     macros,
-    ::std::shared_ptr<GameTexts>      texts,
-    ::std::shared_ptr<GameWares>      wares,
-    ::std::shared_ptr<GameComponents> components)
+    ::std::shared_ptr<GameTexts>,
+    ::std::shared_ptr<GameWares>,
+    ::std::shared_ptr<GameComponents>)
 {
+    ::std::shared_ptr<ConnectionMacroInfo> info
+        = this->connectionMacroInfo(macro, vfs, macros);
+
+    for (auto& dockingBay : info->dockingBays) {
+        switch (dockingBay.type) {
+            case TmpDockingBayInfo::S:
+                addPropertyValue(module, &HasSDock::count, dockingBay.count);
+                addPropertyValue(module, &HasSShipCargo::capacity,
+                    dockingBay.capacity);
+                break;
+
+            case TmpDockingBayInfo::M:
+                addPropertyValue(module, &HasMDock::count, dockingBay.count);
+                addPropertyValue(module, &HasMShipCargo::capacity,
+                    dockingBay.capacity);
+                break;
+
+            case TmpDockingBayInfo::L:
+                addPropertyValue(module, &HasLDock::count, dockingBay.count);
+                break;
+
+            case TmpDockingBayInfo::XL:
+                addPropertyValue(module, &HasXLDock::count, dockingBay.count);
+                break;
+
+            case TmpDockingBayInfo::L_XL:
+                addPropertyValue(module, &HasLXLDock::count, dockingBay.count);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief		Get parsed connection macro.
+ */
+::std::shared_ptr<GameStationModules::ConnectionMacroInfo>
+GameStationModules::connectionMacroInfo(const QString& macro,
+    ::std::shared_ptr<GameVFS>                          vfs,
+    ::std::shared_ptr<GameMacros>                       macros)
+{
+    {
+        QMutexLocker locker(&m_connectionMacroCacheLock);
+        auto         iter = m_connectionMacroCache.find(macro);
+        if (iter != m_connectionMacroCache.end()) {
+            return *iter;
+        }
+    }
+
     qDebug() << "Loading macro in connection" << macro << "...";
+    ::std::shared_ptr<ConnectionMacroInfo> info(new ConnectionMacroInfo);
     ::std::shared_ptr<GameVFS::FileReader> file
         = vfs->open(macros->macro(macro) + ".xml");
-    if (file == nullptr) {
-        return;
+    if (file != nullptr) {
+        QXmlStreamReader                      reader(file->readAll());
+        XMLLoader                             loader;
+        ::std::unique_ptr<XMLLoader::Context> context
+            = XMLLoader::Context::create();
+        context->setOnStartElement(::std::bind(
+            &GameStationModules::onStartElementInRootOfConnectionMacro, this,
+            ::std::placeholders::_1, ::std::placeholders::_2,
+            ::std::placeholders::_3, ::std::placeholders::_4, info));
+        loader.parse(reader, ::std::move(context));
     }
 
-    QXmlStreamReader                      reader(file->readAll());
-    XMLLoader                             loader;
-    ::std::unique_ptr<XMLLoader::Context> context
-        = XMLLoader::Context::create();
-    context->setOnStartElement(
-        ::std::bind(&GameStationModules::onStartElementInRootOfConnectionMacro,
-            this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
-    loader["vfs"] = vfs;
-    loader["macros"] = macros;
-    loader["texts"] = texts;
-    loader["wares"] = wares;
-    loader["components"] = components;
-    loader.parse(reader, ::std::move(context));
+    // Another thread may have parsed the same macro meanwhile, keep the
+    // first record.
+    QMutexLocker locker(&m_connectionMacroCacheLock);
+    auto         iter = m_connectionMacroCache.find(macro);
+    if (iter != m_connectionMacroCache.end()) {
+        return *iter;
+    }
+    m_connectionMacroCache[macro] = info;
+
+    return info;
 }
 
 /**
@@ -925,7 +1502,7 @@ bool GameStationModules::onStartElementInRootOfConnectionMacro(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>&,
-    ::std::shared_ptr<StationModule> module)
+    ::std::shared_ptr<ConnectionMacroInfo> macroInfo)
 {
     ::std::unique_ptr<XMLLoader::Context> context
         = XMLLoader::Context::create();
@@ -934,7 +1511,7 @@ bool GameStationModules::onStartElementInRootOfConnectionMacro(
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInMacrosOfConnectionMacro, this,
             ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
+            ::std::placeholders::_3, ::std::placeholders::_4, macroInfo));
     }
 
     loader.pushContext(::std::move(context));
@@ -949,7 +1526,7 @@ bool GameStationModules::onStartElementInMacrosOfConnectionMacro(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>& attr,
-    ::std::shared_ptr<StationModule> module)
+    ::std::shared_ptr<ConnectionMacroInfo> macroInfo)
 {
     ::std::unique_ptr<XMLLoader::Context> context
         = XMLLoader::Context::create();
@@ -961,7 +1538,7 @@ bool GameStationModules::onStartElementInMacrosOfConnectionMacro(
             context->setOnStartElement(::std::bind(
                 &GameStationModules::onStartElementInMacroOfConnectionMacro,
                 this, ::std::placeholders::_1, ::std::placeholders::_2,
-                ::std::placeholders::_3, ::std::placeholders::_4, module));
+                ::std::placeholders::_3, ::std::placeholders::_4, macroInfo));
         }
     }
 
@@ -977,7 +1554,7 @@ bool GameStationModules::onStartElementInMacroOfConnectionMacro(
     XMLLoader::Context& currentContext,
     const QString& name,
     const QMap<QString, QString>&,
-    ::std::shared_ptr<StationModule> module)
+    ::std::shared_ptr<ConnectionMacroInfo> macroInfo)
 {
     ::std::unique_ptr<XMLLoader::Context> context
         = XMLLoader::Context::create();
@@ -989,157 +1566,19 @@ bool GameStationModules::onStartElementInMacroOfConnectionMacro(
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInnPropertiesOfConnectionMacro,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module, info));
+            ::std::placeholders::_3, ::std::placeholders::_4, info));
 
         currentContext.setOnStopElement(::std::bind(
             [](XMLLoader&, XMLLoader::Context&, const QString& name,
-                ::std::shared_ptr<StationModule>     module,
-                ::std::shared_ptr<TmpDockingBayInfo> info) -> bool {
+                ::std::shared_ptr<ConnectionMacroInfo> macroInfo,
+                ::std::shared_ptr<TmpDockingBayInfo>   info) -> bool {
                     if (name == "properties") {
-                        switch (info->type) {
-                            case TmpDockingBayInfo::S:
-                                if (info->count > 0) {
-                                    // S docking bay.
-                                    ::std::shared_ptr<HasSDock> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::SDock);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasSDock>(
-                                            new HasSDock);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property
-                                            = ::std::static_pointer_cast<HasSDock>(
-                                                *iter);
-                                    }
-                                    property->count += info->count;
-                                }
-                                if (info->capacity > 0) {
-                                    // S ship cargo.
-                                    ::std::shared_ptr<HasSShipCargo> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::SShipCargo);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasSShipCargo>(
-                                            new HasSShipCargo);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property = ::std::static_pointer_cast<
-                                            HasSShipCargo>(*iter);
-                                    }
-                                    property->capacity += info->capacity;
-                                }
-                                break;
-
-                            case TmpDockingBayInfo::M:
-                                if (info->count > 0) {
-                                    // M docking bay.
-                                    ::std::shared_ptr<HasMDock> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::MDock);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasMDock>(
-                                            new HasMDock);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property
-                                            = ::std::static_pointer_cast<HasMDock>(
-                                                *iter);
-                                    }
-                                    property->count += info->count;
-                                }
-                                if (info->capacity > 0) {
-                                    // M ship cargo.
-                                    ::std::shared_ptr<HasMShipCargo> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::MShipCargo);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasMShipCargo>(
-                                            new HasMShipCargo);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property = ::std::static_pointer_cast<
-                                            HasMShipCargo>(*iter);
-                                    }
-                                    property->capacity += info->capacity;
-                                }
-                                break;
-
-                            case TmpDockingBayInfo::L:
-                                if (info->count > 0) {
-                                    // L docking bay.
-                                    ::std::shared_ptr<HasLDock> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::LDock);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasLDock>(
-                                            new HasLDock);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property
-                                            = ::std::static_pointer_cast<HasLDock>(
-                                                *iter);
-                                    }
-                                    property->count += info->count;
-                                }
-                                break;
-
-                            case TmpDockingBayInfo::XL:
-                                if (info->count > 0) {
-                                    // XL docking bay.
-                                    ::std::shared_ptr<HasXLDock> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::XLDock);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasXLDock>(
-                                            new HasXLDock);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property
-                                            = ::std::static_pointer_cast<HasXLDock>(
-                                                *iter);
-                                    }
-                                    property->count += info->count;
-                                }
-                                break;
-
-                            case TmpDockingBayInfo::L_XL:
-                                if (info->count > 0) {
-                                    // L/XL docking bay.
-                                    ::std::shared_ptr<HasLXLDock> property;
-                                    auto iter = module->properties.find(
-                                        Property::Type::LXLDock);
-                                    if (iter == module->properties.end()) {
-                                        property = ::std::shared_ptr<HasLXLDock>(
-                                            new HasLXLDock);
-                                        module->properties[property->type]
-                                            = property;
-                                    }
-                                    else {
-                                        property = ::std::static_pointer_cast<
-                                            HasLXLDock>(*iter);
-                                    }
-                                    property->count += info->count;
-                                }
-                                break;
-                        }
+                        macroInfo->dockingBays.append(*info);
                     }
                     return true;
             },
             ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, module, info));
+            ::std::placeholders::_3, macroInfo, info));
     }
 
     loader.pushContext(::std::move(context));
@@ -1155,7 +1594,6 @@ bool GameStationModules::onStartElementInnPropertiesOfConnectionMacro(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>& attr,
-    ::std::shared_ptr<StationModule>,
     ::std::shared_ptr<TmpDockingBayInfo> info)
 {
     ::std::unique_ptr<XMLLoader::Context> context
@@ -1213,6 +1651,53 @@ void GameStationModules::loadComponent(
     ::std::shared_ptr<GameTexts>      texts,
     ::std::shared_ptr<GameWares>      wares,
     ::std::shared_ptr<GameComponents> components)
+{
+    ::std::shared_ptr<ComponentInfo> info;
+    {
+        QMutexLocker locker(&m_componentCacheLock);
+        auto         iter = m_componentCache.find(component);
+        if (iter != m_componentCache.end()) {
+            info = *iter;
+        }
+    }
+
+    if (info == nullptr) {
+        // Parse the component, its properties are applied to the module
+        // directly.
+        info = ::std::shared_ptr<ComponentInfo>(
+            new ComponentInfo({ 0, 0, 0, 0, false }));
+        this->parseComponent(component, info, module, vfs, macros, texts,
+            wares, components);
+
+        QMutexLocker locker(&m_componentCacheLock);
+        if (m_componentCache.find(component) == m_componentCache.end()) {
+            m_componentCache[component] = info;
+        }
+    }
+    else if (info->hasProperties) {
+        // Properties are not cached, parse them again.
+        this->parseComponent(component, nullptr, module, vfs, macros, texts,
+            wares, components);
+    }
+
+    addPropertyValue(module, &HasMTurret::count, info->mTurretCount);
+    addPropertyValue(module, &HasLTurret::count, info->lTurretCount);
+    addPropertyValue(module, &HasMShield::count, info->mShieldCount);
+    addPropertyValue(module, &HasLShield::count, info->lShieldCount);
+}
+
+/**
+ * @brief		Parse component.
+ */
+void GameStationModules::parseComponent(
+    const QString& component,
+    ::std::shared_ptr<ComponentInfo>  info,
+    ::std::shared_ptr<StationModule>  module,
+    ::std::shared_ptr<GameVFS>        vfs,
+    ::std::shared_ptr<GameMacros>     macros,
+    ::std::shared_ptr<GameTexts>      texts,
+    ::std::shared_ptr<GameWares>      wares,
+    ::std::shared_ptr<GameComponents> components)
 {
     qDebug() << "Loading component" << component << "...";
     ::std::shared_ptr<GameVFS::FileReader> file
@@ -1228,7 +1713,7 @@ void GameStationModules::loadComponent(
     context->setOnStartElement(
         ::std::bind(&GameStationModules::onStartElementInRootOfModuleComponent,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
+            ::std::placeholders::_3, ::std::placeholders::_4, info, module));
     loader["vfs"] = vfs;
     loader["macros"] = macros;
     loader["texts"] = texts;
@@ -1245,6 +1730,7 @@ bool GameStationModules::onStartElementInRootOfModuleComponent(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>&,
+    ::std::shared_ptr<ComponentInfo> info,
     ::std::shared_ptr<StationModule> module)
 {
     ::std::unique_ptr<XMLLoader::Context> context
@@ -1254,7 +1740,7 @@ bool GameStationModules::onStartElementInRootOfModuleComponent(
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInComponentsOfModuleComponent,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
+            ::std::placeholders::_3, ::std::placeholders::_4, info, module));
     }
 
     loader.pushContext(::std::move(context));
@@ -1269,6 +1755,7 @@ bool GameStationModules::onStartElementInComponentsOfModuleComponent(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>&,
+    ::std::shared_ptr<ComponentInfo> info,
     ::std::shared_ptr<StationModule> module)
 {
     ::std::unique_ptr<XMLLoader::Context> context
@@ -1278,7 +1765,7 @@ bool GameStationModules::onStartElementInComponentsOfModuleComponent(
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInComponentOfModuleComponent,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
+            ::std::placeholders::_3, ::std::placeholders::_4, info, module));
     }
 
     loader.pushContext(::std::move(context));
@@ -1293,22 +1780,26 @@ bool GameStationModules::onStartElementInComponentOfModuleComponent(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>&,
+    ::std::shared_ptr<ComponentInfo> info,
     ::std::shared_ptr<StationModule> module)
 {
     ::std::unique_ptr<XMLLoader::Context> context
         = XMLLoader::Context::create();
 
     if (name == "properties") {
+        if (info != nullptr) {
+            info->hasProperties = true;
+        }
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInPropertiesOfModuleMacro, this,
             ::std::placeholders::_1, ::std::placeholders::_2,
             ::std::placeholders::_3, ::std::placeholders::_4, module));
     }
-    else if (name == "connections") {
+    else if (name == "connections" && info != nullptr) {
         context->setOnStartElement(::std::bind(
             &GameStationModules::onStartElementInConnectionsOfModuleComponent,
             this, ::std::placeholders::_1, ::std::placeholders::_2,
-            ::std::placeholders::_3, ::std::placeholders::_4, module));
+            ::std::placeholders::_3, ::std::placeholders::_4, info));
     }
 
     loader.pushContext(::std::move(context));
@@ -1323,7 +1814,7 @@ bool GameStationModules::onStartElementInConnectionsOfModuleComponent(
     XMLLoader::Context&,
     const QString& name,
     const QMap<QString, QString>& attr,
-    ::std::shared_ptr<StationModule> module)
+    ::std::shared_ptr<ComponentInfo> info)
 {
     ::std::unique_ptr<XMLLoader::Context> context
         = XMLLoader::Context::create();
@@ -1354,69 +1845,21 @@ bool GameStationModules::onStartElementInConnectionsOfModuleComponent(
             if (foundTurret) {
                 if (foundMedium) {
                     // M turret.
-                    ::std::shared_ptr<HasMTurret> property;
-                    auto                          iter1
-                        = module->properties.find(Property::Type::MTurret);
-                    if (iter1 == module->properties.end()) {
-                        property
-                            = ::std::shared_ptr<HasMTurret>(new HasMTurret);
-                        module->properties[property->type] = property;
-                    }
-                    else {
-                        property
-                            = ::std::static_pointer_cast<HasMTurret>(*iter1);
-                    }
-                    ++(property->count);
+                    ++(info->mTurretCount);
                 }
                 else if (foundLarge) {
                     // L turret.
-                    ::std::shared_ptr<HasLTurret> property;
-                    auto                          iter2
-                        = module->properties.find(Property::Type::LTurret);
-                    if (iter2 == module->properties.end()) {
-                        property
-                            = ::std::shared_ptr<HasLTurret>(new HasLTurret);
-                        module->properties[property->type] = property;
-                    }
-                    else {
-                        property
-                            = ::std::static_pointer_cast<HasLTurret>(*iter2);
-                    }
-                    ++(property->count);
+                    ++(info->lTurretCount);
                 }
             }
             else if (foundLarge) {
                 if (foundMedium) {
                     // M shield.
-                    ::std::shared_ptr<HasMShield> property;
-                    auto                          iter3
-                        = module->properties.find(Property::Type::MShield);
-                    if (iter3 == module->properties.end()) {
-                        property
-                            = ::std::shared_ptr<HasMShield>(new HasMShield);
-                        module->properties[property->type] = property;
-                    }
-                    else {
-                        property
-                            = ::std::static_pointer_cast<HasMShield>(*iter3);
-                    }
-                    ++(property->count);
+                    ++(info->mShieldCount);
                 }
                 else {
                     // L shield.
-                    ::std::shared_ptr<HasLShield> property;
-                    auto                          iter4
-                        = module->properties.find(Property::Type::LShield);
-                    if (iter4 == module->properties.end()) {
-                        property
-                            = ::std::shared_ptr<HasLShield>(new HasLShield);
-                        module->properties[property->type] = property;
-                    }
-                    else {
-                        property
-                            = ::std::static_pointer_cast<HasLShield>(*iter4);
-                    }
-                    ++(property->count);
+                    ++(info->lShieldCount);
                 }
             }
         }
@@ -71,6 +71,7 @@ GameTexts::GameTexts(::std::shared_ptr<GameVFS>             vfs,
 
             // Load file
             qDebug() << "Loading file" << *fileIter << ".";
+            Trace::Scope scope(*fileIter);
 
             // Open
             ::std::shared_ptr<GameVFS::FileReader> fileReader
@@ -99,31 +100,104 @@ GameTexts::GameTexts(::std::shared_ptr<GameVFS>             vfs,
     this->setInitialized();
 }
 
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameTexts::GameTexts(QDataStream &stream) : m_unknowIndex(0)
+{
+    qint32  unknowIndex = 0;
+    quint32 pageCount   = 0;
+    stream >> unknowIndex >> pageCount;
+    m_unknowIndex = unknowIndex;
+
+    for (quint32 i = 0; i < pageCount && stream.status() == QDataStream::Ok;
+         ++i) {
+        ::std::shared_ptr<TextPage> page(new TextPage);
+        quint32                     textCount = 0;
+        stream >> page->pageID >> textCount;
+
+        for (quint32 j = 0;
+             j < textCount && stream.status() == QDataStream::Ok; ++j) {
+            ::std::shared_ptr<Text> text(new Text);
+            quint32                 languageCount = 0;
+            text->pageID                          = page->pageID;
+            stream >> text->textID >> languageCount;
+
+            for (quint32 k = 0;
+                 k < languageCount && stream.status() == QDataStream::Ok;
+                 ++k) {
+                quint32           languageID = 0;
+                quint32           linkCount  = 0;
+                QVector<TextLink> links;
+                stream >> languageID >> linkCount;
+
+                for (quint32 l = 0;
+                     l < linkCount && stream.status() == QDataStream::Ok;
+                     ++l) {
+                    TextLink link;
+                    stream >> link.isRef >> link.text >> link.refInfo.pageID
+                        >> link.refInfo.textID;
+                    links.push_back(::std::move(link));
+                }
+                text->links[languageID] = ::std::move(links);
+            }
+            page->texts[text->textID] = text;
+        }
+        m_textPages[page->pageID] = page;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    this->setInitialized();
+}
+
 /**
  * @brief		Get text.
  */
 QString GameTexts::text(qint32 pageID, qint32 textID)
 {
-    QString ret      = "";
-    auto    pageIter = m_textPages.find(pageID);
-    if (pageIter == m_textPages.end()) {
-        return "";
-    }
-    auto textIter = (*pageIter)->texts.find(textID);
-    if (textIter == (*pageIter)->texts.end()) {
-        return "";
+    QString ret = "";
+
+    // Get page.
+    ::std::shared_ptr<TextPage> page;
+    {
+        QMutexLocker locker(&m_pageLock);
+        auto         pageIter = m_textPages.find(pageID);
+        if (pageIter == m_textPages.end()) {
+            return "";
+        }
+        page = *pageIter;
     }
 
-    auto linkIter
-        = (*textIter)->links.find(StringTable::instance()->languageId());
-    if (linkIter == (*textIter)->links.end()) {
-        linkIter = (*textIter)->links.find(44);
-        if (linkIter == (*textIter)->links.end()) {
+    // Get text.
+    ::std::shared_ptr<Text> text;
+    {
+        QMutexLocker locker(&(page->lock));
+        auto         textIter = page->texts.find(textID);
+        if (textIter == page->texts.end()) {
             return "";
         }
+        text = *textIter;
+    }
+
+    // Get links.
+    QVector<TextLink> links;
+    {
+        QMutexLocker locker(&(text->lock));
+        auto         linkIter
+            = text->links.find(StringTable::instance()->languageId());
+        if (linkIter == text->links.end()) {
+            linkIter = text->links.find(44);
+            if (linkIter == text->links.end()) {
+                return "";
+            }
+        }
+        links = *linkIter;
     }
 
-    for (auto &link : *linkIter) {
+    for (auto &link : links) {
         if (link.isRef) {
             ret.append(this->text(link.refInfo.pageID, link.refInfo.textID));
         } else {
@@ -176,6 +250,35 @@ GameTexts::IDPair GameTexts::addText(const QString &str)
     return IDPair(static_cast<qint32>(-1), id);
 }
 
+/**
+ * @brief		Write snapshot.
+ */
+void GameTexts::saveSnapshot(QDataStream &stream)
+{
+    QMutexLocker pageLocker(&m_pageLock);
+    stream << static_cast<qint32>(m_unknowIndex.loadAcquire())
+           << static_cast<quint32>(m_textPages.size());
+
+    for (auto &page : m_textPages) {
+        QMutexLocker textLocker(&(page->lock));
+        stream << page->pageID << static_cast<quint32>(page->texts.size());
+
+        for (auto &text : page->texts) {
+            QMutexLocker linkLocker(&(text->lock));
+            stream << text->textID << static_cast<quint32>(text->links.size());
+
+            for (auto iter = text->links.begin(); iter != text->links.end();
+                 ++iter) {
+                stream << iter.key() << static_cast<quint32>(iter->size());
+                for (auto &link : *iter) {
+                    stream << link.isRef << link.text << link.refInfo.pageID
+                           << link.refInfo.textID;
+                }
+            }
+        }
+    }
+}
+
 /**
  * @brief		Destructor.
  */
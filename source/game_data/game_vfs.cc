@@ -4,7 +4,9 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QWriteLocker>
 
 #include <common.h>
@@ -25,7 +27,8 @@ GameVFS::GameVFS(const QString &                        gamePath,
 
     // Load cat/dat files.
     for (auto &catDatInfo : info) {
-        QFile catFile(dir.absoluteFilePath(catDatInfo.cat));
+        Trace::Scope scope(catDatInfo.cat);
+        QFile        catFile(dir.absoluteFilePath(catDatInfo.cat));
         if (! catFile.open(QIODevice::OpenModeFlag::ReadOnly
                            | QIODevice::OpenModeFlag::ExistingOnly)) {
             qDebug() << "Failed to open file :" << catFile.fileName() << ".";
@@ -313,6 +316,71 @@ GameVFS::GameVFS(const QString &                        gamePath,
         new DirReader(path, entry, m_this.lock()));
 }
 
+/**
+ * @brief		Compute fingerprint of files.
+ */
+QByteArray GameVFS::fingerprint(const QStringList &paths)
+{
+    QCryptographicHash hash(QCryptographicHash::Algorithm::Sha1);
+    QDir               root(m_gamePath);
+
+    for (auto &path : paths) {
+        hash.addData(path.toUtf8());
+
+        // Normal files.
+        QFileInfo info(root.absoluteFilePath(path));
+        if (info.isFile()) {
+            hash.addData(QByteArray::number(info.size()));
+            hash.addData(
+                QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        } else if (info.isDir()) {
+            QDirIterator iter(info.absoluteFilePath(), QDir::Filter::Files,
+                              QDirIterator::IteratorFlag::Subdirectories);
+            QStringList  files;
+            while (iter.hasNext()) {
+                files.append(iter.next());
+            }
+            files.sort();
+            for (auto &file : files) {
+                QFileInfo fileInfo(file);
+                hash.addData(root.relativeFilePath(file).toUtf8());
+                hash.addData(QByteArray::number(fileInfo.size()));
+                hash.addData(QByteArray::number(
+                    fileInfo.lastModified().toMSecsSinceEpoch()));
+            }
+        }
+
+        // Packed files.
+        ::std::shared_ptr<DatFileEntery> entry = m_datEntry;
+        for (auto &name :
+             path.split('/', Qt::SplitBehaviorFlags::SkipEmptyParts)) {
+            if (entry == nullptr || ! entry->isDirectory) {
+                entry = nullptr;
+                break;
+            }
+
+            auto pathIter = entry->children.find(name);
+            if (pathIter == entry->children.end()) {
+                ::std::shared_ptr<DatFileEntery> found = nullptr;
+                for (auto &key : entry->children.keys()) {
+                    if (key.toLower() == name.toLower()) {
+                        found = entry->children[key];
+                        break;
+                    }
+                }
+                entry = found;
+            } else {
+                entry = *pathIter;
+            }
+        }
+        if (entry != nullptr) {
+            this->addFingerprint(hash, path, entry);
+        }
+    }
+
+    return hash.result();
+}
+
 /**
  * @brief	Destructor.
  */
@@ -854,3 +922,23 @@ bool GameVFS::DirReader::Iterator::operator!=(const Iterator &iter) const
 {
     return m_iterator != iter.m_iterator;
 }
+
+/**
+ * @brief		Add packed files to fingerprint.
+ */
+void GameVFS::addFingerprint(QCryptographicHash &                    hash,
+                             const QString &                         path,
+                             const ::std::shared_ptr<DatFileEntery> &entry)
+{
+    if (entry->isDirectory) {
+        for (auto iter = entry->children.begin();
+             iter != entry->children.end(); ++iter) {
+            this->addFingerprint(hash, path + "/" + iter.key(), *iter);
+        }
+    } else {
+        hash.addData(path.toUtf8());
+        hash.addData(entry->fileInfo.datName.toUtf8());
+        hash.addData(QByteArray::number(entry->fileInfo.size));
+        hash.addData(entry->fileInfo.hash.toUtf8());
+    }
+}
@@ -0,0 +1,145 @@
+#include <game_data/game_ware_graph.h>
+
+/**
+ * @brief		Constructor.
+ */
+GameWareGraph::GameWareGraph(
+    const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+        &modules)
+{
+    // Ware IDs, in the order of first use.
+    for (const auto &module : modules) {
+        for (const auto &rates : {module->products, module->resources}) {
+            for (const auto &rate : rates) {
+                if (! m_ids.contains(rate.ware)) {
+                    m_ids[rate.ware] = static_cast<quint32>(m_wares.size());
+                    m_wares.append(rate.ware);
+                }
+            }
+        }
+    }
+
+    this->buildEdges(modules, true, m_producerOffsets, m_producers);
+    this->buildEdges(modules, false, m_consumerOffsets, m_consumers);
+
+    // Production methods.
+    m_methods.resize(m_wares.size());
+    for (const auto &module : modules) {
+        auto iter = module->properties.find(
+            GameStationModules::Property::Type::SupplyProduct);
+        if (iter == module->properties.end()) {
+            continue;
+        }
+        auto &productionInfo
+            = ::std::static_pointer_cast<GameStationModules::SupplyProduct>(
+                  *iter)
+                  ->productionInfo;
+        auto idIter = m_ids.find(productionInfo->id);
+        if (idIter != m_ids.end()
+            && ! m_methods[*idIter].contains(productionInfo->method)) {
+            m_methods[*idIter].append(productionInfo->method);
+        }
+    }
+}
+
+/**
+ * @brief		Get number of wares.
+ */
+quint32 GameWareGraph::size() const
+{
+    return static_cast<quint32>(m_wares.size());
+}
+
+/**
+ * @brief		Get ID of ware.
+ */
+qint64 GameWareGraph::id(const QString &ware) const
+{
+    auto iter = m_ids.find(ware);
+    if (iter == m_ids.end()) {
+        return -1;
+    }
+
+    return *iter;
+}
+
+/**
+ * @brief		Get ware.
+ */
+const QString &GameWareGraph::ware(quint32 id) const
+{
+    return m_wares[id];
+}
+
+/**
+ * @brief		Get modules which produce a ware.
+ */
+GameWareGraph::IDRange GameWareGraph::producers(quint32 id) const
+{
+    return IDRange(m_producers.constData() + m_producerOffsets[id],
+                   m_producers.constData() + m_producerOffsets[id + 1]);
+}
+
+/**
+ * @brief		Get modules which consume a ware.
+ */
+GameWareGraph::IDRange GameWareGraph::consumers(quint32 id) const
+{
+    return IDRange(m_consumers.constData() + m_consumerOffsets[id],
+                   m_consumers.constData() + m_consumerOffsets[id + 1]);
+}
+
+/**
+ * @brief		Get production methods of a ware used by modules.
+ */
+const QStringList &GameWareGraph::methods(quint32 id) const
+{
+    return m_methods[id];
+}
+
+/**
+ * @brief		Build offsets and edges of modules.
+ */
+void GameWareGraph::buildEdges(
+    const QVector<::std::shared_ptr<GameStationModules::StationModule>>
+        &             modules,
+    bool              products,
+    QVector<quint32> &offsets,
+    QVector<quint32> &edges)
+{
+    // A module may list a ware more than once, its edges are contiguous as
+    // modules are visited in order.
+    QVector<quint32> next;
+    QVector<qint64>  last;
+    auto             visit = [&](bool fill) -> void {
+        last.fill(-1, m_wares.size());
+        for (quint32 id = 0; id < static_cast<quint32>(modules.size()); ++id) {
+            const auto &module = modules[id];
+            for (const auto &rate :
+                 products ? module->products : module->resources) {
+                quint32 ware = m_ids[rate.ware];
+                if (last[ware] == id) {
+                    continue;
+                }
+                last[ware] = id;
+                if (fill) {
+                    edges[next[ware]++] = id;
+                } else {
+                    ++offsets[ware + 1];
+                }
+            }
+        }
+    };
+
+    // Count edges of each ware.
+    offsets.fill(0, m_wares.size() + 1);
+    visit(false);
+    for (int i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Fill edges.
+    next = QVector<quint32>(offsets.begin(), offsets.end() - 1);
+    edges.resize(offsets.back());
+    visit(true);
+}
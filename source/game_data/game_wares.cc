@@ -1,4 +1,5 @@
 #include <QtCore/QDebug>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QRegularExpression>
 
 #include <game_data/game_data.h>
@@ -86,6 +87,55 @@ GameWares::GameWares(::std::shared_ptr<GameVFS>             vfs,
     this->setInitialized();
 }
 
+/**
+ * @brief		Constructor, load from snapshot.
+ */
+GameWares::GameWares(QDataStream &stream) :
+    m_unknowWareIndex(0), m_unknowWareGroupIndex(0)
+{
+    qint32  unknowWareIndex      = 0;
+    qint32  unknowWareGroupIndex = 0;
+    quint32 count                = 0;
+    stream >> unknowWareIndex >> unknowWareGroupIndex;
+    m_unknowWareIndex      = unknowWareIndex;
+    m_unknowWareGroupIndex = unknowWareGroupIndex;
+
+    // Ware groups.
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ::std::shared_ptr<WareGroup> group(new WareGroup);
+        stream >> group->id >> group->name >> group->tags;
+        m_wareGroups[group->id] = group;
+    }
+
+    // Wares.
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ::std::shared_ptr<Ware> ware(new Ware);
+        qint32                  transportType   = 0;
+        quint32                 productionCount = 0;
+        stream >> ware->id >> ware->name >> ware->description >> ware->group
+            >> transportType >> ware->volume >> ware->tags >> ware->minPrice
+            >> ware->averagePrice >> ware->maxPrice >> productionCount;
+        ware->transportType = static_cast<TransportType>(transportType);
+
+        for (quint32 j = 0;
+             j < productionCount && stream.status() == QDataStream::Ok; ++j) {
+            QString                           method;
+            ::std::shared_ptr<ProductionInfo> info(new ProductionInfo);
+            stream >> method >> *info;
+            ware->productionInfos[method] = info;
+        }
+        m_wares[ware->id] = ware;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    this->setInitialized();
+}
+
 /**
  * @brief	Get ware group information.
  */
@@ -96,7 +146,8 @@ GameWares::GameWares(::std::shared_ptr<GameVFS>             vfs,
         texts = GameData::instance()->texts();
     }
 
-    auto iter = m_wareGroups.find(id);
+    QMutexLocker locker(&m_lock);
+    auto         iter = m_wareGroups.find(id);
     if (iter == m_wareGroups.end()) {
         ::std::shared_ptr<GameWares::WareGroup> unknowWareGroup(new WareGroup(
             {id,
@@ -122,7 +173,8 @@ GameWares::GameWares(::std::shared_ptr<GameVFS>             vfs,
         texts = GameData::instance()->texts();
     }
 
-    auto iter = m_wares.find(id);
+    QMutexLocker locker(&m_lock);
+    auto         iter = m_wares.find(id);
     if (iter == m_wares.end()) {
         // Generate an unknow ware.
         ::std::shared_ptr<GameWares::Ware> unknowWare(new Ware(
@@ -146,6 +198,37 @@ GameWares::GameWares(::std::shared_ptr<GameVFS>             vfs,
     }
 }
 
+/**
+ * @brief		Write snapshot.
+ */
+void GameWares::saveSnapshot(QDataStream &stream)
+{
+    QMutexLocker locker(&m_lock);
+    stream << static_cast<qint32>(m_unknowWareIndex.loadAcquire())
+           << static_cast<qint32>(m_unknowWareGroupIndex.loadAcquire());
+
+    // Ware groups.
+    stream << static_cast<quint32>(m_wareGroups.size());
+    for (auto &group : m_wareGroups) {
+        stream << group->id << group->name << group->tags;
+    }
+
+    // Wares.
+    stream << static_cast<quint32>(m_wares.size());
+    for (auto &ware : m_wares) {
+        stream << ware->id << ware->name << ware->description << ware->group
+               << static_cast<qint32>(ware->transportType) << ware->volume
+               << ware->tags << ware->minPrice << ware->averagePrice
+               << ware->maxPrice
+               << static_cast<quint32>(ware->productionInfos.size());
+
+        for (auto iter = ware->productionInfos.begin();
+             iter != ware->productionInfos.end(); ++iter) {
+            stream << iter.key() << **iter;
+        }
+    }
+}
+
 /**
  * @brief		Destructor.
  */
@@ -589,3 +672,37 @@ bool GameWares::onStartElementInExtensionDiff(
     loader.pushContext(::std::move(context));
     return true;
 }
+
+/**
+ * @brief		Write production information to stream.
+ */
+QDataStream &operator<<(QDataStream &                     stream,
+                        const GameWares::ProductionInfo &info)
+{
+    stream << info.id << info.time << info.amount << info.method
+           << info.workEffect << static_cast<quint32>(info.resources.size());
+    for (auto &resource : info.resources) {
+        stream << resource->id << resource->amount;
+    }
+
+    return stream;
+}
+
+/**
+ * @brief		Read production information from stream.
+ */
+QDataStream &operator>>(QDataStream &stream, GameWares::ProductionInfo &info)
+{
+    quint32 count = 0;
+    stream >> info.id >> info.time >> info.amount >> info.method
+        >> info.workEffect >> count;
+    info.resources.clear();
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ::std::shared_ptr<GameWares::Resource> resource(
+            new GameWares::Resource);
+        stream >> resource->id >> resource->amount;
+        info.resources[resource->id] = resource;
+    }
+
+    return stream;
+}
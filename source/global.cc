@@ -4,13 +4,14 @@
 #include <sstream>
 #include <vector>
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
-#include <QtWidgets/QApplication>
 
 #include <getopt.h>
 
+#include <common/trace.h>
 #include <global.h>
 
 /**
@@ -25,6 +26,13 @@ Global::Global(int &argc, char **&argv, int &exitCode)
                          this->showHelp(argv[0]);
                          return false;
                      }};
+    m_argMap['t'] = {"t:", "trace-startup",
+                     "Write trace of startup to file in Chrome trace format.",
+                     [&]() -> bool {
+                         m_traceStartupPath = QDir(optarg).absolutePath();
+                         Trace::enable();
+                         return true;
+                     }};
 
     if (! this->parseArgs(argc, argv, exitCode)) {
         return;
@@ -38,7 +46,7 @@ Global::Global(int &argc, char **&argv, int &exitCode)
     }
 
     // Path of current file.
-    m_execDir = QDir(QApplication::applicationDirPath()).absolutePath();
+    m_execDir = QDir(QCoreApplication::applicationDirPath()).absolutePath();
     qDebug() << "Tool dir : " << m_execDir << ".";
 
     // Path of config file
@@ -49,6 +57,8 @@ Global::Global(int &argc, char **&argv, int &exitCode)
     }
     m_configPath = configDir.absoluteFilePath(".config");
     qDebug() << "Path of config file : " << m_configPath;
+    m_snapshotPath = configDir.absoluteFilePath("game_data.snapshot");
+    qDebug() << "Path of game data snapshot : " << m_snapshotPath;
 
     this->setInitialized();
 }
@@ -69,6 +79,22 @@ const QString &Global::configPath() const
     return m_configPath;
 }
 
+/**
+ * @brief       Get path of game data snapshot.
+ */
+const QString &Global::snapshotPath() const
+{
+    return m_snapshotPath;
+}
+
+/**
+ * @brief       Get path of startup trace file.
+ */
+const QString &Global::traceStartupPath() const
+{
+    return m_traceStartupPath;
+}
+
 /**
  * @brief       Check if there is a file to open.
  */
@@ -15,6 +15,7 @@
 #include <ui/language_setting_dialog.h>
 #include <ui/license_dialog.h>
 #include <ui/main_window/main_window.h>
+#include <ui/splash/splash_loading_sink.h>
 #include <ui/splash/splash_widget.h>
 
 #if QT_VERSION_MAJOR>=6
@@ -154,10 +155,12 @@ int main(int argc, char *argv[])
     }
 
     // Show splash and load data.
-    SplashWidget splash;
-    int          ret = splash.exec([&]() -> int {
+    SplashWidget      splash;
+    SplashLoadingSink splashSink(&splash);
+    int               ret = splash.exec([&]() -> int {
         // Load game data.
-        if (GameData::initialize(&splash) == nullptr) {
+        Trace::Scope scope("GameData");
+        if (GameData::initialize(&splashSink) == nullptr) {
             return 1;
         } else {
             return 0;
@@ -166,10 +169,21 @@ int main(int argc, char *argv[])
     if (ret != 0) {
         return ret;
     }
+    GameData::instance()->enableHotReload();
 
     // Show main window.
+    ::std::unique_ptr<Trace::Scope> mainWindowScope(
+        new Trace::Scope("MainWindow"));
     MainWindow mainWindow;
     mainWindow.show();
+    mainWindowScope = nullptr;
+
+    if (! Global::instance()->traceStartupPath().isEmpty()) {
+        Trace::save(Global::instance()->traceStartupPath());
+    }
+
+    // Only startup is traced.
+    Trace::disable();
 
     return app.exec();
 }
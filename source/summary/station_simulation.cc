@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <limits>
+
+#include <summary/station_simulation.h>
+
+/**
+ * @brief		Constructor.
+ */
+StationSimulation::StationSimulation(
+    ::std::shared_ptr<GameStationModuleTable> table,
+    ::std::shared_ptr<GameWares>              wares,
+    const QVector<QPair<QString, quint64>> &  modules)
+{
+    typedef GameStationModules::StationModule StationModule;
+
+    // Count modules.
+    QVector<quint32> weights = table->makeWeights();
+    for (const auto &module : modules) {
+        qint64 id = table->id(module.first);
+        if (id >= 0) {
+            weights[id] += static_cast<quint32>(module.second);
+        }
+    }
+
+    // Storage and workforce.
+    auto sums           = table->sum(weights);
+    m_capacity[0]       = sums[StationModule::ContainerCargoSize];
+    m_capacity[1]       = sums[StationModule::SolidCargoSize];
+    m_capacity[2]       = sums[StationModule::LiquidCargoSize];
+    m_requiredWorkforce = sums[StationModule::RequireWorkforceAmount];
+    m_workforceCapacity = sums[StationModule::SupplyWorkforceAmount];
+
+    // Lines.
+    for (quint32 id = 0; id < table->size(); ++id) {
+        auto module = table->module(id);
+        if (weights[id] == 0
+            || (module->products.empty() && module->resources.empty())) {
+            continue;
+        }
+
+        Line line;
+        line.workforce
+            = module->counters[StationModule::SupplyWorkforceAmount]
+              * weights[id];
+        line.scaling  = line.workforce > 0 ? Scaling::Occupancy
+                                           : Scaling::Efficiency;
+        line.products = m_flows.size();
+        this->addFlows(module->products, weights[id], wares);
+        line.resources = m_flows.size();
+        this->addFlows(module->resources, weights[id], wares);
+        line.end = m_flows.size();
+        m_lines.append(line);
+    }
+}
+
+/**
+ * @brief		Run simulation.
+ */
+StationSimulation::Result
+    StationSimulation::run(const StationSimulation::Options &options) const
+{
+    const qint64 scale     = Rate::Scale;
+    const qint64 unlimited = ::std::numeric_limits<qint64>::max();
+    const int    count     = m_wares.size();
+    const qint64 step      = ::std::max<qint64>(options.step, 1);
+    const qint64 steps     = ::std::max<qint64>(options.duration, 0) / step;
+    const qint64 sampleSteps
+        = ::std::max<qint64>(options.sampleInterval / step, 1);
+
+    // State, amounts are in 1/Rate::Scale units.
+    QVector<qint64>          stock(count, 0);
+    ::std::array<qint64, 3>  used     = {0, 0, 0};
+    ::std::array<qint64, 3>  capacity = {};
+    qint64                   workforce;
+    const qint64             workforceCapacity = m_workforceCapacity * scale;
+    for (int type = 0; type < 3; ++type) {
+        capacity[type] = static_cast<qint64>(m_capacity[type]) * scale;
+    }
+
+    // Flows of each step.
+    QVector<qint64> flowMin(m_flows.size());
+    QVector<qint64> flowDelta(m_flows.size());
+    for (int i = 0; i < m_flows.size(); ++i) {
+        flowMin[i]   = m_flows[i].min.scaled(step, 3600).raw();
+        flowDelta[i] = m_flows[i].max.scaled(step, 3600).raw() - flowMin[i];
+    }
+    QVector<qint64> supply(count, 0);
+    QVector<qint64> demand(count, 0);
+    for (auto iter = options.supply.begin(); iter != options.supply.end();
+         ++iter) {
+        auto index = m_index.find(iter.key());
+        if (index != m_index.end()) {
+            supply[*index] = iter->scaled(step, 3600).raw();
+        }
+    }
+    for (auto iter = options.demand.begin(); iter != options.demand.end();
+         ++iter) {
+        auto index = m_index.find(iter.key());
+        if (index != m_index.end()) {
+            demand[*index] = iter->scaled(step, 3600).raw();
+        }
+    }
+    const qint64 workforceGrowth = static_cast<qint64>(m_workforceCapacity)
+                                   * options.workforceGrowth * step / 3600;
+
+    // Storage.
+    auto freeSpace = [&](int ware) -> qint64 {
+        int type = m_types[ware];
+        return type < 0 ? unlimited
+                        : (capacity[type] - used[type]) / m_volumes[ware];
+    };
+    auto store = [&](int ware, qint64 amount) -> void {
+        stock[ware] += amount;
+        if (m_types[ware] >= 0) {
+            used[m_types[ware]] += amount * m_volumes[ware];
+        }
+    };
+
+    // Initial state.
+    for (auto iter = options.stock.begin(); iter != options.stock.end();
+         ++iter) {
+        auto index = m_index.find(iter.key());
+        if (index != m_index.end()) {
+            store(*index, ::std::min(static_cast<qint64>(*iter) * scale,
+                                     freeSpace(*index)));
+        }
+    }
+    workforce = ::std::min(static_cast<qint64>(options.workforce) * scale,
+                           workforceCapacity);
+
+    // Result.
+    Result result;
+    result.wares = m_wares;
+    result.stock.resize(count);
+    result.fullTime.fill(-1, count);
+    result.emptyTime.fill(-1, count);
+    for (int type = 0; type < 3; ++type) {
+        result.storageCapacity[type] = m_capacity[type];
+    }
+    auto sample = [&](qint64 time) -> void {
+        result.times.append(time);
+        result.workforce.append(static_cast<quint64>(workforce / scale));
+        for (int ware = 0; ware < count; ++ware) {
+            result.stock[ware].append(
+                static_cast<quint64>(stock[ware] / scale));
+        }
+        for (int type = 0; type < 3; ++type) {
+            result.storage[type].append(
+                static_cast<quint64>(used[type] / scale));
+        }
+    };
+    auto markFull = [&](int ware, qint64 time) -> void {
+        if (result.fullTime[ware] < 0) {
+            result.fullTime[ware] = time;
+        }
+    };
+    auto markEmpty = [&](int ware, qint64 time) -> void {
+        if (result.emptyTime[ware] < 0) {
+            result.emptyTime[ware] = time;
+        }
+    };
+
+    sample(0);
+    for (qint64 s = 0; s < steps; ++s) {
+        qint64 time = s * step;
+
+        // Supply.
+        if (options.supplyStop < 0 || time < options.supplyStop) {
+            for (int ware = 0; ware < count; ++ware) {
+                if (supply[ware] > 0) {
+                    qint64 space = freeSpace(ware);
+                    if (space < supply[ware]) {
+                        markFull(ware, time);
+                    }
+                    store(ware, ::std::min(supply[ware], space));
+                }
+            }
+        }
+
+        // Lines.
+        qint64 efficiency
+            = m_requiredWorkforce == 0
+                  ? 0
+                  : ::std::min<qint64>(workforce / m_requiredWorkforce,
+                                       scale);
+        qint64 occupancy
+            = m_workforceCapacity == 0
+                  ? 0
+                  : ::std::min<qint64>(workforce / m_workforceCapacity,
+                                       scale);
+        qint64 supplied = 0;
+        for (const Line &line : m_lines) {
+            qint64 factor
+                = line.scaling == Scaling::Occupancy ? occupancy : efficiency;
+
+            // Part of the step the line can run, in 1/Rate::Scale.
+            qint64 part = scale;
+            for (int i = line.products; i < line.resources; ++i) {
+                qint64 amount = flowMin[i] + flowDelta[i] * factor / scale;
+                qint64 space  = freeSpace(m_flows[i].ware);
+                if (amount > 0 && space < amount) {
+                    markFull(m_flows[i].ware, time);
+                    part = ::std::min(part, space * scale / amount);
+                }
+            }
+            for (int i = line.resources; i < line.end; ++i) {
+                qint64 amount = flowMin[i] + flowDelta[i] * factor / scale;
+                qint64 left   = stock[m_flows[i].ware];
+                if (amount > 0 && left < amount) {
+                    markEmpty(m_flows[i].ware, time);
+                    part = ::std::min(part, left * scale / amount);
+                }
+            }
+
+            // Run.
+            for (int i = line.resources; i < line.end; ++i) {
+                qint64 amount = flowMin[i] + flowDelta[i] * factor / scale;
+                store(m_flows[i].ware, -(amount * part / scale));
+            }
+            for (int i = line.products; i < line.resources; ++i) {
+                qint64 amount = flowMin[i] + flowDelta[i] * factor / scale;
+                store(m_flows[i].ware, amount * part / scale);
+            }
+            supplied += static_cast<qint64>(line.workforce) * part;
+        }
+
+        // Demand.
+        for (int ware = 0; ware < count; ++ware) {
+            if (demand[ware] > 0) {
+                if (stock[ware] < demand[ware]) {
+                    markEmpty(ware, time);
+                }
+                store(ware, -::std::min(demand[ware], stock[ware]));
+            }
+        }
+
+        // Workforce moves in if all habitations are supplied.
+        if (m_workforceCapacity > 0) {
+            supplied /= static_cast<qint64>(m_workforceCapacity);
+            if (supplied >= scale) {
+                workforce = ::std::min(workforce + workforceGrowth,
+                                       workforceCapacity);
+            } else {
+                workforce = ::std::max<qint64>(
+                    workforce - workforceGrowth * (scale - supplied) / scale,
+                    0);
+            }
+        }
+
+        if ((s + 1) % sampleSteps == 0 || s + 1 == steps) {
+            sample(time + step);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief		Destructor.
+ */
+StationSimulation::~StationSimulation() {}
+
+/**
+ * @brief		Get index of a ware, add the ware if not exists.
+ */
+int StationSimulation::wareIndex(const QString &              id,
+                                 ::std::shared_ptr<GameWares> wares)
+{
+    auto iter = m_index.find(id);
+    if (iter != m_index.end()) {
+        return *iter;
+    }
+
+    // Transport type and volume.
+    int    type   = -1;
+    qint64 volume = 0;
+    auto   ware   = wares->ware(id);
+    if (ware != nullptr && ware->volume > 0) {
+        volume = ware->volume;
+        switch (ware->transportType) {
+            case GameWares::TransportType::Container:
+                type = 0;
+                break;
+
+            case GameWares::TransportType::Solid:
+                type = 1;
+                break;
+
+            case GameWares::TransportType::Liquid:
+                type = 2;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    int index = m_wares.size();
+    m_wares.append(id);
+    m_index[id] = index;
+    m_types.append(type);
+    m_volumes.append(volume);
+
+    return index;
+}
+
+/**
+ * @brief		Add flows of a module to the flows.
+ */
+void StationSimulation::addFlows(
+    const QVector<GameStationModules::StationModule::WareRate> &rates,
+    quint64 amount, ::std::shared_ptr<GameWares> wares)
+{
+    for (const auto &rate : rates) {
+        m_flows.append({this->wareIndex(rate.ware, wares),
+                        rate.min * static_cast<qint64>(amount),
+                        rate.max * static_cast<qint64>(amount)});
+    }
+}
@@ -0,0 +1,452 @@
+#include <QtCore/QSet>
+
+#include <game_data/game_production_solver.h>
+#include <summary/station_summary.h>
+
+/**
+ * @brief		Constructor.
+ */
+StationSummary::StationSummary() : m_table(nullptr)
+{
+    m_sums.fill(0);
+}
+
+/**
+ * @brief		Rebuild sums.
+ */
+void StationSummary::reset(::std::shared_ptr<GameStationModuleTable> table,
+                           const QVector<QPair<QString, quint64>> &  modules)
+{
+    m_table   = table;
+    m_weights = m_table->makeWeights();
+    m_products.clear();
+    m_resources.clear();
+
+    // Count modules.
+    for (const auto &module : modules) {
+        qint64 id = m_table->id(module.first);
+        if (id >= 0) {
+            m_weights[id] += static_cast<quint32>(module.second);
+        }
+    }
+
+    // Sums.
+    m_sums = m_table->sum(m_weights);
+    for (quint32 id = 0; id < m_table->size(); ++id) {
+        if (m_weights[id] != 0) {
+            auto module = m_table->module(id);
+            addWareRates(m_products, module->products, m_weights[id]);
+            addWareRates(m_resources, module->resources, m_weights[id]);
+        }
+    }
+}
+
+/**
+ * @brief		Rebuild sums from a save.
+ */
+void StationSummary::reset(::std::shared_ptr<GameStationModuleTable> table,
+                           ::std::shared_ptr<Save>                   save)
+{
+    QVector<QPair<QString, quint64>> modules;
+    for (const auto &saveGroup : save->groups()) {
+        for (const auto &saveModule : saveGroup->modules()) {
+            modules.append({saveModule->module(), saveModule->amount()});
+        }
+    }
+
+    this->reset(table, modules);
+}
+
+/**
+ * @brief		Add modules to the sums.
+ */
+void StationSummary::add(const QString &macro, qint64 amount)
+{
+    if (m_table == nullptr) {
+        return;
+    }
+
+    qint64 id = m_table->id(macro);
+    if (id < 0 || amount == 0) {
+        return;
+    }
+
+    // Unsigned arithmetic wraps, so negative amounts work as well.
+    m_weights[id] += static_cast<quint32>(amount);
+    for (int attribute = 0; attribute < GameStationModuleTable::AttributeCount;
+         ++attribute) {
+        m_sums[attribute] += static_cast<quint64>(amount)
+                             * m_table->column(
+                                 static_cast<GameStationModuleTable::Attribute>(
+                                     attribute))[id];
+    }
+
+    auto module = m_table->module(id);
+    addWareRates(m_products, module->products, amount);
+    addWareRates(m_resources, module->resources, amount);
+}
+
+/**
+ * @brief		Make summary from the sums.
+ */
+StationSummary::Info StationSummary::make() const
+{
+    typedef GameStationModules::StationModule StationModule;
+    const GameStationModuleTable::Sums &sums = m_sums;
+    Info                                summary;
+
+    // Hull & explosion damage.
+    summary.hull            = sums[GameStationModuleTable::Hull];
+    summary.explosionDamage = sums[GameStationModuleTable::ExplosionDamage];
+
+    // Weapons.
+    summary.weapons.sLaunchTube = sums[StationModule::SLaunchTubeCount];
+    summary.weapons.mLaunchTube = sums[StationModule::MLaunchTubeCount];
+    summary.weapons.mTurret     = sums[StationModule::MTurretCount];
+    summary.weapons.lTurret     = sums[StationModule::LTurretCount];
+
+    // Shields.
+    summary.shields.mShield = sums[StationModule::MShieldCount];
+    summary.shields.lShield = sums[StationModule::LShieldCount];
+
+    // Storage.
+    summary.storage.container = sums[StationModule::ContainerCargoSize];
+    summary.storage.solid     = sums[StationModule::SolidCargoSize];
+    summary.storage.liquid    = sums[StationModule::LiquidCargoSize];
+
+    // Docking bays.
+    summary.dockingBay.sDock   = sums[StationModule::SDockCount];
+    summary.dockingBay.mDock   = sums[StationModule::MDockCount];
+    summary.dockingBay.lDock   = sums[StationModule::LDockCount];
+    summary.dockingBay.xlDock  = sums[StationModule::XLDockCount];
+    summary.dockingBay.lXLDock = sums[StationModule::LXLDockCount];
+
+    // Ship storage.
+    summary.shipStorage.sShipCargo = sums[StationModule::SShipCargoCapacity];
+    summary.shipStorage.mShipCargo = sums[StationModule::MShipCargoCapacity];
+
+    // Workforce.
+    summary.workforce = sums[StationModule::SupplyWorkforceAmount];
+    summary.surplusWorkforce
+        = (qint64)(sums[StationModule::SupplyWorkforceAmount])
+          - (qint64)(sums[StationModule::RequireWorkforceAmount]);
+
+    // Wares.
+    auto copyWares = [&](QMap<QString, Range<Rate>> &      dest,
+                         const QMap<QString, WareSummary> &wares) -> void {
+        for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
+            dest[iter.key()] = iter->range;
+
+            // Storage required by the ware.
+            switch (iter->transportType) {
+                case GameWares::TransportType::Container:
+                    // Container.
+                    summary.requirements.requireContainerStorage = true;
+                    break;
+
+                case GameWares::TransportType::Solid:
+                    // Solid.
+                    summary.requirements.requireSolidStorage = true;
+                    break;
+
+                case GameWares::TransportType::Liquid:
+                    // Liquid.
+                    summary.requirements.requireLiquidStorage = true;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    };
+    copyWares(summary.products, m_products);
+    copyWares(summary.resources, m_resources);
+
+    // Intermediates
+    for (auto macro : summary.products.keys()) {
+        if (summary.resources.find(macro) != summary.resources.end()) {
+            auto productRange  = summary.products[macro];
+            auto resourceRange = summary.resources[macro];
+            summary.intermediates[macro]
+                = Range<Rate>(productRange.min() - resourceRange.min(),
+                              productRange.max() - resourceRange.max());
+            summary.products.remove(macro);
+            summary.resources.remove(macro);
+        }
+    }
+
+    return summary;
+}
+
+/**
+ * @brief		Solve suggested amounts of modules.
+ */
+void StationSummary::solveSuggestedAmounts(Info &summary) const
+{
+    typedef GameStationModules::StationModule StationModule;
+    if (m_table == nullptr) {
+        return;
+    }
+
+    // Races of habitation modules in the station decide the share of
+    // workforce.
+    GameProductionSolver::Options options;
+    for (quint32 id = 0; id < m_table->size(); ++id) {
+        if (m_weights[id] == 0) {
+            continue;
+        }
+        auto    module = m_table->module(id);
+        quint64 workforce
+            = module->counters[StationModule::SupplyWorkforceAmount]
+              * m_weights[id];
+        if (workforce > 0) {
+            for (const auto &race : module->races) {
+                options.workforce[race] += workforce;
+            }
+        }
+    }
+    bool useWorkforce = ! options.workforce.empty();
+
+    // Products of the station are the targets, without them only the
+    // workforce and intermediates are corrected.
+    QMap<QString, Rate> targets;
+    for (auto iter = summary.products.begin(); iter != summary.products.end();
+         ++iter) {
+        Rate rate = useWorkforce ? iter->max() : iter->min();
+        if (rate > Rate()) {
+            targets[iter.key()] = rate;
+        }
+    }
+    if (targets.empty()) {
+        this->suggestCorrectedAmounts(summary);
+        return;
+    }
+
+    // The solver uses the largest habitation module of each race and the
+    // production module of each ware the station has the most of, the other
+    // modules keep their amounts.
+    QMap<QString, quint32> habitations;
+    QMap<QString, quint32> producers;
+    for (quint32 id = 0; id < m_table->size(); ++id) {
+        auto module = m_table->module(id);
+        if (m_weights[id] == 0 || ! module->playerModule) {
+            continue;
+        }
+
+        quint64 workforce
+            = module->counters[StationModule::SupplyWorkforceAmount];
+        if (workforce > 0) {
+            for (const auto &race : module->races) {
+                auto iter = habitations.find(race);
+                if (iter == habitations.end()
+                    || m_table->module(*iter)->counters
+                               [StationModule::SupplyWorkforceAmount]
+                           < workforce) {
+                    habitations[race] = id;
+                }
+            }
+        }
+
+        if (module->products.empty()
+            || ! module->properties.contains(
+                GameStationModules::Property::SupplyProduct)) {
+            continue;
+        }
+        const auto &product = module->products.front();
+        if ((useWorkforce ? product.max : product.min) <= Rate()) {
+            continue;
+        }
+        auto iter = producers.find(product.ware);
+        if (iter == producers.end() || m_weights[*iter] < m_weights[id]) {
+            producers[product.ware] = id;
+        }
+    }
+
+    QSet<quint32> solved;
+    for (quint32 id : habitations) {
+        solved.insert(id);
+    }
+    for (quint32 id : producers) {
+        solved.insert(id);
+    }
+
+    QVector<::std::shared_ptr<StationModule>> modules;
+    QMap<QString, qint64>                     amounts;
+    for (quint32 id = 0; id < m_table->size(); ++id) {
+        if (m_weights[id] == 0) {
+            continue;
+        }
+        auto module = m_table->module(id);
+        if (solved.contains(id)) {
+            modules.push_back(module);
+            amounts[module->macro] += m_weights[id];
+            continue;
+        }
+
+        // Kept modules, habitation modules always consume at the maximum
+        // rates as in the solver.
+        qint64 amount = m_weights[id];
+        bool   maxRates
+            = useWorkforce
+              || module->moduleClass
+                     == StationModule::StationModuleClass::Habitation;
+        for (const auto &product : module->products) {
+            options.keptRates[product.ware]
+                += (maxRates ? product.max : product.min) * amount;
+        }
+        for (const auto &resource : module->resources) {
+            options.keptRates[resource.ware]
+                -= (maxRates ? resource.max : resource.min) * amount;
+        }
+        options.keptWorkforce
+            += (static_cast<qint64>(
+                    module->counters[StationModule::SupplyWorkforceAmount])
+                - static_cast<qint64>(
+                    module->counters[StationModule::RequireWorkforceAmount]))
+               * amount;
+    }
+
+    // Solve, only the modules used by the solver get suggestions.
+    GameProductionSolver solver(modules, options);
+    auto                 result = solver.solve(targets);
+    for (const auto &module : modules) {
+        qint64 amount
+            = static_cast<qint64>(result.modules.value(module->macro, 0))
+              - amounts[module->macro];
+        if (amount != 0) {
+            summary.suggestedAmounts[module->macro] = amount;
+        }
+    }
+}
+
+/**
+ * @brief		Suggest amounts which correct the workforce and
+ *				intermediates.
+ */
+void StationSummary::suggestCorrectedAmounts(Info &summary) const
+{
+    typedef GameStationModules::StationModule StationModule;
+
+    // Round surplus down and shortage up.
+    auto correction = [](qint64 surplus, qint64 capacity) -> qint64 {
+        return surplus > 0 ? -(surplus / capacity)
+                           : (-surplus + capacity - 1) / capacity;
+    };
+
+    for (quint32 id = 0; id < m_table->size(); ++id) {
+        if (m_weights[id] == 0) {
+            continue;
+        }
+        auto   module = m_table->module(id);
+        qint64 amount = 0;
+        switch (module->moduleClass) {
+            case StationModule::StationModuleClass::Habitation: {
+                qint64 workforce = static_cast<qint64>(
+                    module->counters[StationModule::SupplyWorkforceAmount]);
+                if (workforce > 0) {
+                    amount = correction(summary.surplusWorkforce, workforce);
+                }
+            } break;
+
+            case StationModule::StationModuleClass::Production: {
+                if (module->products.empty()) {
+                    break;
+                }
+                const auto &product = module->products.front();
+                auto iter = summary.intermediates.find(product.ware);
+                if (iter != summary.intermediates.end()
+                    && product.max > Rate()) {
+                    amount = correction(iter->max().raw(), product.max.raw());
+                }
+            } break;
+
+            default:
+                break;
+        }
+
+        if (amount != 0) {
+            summary.suggestedAmounts[module->macro] = amount;
+        }
+    }
+}
+
+/**
+ * @brief		Check summary.
+ */
+QStringList StationSummary::check(const Info &summary)
+{
+    QStringList warnings;
+    if (summary.surplusWorkforce < 0) {
+        warnings.append("STR_EDITOR_WARING_NOT_ENOUGH_WORKFORCE");
+    }
+
+    if (summary.requirements.requireContainerStorage
+        && summary.storage.container == 0) {
+        warnings.append("STR_EDITOR_WARING_MISSING_CONTAINER_STORAGE");
+    }
+
+    if (summary.requirements.requireSolidStorage
+        && summary.storage.solid == 0) {
+        warnings.append("STR_EDITOR_WARING_MISSING_SOLID_STORAGE");
+    }
+
+    if (summary.requirements.requireLiquidStorage
+        && summary.storage.liquid == 0) {
+        warnings.append("STR_EDITOR_WARING_MISSING_LIQUID_STORAGE");
+    }
+
+    if (summary.dockingBay.sDock == 0 && summary.dockingBay.mDock == 0) {
+        warnings.append("STR_EDITOR_WARING_MISSING_DOCKINGBAY");
+    }
+
+    return warnings;
+}
+
+/**
+ * @brief		Get net rates of wares.
+ */
+QMap<QString, Range<Rate>> StationSummary::netWares(const Info &summary)
+{
+    QMap<QString, Range<Rate>> wares = summary.intermediates;
+    for (auto iter = summary.products.begin(); iter != summary.products.end();
+         ++iter) {
+        wares[iter.key()] = *iter;
+    }
+    for (auto iter = summary.resources.begin();
+         iter != summary.resources.end(); ++iter) {
+        wares[iter.key()] = Range<Rate>(-iter->min(), -iter->max());
+    }
+
+    return wares;
+}
+
+/**
+ * @brief		Destructor.
+ */
+StationSummary::~StationSummary() {}
+
+/**
+ * @brief		Add rates of wares to the sums.
+ */
+void StationSummary::addWareRates(
+    QMap<QString, WareSummary> &                                wares,
+    const QVector<GameStationModules::StationModule::WareRate> &rates,
+    qint64                                                      amount)
+{
+    for (const auto &rate : rates) {
+        auto iter = wares.find(rate.ware);
+        if (iter == wares.end()) {
+            iter = wares.insert(rate.ware,
+                                {Range<Rate>(), 0, rate.transportType});
+        }
+
+        // Remove the ware when no module uses it.
+        iter->modules += amount;
+        if (iter->modules <= 0) {
+            wares.erase(iter);
+        } else {
+            iter->range.setRange(iter->range.min() + rate.min * amount,
+                                 iter->range.max() + rate.max * amount);
+        }
+    }
+}
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+#include <common/multi_threading.h>
+#include <summary/station_variants.h>
+
+/// Variants taken by a worker each time.
+#define VARIANTS_BATCH_SIZE 64
+
+/**
+ * @brief		Constructor.
+ */
+StationVariants::StationVariants(
+    ::std::shared_ptr<GameStationModuleTable> table,
+    ::std::shared_ptr<GameWares>              wares,
+    ::std::shared_ptr<Save>                   save) :
+    m_table(table),
+    m_wares(wares)
+{
+    for (const auto &saveGroup : save->groups()) {
+        for (const auto &saveModule : saveGroup->modules()) {
+            m_amounts[saveModule->module()] += saveModule->amount();
+        }
+    }
+    m_summary.reset(table, save);
+}
+
+/**
+ * @brief		Get amounts of modules in the base station.
+ */
+const QMap<QString, quint64> &StationVariants::amounts() const
+{
+    return m_amounts;
+}
+
+/**
+ * @brief		Add a sweep.
+ */
+void StationVariants::addSweep(const StationVariants::Sweep &sweep)
+{
+    if (! sweep.options.empty()) {
+        m_sweeps.append(sweep);
+    }
+}
+
+/**
+ * @brief		Add a sweep of the amount of a module.
+ */
+void StationVariants::addAmountSweep(const QString &macro,
+                                     qint64         min,
+                                     qint64         max)
+{
+    Sweep sweep;
+    sweep.name = macro;
+    for (qint64 amount = min; amount <= max; ++amount) {
+        sweep.options.append({{macro, amount}});
+    }
+
+    this->addSweep(sweep);
+}
+
+/**
+ * @brief		Add a sweep which replaces all modules of a macro.
+ */
+void StationVariants::addReplaceSweep(const QString &    macro,
+                                      const QStringList &alternatives)
+{
+    qint64 amount = static_cast<qint64>(m_amounts.value(macro, 0));
+    if (amount == 0) {
+        return;
+    }
+
+    // The first option keeps the module.
+    Sweep sweep;
+    sweep.name = macro;
+    sweep.options.append(Changes());
+    for (const auto &alternative : alternatives) {
+        if (alternative != macro) {
+            sweep.options.append({{macro, -amount}, {alternative, amount}});
+        }
+    }
+
+    this->addSweep(sweep);
+}
+
+/**
+ * @brief		Clear sweeps.
+ */
+void StationVariants::clearSweeps()
+{
+    m_sweeps.clear();
+}
+
+/**
+ * @brief		Get number of variants.
+ */
+quint64 StationVariants::count() const
+{
+    quint64 ret = 1;
+    for (const auto &sweep : m_sweeps) {
+        quint64 options = static_cast<quint64>(sweep.options.size());
+        if (ret > ::std::numeric_limits<quint64>::max() / options) {
+            return ::std::numeric_limits<quint64>::max();
+        }
+        ret *= options;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Evaluate all variants in parallel and keep the best ones.
+ */
+QVector<StationVariants::Variant> StationVariants::evaluate(
+    StationVariants::RankBy        rankBy,
+    int                            limit,
+    const ::std::function<bool()> &cancelled) const
+{
+    if (limit <= 0) {
+        return {};
+    }
+
+    // Prices of all wares the variants may use, looked up before the workers
+    // start.
+    QMap<QString, quint32> prices;
+    auto addPrices = [&](const QString &macro) -> void {
+        qint64 id = m_table->id(macro);
+        if (id < 0) {
+            return;
+        }
+        auto module = m_table->module(id);
+        for (const auto &rates : {module->products, module->resources}) {
+            for (const auto &rate : rates) {
+                if (! prices.contains(rate.ware)) {
+                    auto ware         = m_wares->ware(rate.ware);
+                    prices[rate.ware] = ware == nullptr ? 0
+                                                        : ware->averagePrice;
+                }
+            }
+        }
+    };
+    for (auto iter = m_amounts.begin(); iter != m_amounts.end(); ++iter) {
+        addPrices(iter.key());
+    }
+    for (const auto &sweep : m_sweeps) {
+        for (const auto &option : sweep.options) {
+            for (const auto &change : option) {
+                addPrices(change.first);
+            }
+        }
+    }
+
+    // Variants with the same key keep the order of their indices, so the
+    // result does not depend on the scheduling of workers.
+    typedef QPair<quint64, Variant> Ranked;
+    auto better = [rankBy](const Ranked &ranked1,
+                           const Ranked &ranked2) -> bool {
+        const Variant &variant1 = ranked1.second;
+        const Variant &variant2 = ranked2.second;
+        switch (rankBy) {
+            case RankBy::Cost:
+                if (variant1.cost != variant2.cost) {
+                    return variant1.cost < variant2.cost;
+                }
+                break;
+
+            case RankBy::Throughput:
+                if (variant1.throughput != variant2.throughput) {
+                    return variant1.throughput > variant2.throughput;
+                }
+                break;
+
+            default:
+                if (variant1.surplus != variant2.surplus) {
+                    return variant1.surplus > variant2.surplus;
+                }
+                break;
+        }
+        return ranked1.first < ranked2.first;
+    };
+
+    // Evaluate. Each worker keeps its best variants in a heap whose front is
+    // the worst one, the heaps are merged when the workers finish.
+    quint64                total = this->count();
+    QMutex                 lock;
+    ::std::vector<Ranked>  merged;
+    ::std::atomic<quint64> next(0);
+    ::std::atomic<bool>    stopped(false);
+
+    MultiRun evaluateTask(::std::function<void()>([&]() -> void {
+        ::std::vector<Ranked> best;
+        Ranked                current;
+        while (! stopped) {
+            if (cancelled()) {
+                stopped = true;
+                return;
+            }
+            quint64 begin = next.fetch_add(VARIANTS_BATCH_SIZE);
+            if (begin >= total) {
+                break;
+            }
+            quint64 end = ::std::min<quint64>(begin + VARIANTS_BATCH_SIZE,
+                                              total);
+            for (quint64 index = begin; index < end; ++index) {
+                current.first = index;
+                if (! this->evaluate(index, prices, current.second)) {
+                    continue;
+                }
+                if (best.size() < static_cast<size_t>(limit)) {
+                    best.push_back(::std::move(current));
+                    ::std::push_heap(best.begin(), best.end(), better);
+                } else if (better(current, best.front())) {
+                    ::std::pop_heap(best.begin(), best.end(), better);
+                    best.back() = ::std::move(current);
+                    ::std::push_heap(best.begin(), best.end(), better);
+                }
+            }
+        }
+
+        QMutexLocker locker(&lock);
+        merged.insert(merged.end(), ::std::make_move_iterator(best.begin()),
+                      ::std::make_move_iterator(best.end()));
+    }));
+    evaluateTask.run(total <= VARIANTS_BATCH_SIZE);
+    if (stopped) {
+        return {};
+    }
+
+    // Rank.
+    ::std::sort(merged.begin(), merged.end(), better);
+    if (merged.size() > static_cast<size_t>(limit)) {
+        merged.resize(static_cast<size_t>(limit));
+    }
+    QVector<Variant> ret;
+    ret.reserve(static_cast<int>(merged.size()));
+    for (auto &ranked : merged) {
+        ret.append(::std::move(ranked.second));
+    }
+
+    return ret;
+}
+
+/**
+ * @brief		Destructor.
+ */
+StationVariants::~StationVariants() {}
+
+/**
+ * @brief		Evaluate a variant.
+ */
+bool StationVariants::evaluate(quint64                       index,
+                               const QMap<QString, quint32> &prices,
+                               StationVariants::Variant &    variant) const
+{
+    // Changes of the option of each sweep, the index is in mixed radix.
+    variant.changes.clear();
+    for (const auto &sweep : m_sweeps) {
+        quint64 options = static_cast<quint64>(sweep.options.size());
+        for (const auto &change :
+             sweep.options[static_cast<int>(index % options)]) {
+            variant.changes[change.first] += change.second;
+        }
+        index /= options;
+    }
+
+    StationSummary summary = m_summary;
+    for (auto iter = variant.changes.begin(); iter != variant.changes.end();) {
+        if (*iter == 0) {
+            iter = variant.changes.erase(iter);
+            continue;
+        }
+        if (static_cast<qint64>(m_amounts.value(iter.key(), 0)) + *iter < 0) {
+            return false;
+        }
+        summary.add(iter.key(), *iter);
+        ++iter;
+    }
+
+    // Value of wares.
+    auto info          = summary.make();
+    variant.throughput = 0;
+    variant.cost       = 0;
+    auto wares         = StationSummary::netWares(info);
+    for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
+        qint64 value = (iter->max() * prices.value(iter.key(), 0)).round();
+        if (value > 0) {
+            variant.throughput += value;
+        } else {
+            variant.cost -= value;
+        }
+    }
+    variant.surplus          = variant.throughput - variant.cost;
+    variant.workforce        = info.workforce;
+    variant.surplusWorkforce = info.surplusWorkforce;
+    variant.warnings         = StationSummary::check(info).size();
+
+    return true;
+}
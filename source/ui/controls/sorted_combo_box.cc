@@ -0,0 +1,88 @@
+#include <algorithm>
+
+#include <QtCore/QCollator>
+#include <QtCore/QCollatorSortKey>
+#include <QtCore/QSignalBlocker>
+#include <QtGui/QStandardItemModel>
+
+#include <locale/string_table.h>
+#include <ui/controls/sorted_combo_box.h>
+
+/**
+ * @brief		Constructor.
+ */
+SortedComboBox::SortedComboBox(QWidget *parent) : QComboBox(parent) {}
+
+/**
+ * @brief		Destructor.
+ */
+SortedComboBox::~SortedComboBox() {}
+
+/**
+ * @brief		Replace all items.
+ */
+void SortedComboBox::setItems(const QVector<SortedComboBox::Item> &items)
+{
+    // Sort by collation keys, each text is transformed only once.
+    QCollator                 collator = StringTable::instance()->collator();
+    QVector<QCollatorSortKey> keys;
+    QVector<int>              order;
+    keys.reserve(items.size());
+    order.reserve(items.size());
+    for (int i = 0; i < items.size(); ++i) {
+        keys.append(collator.sortKey(items[i].first));
+        order.append(i);
+    }
+    ::std::stable_sort(order.begin(), order.end(),
+                       [&keys](int index1, int index2) -> bool {
+                           return keys[index1].compare(keys[index2]) < 0;
+                       });
+
+    QList<QStandardItem *> rows;
+    rows.reserve(items.size());
+    for (int index : order) {
+        QStandardItem *row = new QStandardItem(items[index].first);
+        row->setData(items[index].second, Qt::ItemDataRole::UserRole);
+        rows.append(row);
+    }
+
+    // Repopulate.
+    QVariant       current = this->currentData();
+    QSignalBlocker blocker(this);
+    this->clear();
+    static_cast<QStandardItemModel *>(this->model())
+        ->invisibleRootItem()
+        ->appendRows(rows);
+    int index = this->findData(current);
+    this->setCurrentIndex(index >= 0 || rows.empty() ? index : 0);
+}
+
+/**
+ * @brief		Change texts of all items and sort again.
+ */
+void SortedComboBox::setItemTexts(
+    const ::std::function<QString(const QVariant &)> &text)
+{
+    QVector<Item> items;
+    items.reserve(this->count());
+    for (int i = 0; i < this->count(); ++i) {
+        QVariant data = this->itemData(i);
+        items.append({text(data), data});
+    }
+
+    this->setItems(items);
+}
+
+/**
+ * @brief		Sort items by text.
+ */
+void SortedComboBox::sortItems()
+{
+    QVector<Item> items;
+    items.reserve(this->count());
+    for (int i = 0; i < this->count(); ++i) {
+        items.append({this->itemText(i), this->itemData(i)});
+    }
+
+    this->setItems(items);
+}
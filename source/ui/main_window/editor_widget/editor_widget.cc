@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QMutexLocker>
 #include <QtGui/QClipboard>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QFileDialog>
@@ -10,6 +13,7 @@
 #include <QMenu>
 #include <locale/string_table.h>
 #include <ui/main_window/editor_widget/editor_widget.h>
+#include <ui/main_window/editor_widget/what_if_dialog.h>
 #include <ui/main_window/editor_widget/x4sc_group_clipboard_mime_data_builder.h>
 #include <ui/main_window/editor_widget/x4sc_module_clipboard_mime_data_builder.h>
 
@@ -52,7 +56,8 @@ EditorWidget::EditorWidget(::std::shared_ptr<Save>  save,
     m_save(save), m_savedUndoCount(0), m_fileActions(fileActions),
     m_editActions(editActions), m_backgroundTasks(new BackgroundTask(
                                     BackgroundTask::RunType::Newest, this)),
-    m_treeEditor(nullptr)
+    m_treeEditor(nullptr), m_summaryResetRequested(false),
+    m_summaryRequestSerial(0), m_summaryForceShow(false)
 {
     this->connect(this, &EditorWidget::windowTitleChanged, parent,
                   &QMdiSubWindow::setWindowTitle);
@@ -226,6 +231,13 @@ EditorWidget::EditorWidget(::std::shared_ptr<Save>  save,
     this->connect(StringTable::instance().get(), &StringTable::languageChanged,
                   this, &EditorWidget::onLanguageChanged);
 
+    // Reload game data.
+    this->connect(GameData::instance().get(), &GameData::dataReloaded, this,
+                  [this]() -> void {
+                      this->onLanguageChanged();
+                      this->updateSummary();
+                  });
+
     m_treeEditor->expandAll();
 
     // Add to container.
@@ -247,7 +259,17 @@ EditorWidget::EditorWidget(::std::shared_ptr<Save>  save,
 /**
  * @brief	Destructors.
  */
-EditorWidget::~EditorWidget() {}
+EditorWidget::~EditorWidget()
+{
+    // Summary task accesses members.
+    delete m_backgroundTasks;
+
+    // The file is no longer opened.
+    auto iter = _opendFiles.find(this->path());
+    if (iter != _opendFiles.end() && *iter == this) {
+        _opendFiles.erase(iter);
+    }
+}
 
 /**
  * @brief		Do operation.
@@ -260,7 +282,7 @@ void EditorWidget::doOperation(::std::shared_ptr<Operation> operation)
         qDebug() << "Operation done.";
         this->updateSaveStatus();
         this->updateUndoRedoStatus();
-        this->updateSummary();
+        this->updateSummary(operation, false);
     } else {
         qDebug() << "Operation failed.";
     }
@@ -460,12 +482,134 @@ void EditorWidget::updateSummary()
 {
     this->disableSuggestedAmounts();
 
-    SummaryInfo summary;
-    this->makeSummary(summary);
-    this->showSummary(summary);
+    // Take a snapshot of modules in the save.
+    QVector<QPair<QString, quint64>> modules;
+    for (const auto &saveGroup : m_save->groups()) {
+        for (const auto &saveModule : saveGroup->modules()) {
+            modules.append({saveModule->module(), saveModule->amount()});
+        }
+    }
+
+    auto table = GameData::instance()->stationModules()->table();
+    {
+        QMutexLocker locker(&m_summaryRequestLock);
+        m_summaryResetRequested = true;
+        m_summaryRequestTable   = table;
+        m_summaryRequestModules = ::std::move(modules);
+        m_summaryRequestChanges.clear();
+        ++m_summaryRequestSerial;
+    }
+
+    m_backgroundTasks->runTask([this]() -> void {
+        this->computeSummary();
+    });
+}
+
+/**
+ * @brief       Update summary after an operation is done or undone.
+ */
+void EditorWidget::updateSummary(::std::shared_ptr<Operation> operation,
+                                 bool                         undo)
+{
+    // Rebuild if changes are unknown.
+    QMap<QString, qint64> changes;
+    if (! operation->amountChanges(changes)) {
+        this->updateSummary();
+        return;
+    }
+
+    if (changes.empty()) {
+        return;
+    }
+
+    // Merge with changes not computed yet.
+    {
+        QMutexLocker locker(&m_summaryRequestLock);
+        for (auto iter = changes.begin(); iter != changes.end(); ++iter) {
+            m_summaryRequestChanges[iter.key()]
+                += undo ? -iter.value() : iter.value();
+        }
+        ++m_summaryRequestSerial;
+    }
+
+    m_backgroundTasks->runTask([this]() -> void {
+        this->computeSummary();
+    });
+}
+
+/**
+ * @brief       Compute summary of requests.
+ */
+void EditorWidget::computeSummary()
+{
+    // Take requests.
+    bool                                      reset;
+    ::std::shared_ptr<GameStationModuleTable> table;
+    QVector<QPair<QString, quint64>>          modules;
+    QMap<QString, qint64>                     changes;
+    quint64                                   serial;
+    {
+        QMutexLocker locker(&m_summaryRequestLock);
+        reset = m_summaryResetRequested;
+        table.swap(m_summaryRequestTable);
+        modules.swap(m_summaryRequestModules);
+        changes.swap(m_summaryRequestChanges);
+        serial                  = m_summaryRequestSerial;
+        m_summaryResetRequested = false;
+    }
+
+    // Compute.
+    if (reset) {
+        m_stationSummary.reset(table, modules);
+    }
+    for (auto iter = changes.begin(); iter != changes.end(); ++iter) {
+        m_stationSummary.add(iter.key(), iter.value());
+    }
+
+    SummaryInfo summary = m_stationSummary.make();
+    m_stationSummary.solveSuggestedAmounts(summary);
+
+    // Publish.
+    QMetaObject::invokeMethod(
+        this,
+        [this, summary, serial, reset]() -> void {
+            this->publishSummary(summary, serial, reset);
+        },
+        Qt::ConnectionType::QueuedConnection);
+}
+
+/**
+ * @brief       Show summary computed by summary task.
+ */
+void EditorWidget::publishSummary(const SummaryInfo &summary,
+                                  quint64            serial,
+                                  bool               reset)
+{
+    // Skip if a newer summary is being computed.
+    m_summaryForceShow = m_summaryForceShow || reset;
+    if (serial != m_summaryRequestSerial) {
+        return;
+    }
+
+    bool force         = m_summaryForceShow;
+    m_summaryForceShow = false;
+
+    this->showSummary(summary, force);
     this->checkSummary(summary);
 
-    this->updateSuggestedAmounts(summary);
+    if (force || summary.suggestedAmounts != m_summary.suggestedAmounts) {
+        this->disableSuggestedAmounts();
+        this->updateSuggestedAmounts(summary);
+    }
+
+    // Net rates of wares.
+    if (force || summary.products != m_summary.products
+        || summary.intermediates != m_summary.intermediates
+        || summary.resources != m_summary.resources) {
+        emit this->waresChanged(this, StationSummary::netWares(summary));
+    }
+
+    m_summary = summary;
 }
 
 /**
@@ -494,8 +638,12 @@ void EditorWidget::disableSuggestedAmounts()
 /**
  * @brief       Update suggested amounts.
  */
-void EditorWidget::updateSuggestedAmounts(SummaryInfo &summary)
+void EditorWidget::updateSuggestedAmounts(const SummaryInfo &summary)
 {
+    // Amounts to change of each macro are shared by its module items in
+    // order.
+    QMap<QString, qint64> remaining = summary.suggestedAmounts;
+
     // Group.
     for (int groupIndex = 0; groupIndex < m_itemGroups->childCount();
          ++groupIndex) {
@@ -518,551 +666,122 @@ void EditorWidget::updateSuggestedAmounts(SummaryInfo &summary)
                 continue;
             }
 
-            // Station module.
-            auto module = GameData::instance()->stationModules()->module(
-                moduleItem->module()->module());
-            if (module == nullptr) {
-                continue;
+            // Amount to change.
+            qint64 amount = 0;
+            auto   iter   = remaining.find(moduleItem->module()->module());
+            if (iter != remaining.end()) {
+                amount = ::std::max(
+                    *iter, -static_cast<qint64>(moduleItem->moduleAmount()));
+                *iter -= amount;
             }
 
-            switch (module->moduleClass) {
-                case GameStationModules::StationModule::StationModuleClass::
-                    Habitation: {
-                    widget->setSuggestedAmountToChange(
-                        static_cast<qint64>(-summary.surplusWorkforce));
-                    widget->setSuggestAmountEnabled(true);
-
-                } break;
-
-                case GameStationModules::StationModule::StationModuleClass::
-                    Production: {
-                    // Search property.
-                    auto iter = module->properties.find(
-                        GameStationModules::Property::SupplyProduct);
-                    if (iter == module->properties.end()) {
-                        break;
-                    }
-                    ::std::shared_ptr<GameStationModules::SupplyProduct>
-                        property = ::std::static_pointer_cast<
-                            GameStationModules::SupplyProduct>(*iter);
-
-                    // Search intermediate.
-                    auto intermediatesIter
-                        = summary.intermediates.find(property->product);
-                    if (intermediatesIter == summary.intermediates.end()) {
-                        break;
-                    }
-
-                    widget->setSuggestedAmountToChange(
-                        static_cast<qint64>(-intermediatesIter->max()));
-                    widget->setSuggestAmountEnabled(true);
-                } break;
-
-                default:
-                    break;
-            }
+            widget->setSuggestedAmountToChange(static_cast<int>(amount));
+            widget->setSuggestAmountEnabled(true);
         }
     }
 }
 
 /**
- * @brief       Make summary.
+ * @brief       Show summary, only changed items are updated.
  */
-void EditorWidget::makeSummary(SummaryInfo &summary)
+void EditorWidget::showSummary(const SummaryInfo &summary, bool force)
 {
-    auto gameStationModules = GameData::instance()->stationModules();
-    auto gameWares          = GameData::instance()->wares();
-
-    // Count summary.
-    for (const auto& saveGroup : m_save->groups()) {
-        for (const auto& saveModule : saveGroup->modules()) {
-            auto module = gameStationModules->module(saveModule->module());
-
-            // Hull & explosion damage.
-            summary.hull += module->hull * saveModule->amount();
-            summary.explosionDamage
-                += module->explosiondamage * saveModule->amount();
-
-            // Properties.
-            for (auto property : module->properties) {
-                switch (property->type) {
-                    case GameStationModules::Property::Type::MTurret:
-                        // Has M turret.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasMTurret>
-                                hasMTurret = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasMTurret>(property);
-                            summary.weapons.mTurret
-                                += hasMTurret->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::MShield:
-                        // Has M shield.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasMShield>
-                                hasMShield = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasMShield>(property);
-                            summary.shields.mShield
-                                += hasMShield->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::LTurret:
-                        // Has L turret.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasLTurret>
-                                hasLTurret = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasLTurret>(property);
-                            summary.weapons.lTurret
-                                += hasLTurret->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::LShield:
-                        // Has L shield.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasLShield>
-                                hasLShield = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasLShield>(property);
-                            summary.shields.lShield
-                                += hasLShield->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::SDock:
-                        // Has S docking bay.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasSDock>
-                                hasSDock = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasSDock>(property);
-                            summary.dockingBay.sDock
-                                += hasSDock->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::SShipCargo:
-                        // Has S ship cargo.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasSShipCargo>
-                                hasSShipCargo = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasSShipCargo>(
-                                    property);
-                            summary.shipStorage.sShipCargo
-                                += hasSShipCargo->capacity
-                                   * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::MDock:
-                        // Has M docking bay.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasMDock>
-                                hasMDock = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasMDock>(property);
-                            summary.dockingBay.mDock
-                                += hasMDock->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::MShipCargo:
-                        // Has M ship cargo.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasMShipCargo>
-                                hasMShipCargo = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasMShipCargo>(
-                                    property);
-                            summary.shipStorage.mShipCargo
-                                += hasMShipCargo->capacity
-                                   * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::LDock:
-                        // Has L docking bay.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasLDock>
-                                hasLDock = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasLDock>(property);
-                            summary.dockingBay.lDock
-                                += hasLDock->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::XLDock:
-                        // Has XL docking bay.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasXLDock>
-                                hasXLDock = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasXLDock>(property);
-                            summary.dockingBay.xlDock
-                                += hasXLDock->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::LXLDock:
-                        // Has L/XL docking bay.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasLXLDock>
-                                hasLXLDock = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasLXLDock>(property);
-                            summary.dockingBay.lXLDock
-                                += hasLXLDock->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::SLaunchTube:
-                        // Has S launch tube.
-                        {
-                            ::std::shared_ptr<
-                                GameStationModules::HasSLaunchTube>
-                                hasSLaunchTube = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasSLaunchTube>(
-                                    property);
-                            summary.weapons.sLaunchTube
-                                += hasSLaunchTube->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::MLaunchTube:
-                        // Has M launch tube.
-                        {
-                            ::std::shared_ptr<
-                                GameStationModules::HasMLaunchTube>
-                                hasMLaunchTube = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasMLaunchTube>(
-                                    property);
-                            summary.weapons.mLaunchTube
-                                += hasMLaunchTube->count * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::SupplyWorkforce:
-                        // Supply workforce.
-                        {
-                            ::std::shared_ptr<
-                                GameStationModules::SupplyWorkforce>
-                                supplyWorkforce = ::std::dynamic_pointer_cast<
-                                    GameStationModules::SupplyWorkforce>(
-                                    property);
-
-                            // Workforce.
-                            summary.workforce += supplyWorkforce->workforce
-                                                 * saveModule->amount();
-                            summary.surplusWorkforce
-                                += (qint64)(supplyWorkforce->workforce)
-                                   * saveModule->amount();
-
-                            // Supply.
-                            for (auto resource :
-                                 supplyWorkforce->supplyInfo->resources) {
-                                // Find/create ware.
-                                const QString &macro = resource->id;
-                                auto iter = summary.resources.find(macro);
-                                if (iter == summary.resources.end()) {
-                                    summary.resources[macro] = Range<
-                                        long double>(
-                                        0.0,
-                                        (((long double)resource->amount)
-                                         * supplyWorkforce->workforce * 3600
-                                         * saveModule->amount()
-                                         / supplyWorkforce->supplyInfo->amount
-                                         / supplyWorkforce->supplyInfo->time));
-                                } else {
-                                    // Increase amount.
-                                    iter->setMax(
-                                        iter->max()
-                                        + (((long double)resource->amount)
-                                           * supplyWorkforce->workforce * 3600
-                                           * saveModule->amount()
-                                           / supplyWorkforce->supplyInfo->amount
-                                           / supplyWorkforce->supplyInfo
-                                                 ->time));
-                                }
-
-                                // Transport type.
-                                switch (gameWares->ware(macro)->transportType) {
-                                    case GameWares::TransportType::Container:
-                                        // Container.
-                                        summary.requirements
-                                            .requireContainerStorage
-                                            = true;
-                                        break;
-
-                                    case GameWares::TransportType::Solid:
-                                        // Solid.
-                                        summary.requirements.requireSolidStorage
-                                            = true;
-                                        break;
-
-                                    case GameWares::TransportType::Liquid:
-                                        // Liquid.
-                                        summary.requirements
-                                            .requireLiquidStorage
-                                            = true;
-                                        break;
-
-                                    default:
-                                        break;
-                                }
-                            }
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::RequireWorkforce:
-                        // Require workforce.
-                        {
-                            ::std::shared_ptr<
-                                GameStationModules::RequireWorkforce>
-                                requireWorkforce = ::std::dynamic_pointer_cast<
-                                    GameStationModules::RequireWorkforce>(
-                                    property);
-                            summary.surplusWorkforce
-                                -= (qint64)(requireWorkforce->workforce)
-                                   * saveModule->amount();
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::SupplyProduct:
-                        // Supply product.
-                        {
-                            ::std::shared_ptr<GameStationModules::SupplyProduct>
-                                supplyProfduct = ::std::dynamic_pointer_cast<
-                                    GameStationModules::SupplyProduct>(
-                                    property);
-                            ::std::shared_ptr<GameWares::ProductionInfo>
-                                productionInfo = supplyProfduct->productionInfo;
-                            const QString &macro = productionInfo->id;
-
-                            // Product.
-                            // Find/create ware.
-                            auto iter = summary.products.find(macro);
-                            if (iter == summary.products.end()) {
-                                summary.products[macro] = Range<long double>(
-                                    (long double)(productionInfo->amount) * 3600
-                                        * saveModule->amount()
-                                        / productionInfo->time,
-                                    (long double)(productionInfo->amount) * 3600
-                                        * saveModule->amount()
-                                        * (1.0 + productionInfo->workEffect)
-                                        / productionInfo->time);
-                            } else {
-                                // Increase amount.
-                                iter->setRange(
-                                    (long double)(productionInfo->amount) * 3600
-                                            * saveModule->amount()
-                                            / productionInfo->time
-                                        + iter->min(),
-                                    (long double)(productionInfo->amount) * 3600
-                                            * saveModule->amount()
-                                            * (1.0 + productionInfo->workEffect)
-                                            / productionInfo->time
-                                        + iter->max());
-                            }
-
-                            // Transport type.
-                            switch (gameWares->ware(macro)->transportType) {
-                                case GameWares::TransportType::Container:
-                                    // Container.
-                                    summary.requirements.requireContainerStorage
-                                        = true;
-                                    break;
-
-                                case GameWares::TransportType::Solid:
-                                    // Solid.
-                                    summary.requirements.requireSolidStorage
-                                        = true;
-                                    break;
-
-                                case GameWares::TransportType::Liquid:
-                                    // Liquid.
-                                    summary.requirements.requireLiquidStorage
-                                        = true;
-                                    break;
-
-                                default:
-                                    break;
-                            }
-
-                            // Resources.
-                            for (auto resouce : productionInfo->resources) {
-                                const QString &macro = resouce->id;
-
-                                // Find/create ware.
-                                auto iter = summary.resources.find(macro);
-                                if (iter == summary.resources.end()) {
-                                    summary.resources[macro]
-                                        = Range<long double>(
-                                            (long double)(resouce->amount)
-                                                * 3600 * saveModule->amount()
-                                                / productionInfo->time,
-                                            (long double)(resouce->amount)
-                                                * 3600 * saveModule->amount()
-                                                * (1.0
-                                                   + productionInfo->workEffect)
-                                                / productionInfo->time);
-                                } else {
-                                    // Increase amount.
-                                    iter->setRange(
-                                        (long double)(resouce->amount) * 3600
-                                                * saveModule->amount()
-                                                / productionInfo->time
-                                            + iter->min(),
-                                        (long double)(resouce->amount) * 3600
-                                                * saveModule->amount()
-                                                * (1.0
-                                                   + productionInfo->workEffect)
-                                                / productionInfo->time
-                                            + iter->max());
-                                }
-
-                                // Transport type.
-                                switch (gameWares->ware(macro)->transportType) {
-                                    case GameWares::TransportType::Container:
-                                        // Container.
-                                        summary.requirements
-                                            .requireContainerStorage
-                                            = true;
-                                        break;
-
-                                    case GameWares::TransportType::Solid:
-                                        // Solid.
-                                        summary.requirements.requireSolidStorage
-                                            = true;
-                                        break;
-
-                                    case GameWares::TransportType::Liquid:
-                                        // Liquid.
-                                        summary.requirements
-                                            .requireLiquidStorage
-                                            = true;
-                                        break;
-
-                                    default:
-                                        break;
-                                }
-                            }
-                        }
-                        break;
-
-                    case GameStationModules::Property::Type::Cargo:
-                        // Has cargo.
-                        {
-                            ::std::shared_ptr<GameStationModules::HasCargo>
-                                hasCargo = ::std::dynamic_pointer_cast<
-                                    GameStationModules::HasCargo>(property);
-
-                            switch (hasCargo->cargoType) {
-                                case GameWares::TransportType::Container:
-                                    // Container.
-                                    summary.storage.container
-                                        += hasCargo->cargoSize
-                                           * saveModule->amount();
-                                    break;
-
-                                case GameWares::TransportType::Solid:
-                                    // Solid.
-                                    summary.storage.solid
-                                        += hasCargo->cargoSize
-                                           * saveModule->amount();
-                                    break;
-
-                                case GameWares::TransportType::Liquid:
-                                    // Liquid.
-                                    summary.storage.liquid
-                                        += hasCargo->cargoSize
-                                           * saveModule->amount();
-                                    break;
-
-                                default:
-                                    break;
-                            }
-                        }
-                        break;
-                }
-            }
+    // Collect changed cells.
+    QVector<QPair<QTreeWidgetItem *, QString>> texts;
+    QVector<QPair<QTreeWidgetItem *, bool>>    hiddens;
+
+    auto setHidden = [&](QTreeWidgetItem *item, bool hidden) -> void {
+        if (item->isHidden() != hidden) {
+            hiddens.append({item, hidden});
         }
+    };
+#define CHANGED(field) (force || summary.field != m_summary.field)
+#define SET_VALUE(item, field)                                    \
+    if (CHANGED(field)) {                                         \
+        texts.append({(item), QString("%1").arg(summary.field)}); \
     }
+#define SET_HIDE_ZERO(item, field) \
+    SET_VALUE(item, field);        \
+    setHidden((item), summary.field == 0);
+
+    SET_VALUE(m_itemHull, hull);
+    SET_VALUE(m_itemExplosionDamage, explosionDamage);
+
+    setHidden(m_itemWeapons,
+              summary.weapons.sLaunchTube == 0
+                  && summary.weapons.mLaunchTube == 0
+                  && summary.weapons.mTurret == 0
+                  && summary.weapons.lTurret == 0);
+    SET_HIDE_ZERO(m_itemWeaponSLaunchTube, weapons.sLaunchTube);
+    SET_HIDE_ZERO(m_itemWeaponMLaunchTube, weapons.mLaunchTube);
+    SET_HIDE_ZERO(m_itemWeaponMTurret, weapons.mTurret);
+    SET_HIDE_ZERO(m_itemWeaponLTurret, weapons.lTurret);
+
+    setHidden(m_itemShields,
+              summary.shields.mShield == 0 && summary.shields.lShield == 0);
+    SET_HIDE_ZERO(m_itemShieldMShield, shields.mShield);
+    SET_HIDE_ZERO(m_itemShieldLShield, shields.lShield);
+
+    setHidden(m_itemStorage, summary.storage.container == 0
+                                 && summary.storage.solid == 0
+                                 && summary.storage.liquid == 0);
+    SET_HIDE_ZERO(m_itemStorageContainer, storage.container);
+    SET_HIDE_ZERO(m_itemStorageSolid, storage.solid);
+    SET_HIDE_ZERO(m_itemStorageLiquid, storage.liquid);
+
+    setHidden(m_itemDockingbay,
+              summary.dockingBay.sDock == 0 && summary.dockingBay.mDock == 0
+                  && summary.dockingBay.lDock == 0
+                  && summary.dockingBay.xlDock == 0
+                  && summary.dockingBay.lXLDock == 0);
+    SET_HIDE_ZERO(m_itemDockingbaySDock, dockingBay.sDock);
+    SET_HIDE_ZERO(m_itemDockingbayMDock, dockingBay.mDock);
+    SET_HIDE_ZERO(m_itemDockingbayLDock, dockingBay.lDock);
+    SET_HIDE_ZERO(m_itemDockingbayXLDock, dockingBay.xlDock);
+    SET_HIDE_ZERO(m_itemDockingbayLXLDock, dockingBay.lXLDock);
+
+    setHidden(m_itemShipStorage, summary.shipStorage.sShipCargo == 0
+                                     && summary.shipStorage.mShipCargo == 0);
+    SET_HIDE_ZERO(m_itemShipStorageSShipCargo, shipStorage.sShipCargo);
+    SET_HIDE_ZERO(m_itemShipStorageMShipCargo, shipStorage.mShipCargo);
+
+    SET_VALUE(m_itemWorkforce, workforce);
+    SET_VALUE(m_itemSurplusWorkforce, surplusWorkforce);
 
-    // Intermediates
-    for (auto macro : summary.products.keys()) {
-        if (summary.resources.find(macro) != summary.resources.end()) {
-            auto productRange  = summary.products[macro];
-            auto resourceRange = summary.resources[macro];
-            summary.intermediates[macro]
-                = Range<long double>(productRange.min() - resourceRange.min(),
-                                     productRange.max() - resourceRange.max());
-            summary.products.remove(macro);
-            summary.resources.remove(macro);
-        }
+#undef SET_HIDE_ZERO
+#undef SET_VALUE
+#undef CHANGED
+
+    // Wares.
+    QVector<QPair<WaresItem *, const QMap<QString, Range<Rate>> *>>
+        wares;
+    if (! m_itemResources->isShowing(summary.resources)) {
+        wares.append({m_itemResources, &summary.resources});
+    }
+    if (! m_itemIntermediates->isShowing(summary.intermediates)) {
+        wares.append({m_itemIntermediates, &summary.intermediates});
+    }
+    if (! m_itemProducts->isShowing(summary.products)) {
+        wares.append({m_itemProducts, &summary.products});
     }
-}
 
-/**
- * @brief       Show summary.
- *
- * @param[in]   summary     Summary.
- */
-void EditorWidget::showSummary(const SummaryInfo &summary)
-{
-#define SET_HIDE_ZERO(item, value)                      \
-    {                                                   \
-        (item)->setText(1, QString("%1").arg((value))); \
-        (item)->setHidden((value) == 0);                \
-    }
-    m_itemHull->setText(1, QString("%1").arg(summary.hull));
-    m_itemExplosionDamage->setText(1,
-                                   QString("%1").arg(summary.explosionDamage));
-
-    m_itemWeapons->setHidden(
-        summary.weapons.sLaunchTube == 0 && summary.weapons.mLaunchTube == 0
-        && summary.weapons.mTurret == 0 && summary.weapons.lTurret == 0);
-    SET_HIDE_ZERO(m_itemWeaponSLaunchTube, summary.weapons.sLaunchTube);
-    SET_HIDE_ZERO(m_itemWeaponMLaunchTube, summary.weapons.mLaunchTube);
-    SET_HIDE_ZERO(m_itemWeaponMTurret, summary.weapons.mTurret);
-    SET_HIDE_ZERO(m_itemWeaponLTurret, summary.weapons.lTurret);
-
-    m_itemShields->setHidden(summary.shields.mShield == 0
-                             && summary.shields.lShield == 0);
-    SET_HIDE_ZERO(m_itemShieldMShield, summary.shields.mShield);
-    SET_HIDE_ZERO(m_itemShieldLShield, summary.shields.lShield);
-
-    m_itemStorage->setHidden(summary.storage.container == 0
-                             && summary.storage.solid == 0
-                             && summary.storage.liquid == 0);
-    SET_HIDE_ZERO(m_itemStorageContainer, summary.storage.container);
-    SET_HIDE_ZERO(m_itemStorageSolid, summary.storage.solid);
-    SET_HIDE_ZERO(m_itemStorageLiquid, summary.storage.liquid);
-
-    m_itemDockingbay->setHidden(
-        summary.dockingBay.sDock == 0 && summary.dockingBay.mDock == 0
-        && summary.dockingBay.lDock == 0 && summary.dockingBay.xlDock == 0
-        && summary.dockingBay.lXLDock == 0);
-    SET_HIDE_ZERO(m_itemDockingbaySDock, summary.dockingBay.sDock);
-    SET_HIDE_ZERO(m_itemDockingbayMDock, summary.dockingBay.mDock);
-    SET_HIDE_ZERO(m_itemDockingbayLDock, summary.dockingBay.lDock);
-    SET_HIDE_ZERO(m_itemDockingbayXLDock, summary.dockingBay.xlDock);
-    SET_HIDE_ZERO(m_itemDockingbayLXLDock, summary.dockingBay.lXLDock);
-
-    m_itemShipStorage->setHidden(summary.shipStorage.sShipCargo == 0
-                                 && summary.shipStorage.mShipCargo == 0);
-    SET_HIDE_ZERO(m_itemShipStorageSShipCargo, summary.shipStorage.sShipCargo);
-    SET_HIDE_ZERO(m_itemShipStorageMShipCargo, summary.shipStorage.sShipCargo);
-
-    m_itemWorkforce->setText(1, QString("%1").arg(summary.workforce));
-    m_itemSurplusWorkforce->setText(
-        1, QString("%1").arg(summary.surplusWorkforce));
-
-    m_itemResources->update(summary.resources);
-    m_itemResources->setHidden(m_itemResources->wareCount() == 0);
-
-    m_itemIntermediates->update(summary.intermediates);
-    m_itemIntermediates->setHidden(m_itemIntermediates->wareCount() == 0);
-
-    m_itemProducts->update(summary.products);
-    m_itemProducts->setHidden(m_itemProducts->wareCount() == 0);
+    if (texts.empty() && hiddens.empty() && wares.empty()) {
+        return;
+    }
 
-#undef SET_HIDE_ZERO
+    // Apply changes with one repaint.
+    m_treeEditor->setUpdatesEnabled(false);
+    for (auto &text : texts) {
+        text.first->setText(1, text.second);
+    }
+    for (auto &hidden : hiddens) {
+        hidden.first->setHidden(hidden.second);
+    }
+    for (auto &ware : wares) {
+        ware.first->update(*ware.second);
+        ware.first->setHidden(ware.first->wareCount() == 0);
+    }
+    m_treeEditor->setUpdatesEnabled(true);
 }
 
 /**
@@ -1072,29 +791,26 @@ void EditorWidget::showSummary(const SummaryInfo &summary)
  */
 void EditorWidget::checkSummary(const SummaryInfo &summary)
 {
-    this->clearWarnings();
-    if (summary.surplusWorkforce < 0) {
-        this->addWarning("STR_EDITOR_WARING_NOT_ENOUGH_WORKFORCE");
-    }
-
-    if (summary.requirements.requireContainerStorage
-        && summary.storage.container == 0) {
-        this->addWarning("STR_EDITOR_WARING_MISSING_CONTAINER_STORAGE");
-    }
+    QStringList warnings = StationSummary::check(summary);
 
-    if (summary.requirements.requireSolidStorage
-        && summary.storage.solid == 0) {
-        this->addWarning("STR_EDITOR_WARING_MISSING_SOLID_STORAGE");
+    // Keep warning widgets if nothing changed.
+    if (warnings == m_warnings) {
+        return;
     }
 
-    if (summary.requirements.requireLiquidStorage
-        && summary.storage.liquid == 0) {
-        this->addWarning("STR_EDITOR_WARING_MISSING_LIQUID_STORAGE");
+    this->clearWarnings();
+    for (auto &id : warnings) {
+        this->addWarning(id);
     }
+    m_warnings = warnings;
+}
 
-    if (summary.dockingBay.sDock == 0 && summary.dockingBay.mDock == 0) {
-        this->addWarning("STR_EDITOR_WARING_MISSING_DOCKINGBAY");
-    }
+/**
+ * @brief	Get path of the save file.
+ */
+QString EditorWidget::path() const
+{
+    return m_save == nullptr ? QString() : m_save->path();
 }
 
 /**
@@ -1289,7 +1005,7 @@ void EditorWidget::undo()
 
     this->updateSaveStatus();
     this->updateUndoRedoStatus();
-    this->updateSummary();
+    this->updateSummary(op, true);
 }
 
 /**
@@ -1310,7 +1026,9 @@ void EditorWidget::redo()
     // Add to redo stack.
     m_undoStack.push_back(op);
 
+    this->updateSaveStatus();
     this->updateUndoRedoStatus();
+    this->updateSummary(op, false);
 }
 
 /**
@@ -1601,6 +1319,9 @@ void EditorWidget::saveAs()
         this->updateSaveStatus();
         _opendFiles.remove(oldPath);
         _opendFiles[m_save->path()] = this;
+        if (oldPath != m_save->path()) {
+            emit this->pathChanged(this, oldPath, m_save->path());
+        }
     } else {
         QMessageBox::critical(this, STR("STR_ERROR"),
                               STR("STR_ERR_SAVE").arg(fileName));
@@ -1642,6 +1363,15 @@ void EditorWidget::exportAsHTML()
     }
 }
 
+/**
+ * @brief		Compare variants of the station.
+ */
+void EditorWidget::whatIf()
+{
+    WhatIfDialog dialog(m_save, this);
+    dialog.exec();
+}
+
 /**
  * @brief		Change language.
  */
@@ -1973,6 +1703,11 @@ void EditorWidget::active()
     this->connect(m_editActions->actionEditRemove, &QAction::triggered, this,
                   &EditorWidget::remove);
 
+    this->disconnect(m_editActions->actionEditWhatIf, &QAction::triggered,
+                     nullptr, nullptr);
+    this->connect(m_editActions->actionEditWhatIf, &QAction::triggered, this,
+                  &EditorWidget::whatIf);
+
     QClipboard *clipboard = QApplication::clipboard();
     this->disconnect(clipboard, &QClipboard::dataChanged, nullptr, nullptr);
     this->connect(clipboard, &QClipboard::dataChanged, this,
@@ -1983,6 +1718,7 @@ void EditorWidget::active()
     m_fileActions->actionFileExportAsHTML->setEnabled(true);
     m_fileActions->actionFileClose->setEnabled(true);
     m_editActions->actionEditNewGroup->setEnabled(true);
+    m_editActions->actionEditWhatIf->setEnabled(true);
     this->updateSaveStatus();
     this->updateAddToStationStatus();
     this->updateUndoRedoStatus();
@@ -1,5 +1,3 @@
-#include <cmath>
-
 #include <game_data/game_data.h>
 #include <locale/string_table.h>
 #include <ui/main_window/editor_widget/module_item.h>
@@ -127,6 +125,8 @@ ModuleItemWidget::ModuleItemWidget(ModuleItem *item) :
 
     this->connect(StringTable::instance().get(), &StringTable::languageChanged,
                   this, &ModuleItemWidget::onLanguageChanged);
+    this->connect(GameData::instance().get(), &GameData::dataReloaded, this,
+                  &ModuleItemWidget::onLanguageChanged);
     this->onLanguageChanged();
 }
 
@@ -177,10 +177,9 @@ void ModuleItemWidget::setSuggestAmountEnabled(bool enabled)
 /**
  * @brief       Set suggested amount to change.
  */
-void ModuleItemWidget::setSuggestedAmountToChange(qint64 productPerHourToChange)
+void ModuleItemWidget::setSuggestedAmountToChange(int amountToChange)
 {
-    m_suggestedAmountToChange
-        = this->suggestedAmountToChange(productPerHourToChange);
+    m_suggestedAmountToChange = amountToChange;
 }
 
 /**
@@ -247,69 +246,3 @@ void ModuleItemWidget::onSpinboxValueChanged(int i)
         emit this->changeAmount(oldCount, i, m_item);
     }
 }
-
-/**
- * @brief       Compute suggested amount.
- */
-int ModuleItemWidget::suggestedAmountToChange(qint64 productPerHourToChange)
-{
-    if (productPerHourToChange == 0) {
-        return 0;
-    }
-
-    // Get module.
-    auto module = GameData::instance()->stationModules()->module(
-        m_item->module()->module());
-    if (module == nullptr) {
-        return 0;
-    }
-
-    switch (module->moduleClass) {
-        case GameStationModules::StationModule::StationModuleClass::
-            Habitation: {
-            // Find property.
-            auto iter = module->properties.find(
-                GameStationModules::Property::SupplyWorkforce);
-            if (iter == module->properties.end()) {
-                return 0;
-            }
-
-            ::std::shared_ptr<GameStationModules::SupplyWorkforce> property
-                = ::std::static_pointer_cast<
-                    GameStationModules::SupplyWorkforce>(*iter);
-
-            // Compute result.
-            return static_cast<int>(
-                ::ceil(static_cast<double>(productPerHourToChange)
-                       / property->workforce));
-
-        } break;
-
-        case GameStationModules::StationModule::StationModuleClass::
-            Production: {
-            // Find property.
-            auto iter = module->properties.find(
-                GameStationModules::Property::SupplyProduct);
-            if (iter == module->properties.end()) {
-                return 0;
-            }
-            ::std::shared_ptr<GameStationModules::SupplyProduct> property
-                = ::std::static_pointer_cast<GameStationModules::SupplyProduct>(
-                    *iter);
-
-            // Compute result.
-            double amountPerHour
-                = static_cast<double>(property->productionInfo->amount) * 3600
-                  * (1 + property->productionInfo->workEffect)
-                  / property->productionInfo->time;
-
-            return static_cast<int>(
-                ::ceil(productPerHourToChange / amountPerHour));
-        } break;
-
-        default:
-            return 0;
-    }
-
-    return 0;
-}
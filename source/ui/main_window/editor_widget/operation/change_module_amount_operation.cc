@@ -59,6 +59,23 @@ void EditorWidget::ChangeModuleAmountOperation::undoOperation()
     moduleWidget->updateAmount();
 }
 
+/**
+ * @brief		Get changes of module amounts made by the operation.
+ */
+bool EditorWidget::ChangeModuleAmountOperation::amountChanges(
+    QMap<QString, qint64> &changes) const
+{
+    GroupItem *groupItem = static_cast<GroupItem *>(
+        m_editorWidget->m_itemGroups->child(m_groupIndex));
+    ModuleItem *moduleItem
+        = static_cast<ModuleItem *>(groupItem->child(m_moduleIndex));
+
+    changes[moduleItem->module()->module()]
+        += (qint64)m_newAmount - (qint64)m_oldAmount;
+
+    return true;
+}
+
 /**
  * @brief	Destructor.
  */
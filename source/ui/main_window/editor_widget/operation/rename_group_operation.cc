@@ -46,6 +46,15 @@ void EditorWidget::RenameGroupOperation::undoOperation()
     return;
 }
 
+/**
+ * @brief		Get changes of module amounts made by the operation.
+ */
+bool EditorWidget::RenameGroupOperation::amountChanges(
+    QMap<QString, qint64> &) const
+{
+    return true;
+}
+
 /**
  * @brief	Destructor.
  */
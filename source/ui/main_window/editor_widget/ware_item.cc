@@ -21,11 +21,23 @@ const QString &WareItem::ware() const
     return m_ware;
 }
 
+/**
+ * @brief       Get range.
+ */
+const Range<qint64> &WareItem::range() const
+{
+    return m_range;
+}
+
 /**
  * @brief       Set range.
  */
 void WareItem::setRange(const Range<qint64> &range)
 {
+    if (range.min() == m_range.min() && range.max() == m_range.max()) {
+        return;
+    }
+
     m_range = range;
     this->setText(1,
                   QString("%1/h - %2/h").arg(m_range.min()).arg(m_range.max()));
@@ -2,6 +2,18 @@
 
 #include <ui/main_window/editor_widget/wares_item.h>
 
+/**
+ * @brief       Round range to show.
+ *
+ * @param[in]   range       Range.
+ *
+ * @return      Rounded range.
+ */
+static Range<qint64> roundRange(const Range<Rate> &range)
+{
+    return Range<qint64>(range.min().round(), range.max().round());
+}
+
 /**
  * @brief		Constructor.
  */
@@ -57,28 +69,53 @@ void WaresItem::removeWare(const QString &macro)
         WareItem *item = *iter;
         m_macroMap.erase(iter);
         this->QTreeWidgetItem::removeChild(item);
+        delete item;
     }
 }
 
 /**
  * @brief       Update wares.
  */
-void WaresItem::update(const QMap<QString, Range<long double>> &wares)
+void WaresItem::update(const QMap<QString, Range<Rate>> &wares)
 {
     // Remove old wares.
     for (auto &key : m_macroMap.keys()) {
         if (wares.find(key) == wares.end()) {
-            this->QTreeWidgetItem::removeChild(m_macroMap[key]);
-            m_macroMap.remove(key);
+            WareItem *item = m_macroMap.take(key);
+            this->QTreeWidgetItem::removeChild(item);
+            delete item;
         }
     }
 
     // Set wares range.
     for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
-        this->setWareAmountRange(iter.key(),
-                                 Range<qint64>(qRound((double)(iter->min())),
-                                               qRound((double)(iter->max()))));
+        this->setWareAmountRange(iter.key(), roundRange(*iter));
+    }
+}
+
+/**
+ * @brief       Check if the item is showing the wares.
+ */
+bool WaresItem::isShowing(const QMap<QString, Range<Rate>> &wares) const
+{
+    if (wares.size() != m_macroMap.size()) {
+        return false;
+    }
+
+    for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
+        auto itemIter = m_macroMap.find(iter.key());
+        if (itemIter == m_macroMap.end()) {
+            return false;
+        }
+
+        Range<qint64> range = roundRange(*iter);
+        if (range.min() != (*itemIter)->range().min()
+            || range.max() != (*itemIter)->range().max()) {
+            return false;
+        }
     }
+
+    return true;
 }
 
 /**
@@ -0,0 +1,313 @@
+#include <algorithm>
+
+#include <QtWidgets/QHeaderView>
+
+#include <game_data/game_data.h>
+#include <locale/string_table.h>
+#include <ui/main_window/editor_widget/what_if_dialog.h>
+
+/// Variants can be evaluated at a time.
+#define WHAT_IF_MAX_VARIANTS 1000000
+
+/// Variants shown.
+#define WHAT_IF_MAX_RESULTS 1000
+
+/**
+ * @brief		Constructor.
+ */
+WhatIfDialog::WhatIfDialog(::std::shared_ptr<Save> save, QWidget *parent) :
+    QDialog(parent), m_evaluateSerial(0), m_evaluating(false)
+{
+    auto gameData = GameData::instance();
+    m_variants    = ::std::make_shared<StationVariants>(
+        gameData->stationModules()->table(), gameData->wares(), save);
+
+    m_layout = new QGridLayout(this);
+    this->setLayout(m_layout);
+
+    // Modules.
+    m_treeModules = new QTreeWidget(this);
+    m_layout->addWidget(m_treeModules, 0, 0, 1, 4);
+    m_treeModules->header()->setSectionResizeMode(
+        QHeaderView::ResizeMode::ResizeToContents);
+    m_treeModules->header()->setStretchLastSection(true);
+    m_treeModules->setColumnCount(2);
+    m_treeModules->setRootIsDecorated(false);
+    const auto &amounts = m_variants->amounts();
+    for (auto iter = amounts.begin(); iter != amounts.end(); ++iter) {
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setFlags(Qt::ItemFlag::ItemIsEnabled
+                       | Qt::ItemFlag::ItemIsUserCheckable);
+        item->setCheckState(0, Qt::CheckState::Unchecked);
+        item->setData(0, Qt::ItemDataRole::UserRole, iter.key());
+        item->setText(0, moduleName(iter.key()));
+        item->setText(1, QString::number(*iter));
+        m_treeModules->addTopLevelItem(item);
+    }
+    this->connect(m_treeModules, &QTreeWidget::itemChanged, this,
+                  [this](QTreeWidgetItem *, int) -> void {
+                      this->updateSweeps();
+                  });
+
+    // Options.
+    m_lblRange = new QLabel(this);
+    m_layout->addWidget(m_lblRange, 1, 0);
+
+    m_spinRange = new QSpinBox(this);
+    m_spinRange->setRange(0, 10);
+    m_spinRange->setValue(1);
+    m_layout->addWidget(m_spinRange, 1, 1);
+    this->connect(m_spinRange, QOverload<int>::of(&QSpinBox::valueChanged),
+                  this, [this](int) -> void {
+                      this->updateSweeps();
+                  });
+
+    m_chkRaces = new QCheckBox(this);
+    m_layout->addWidget(m_chkRaces, 1, 2, 1, 2);
+    this->connect(m_chkRaces, &QCheckBox::toggled, this,
+                  [this](bool) -> void {
+                      this->updateSweeps();
+                  });
+
+    m_lblRankBy = new QLabel(this);
+    m_layout->addWidget(m_lblRankBy, 2, 0);
+
+    m_comboRankBy = new QComboBox(this);
+    m_layout->addWidget(m_comboRankBy, 2, 1);
+
+    m_lblCount = new QLabel(this);
+    m_layout->addWidget(m_lblCount, 2, 2);
+
+    m_btnEvaluate = new QPushButton(this);
+    m_layout->addWidget(m_btnEvaluate, 2, 3);
+    this->connect(m_btnEvaluate, &QPushButton::clicked, this,
+                  &WhatIfDialog::onBtnEvaluateClicked);
+
+    // Results.
+    m_treeResults = new QTreeWidget(this);
+    m_layout->addWidget(m_treeResults, 3, 0, 1, 4);
+    m_treeResults->header()->setSectionResizeMode(
+        QHeaderView::ResizeMode::ResizeToContents);
+    m_treeResults->header()->setStretchLastSection(true);
+    m_treeResults->setColumnCount(7);
+    m_treeResults->setRootIsDecorated(false);
+    m_layout->setRowStretch(0, 1);
+    m_layout->setRowStretch(3, 2);
+
+    m_evaluateTask = new BackgroundTask(BackgroundTask::RunType::Newest, this);
+
+    // Change language.
+    this->connect(StringTable::instance().get(), &StringTable::languageChanged,
+                  this, &WhatIfDialog::onLanguageChanged);
+
+    this->onLanguageChanged();
+    this->resize(800, 600);
+}
+
+/**
+ * @brief		Destructor.
+ */
+WhatIfDialog::~WhatIfDialog()
+{
+    // Stop evaluating before the members used by the task are destroyed.
+    ++m_evaluateSerial;
+    delete m_evaluateTask;
+}
+
+/**
+ * @brief		Make sweeps from the options.
+ */
+void WhatIfDialog::updateSweeps()
+{
+    typedef GameStationModules::StationModule StationModule;
+    m_variants->clearSweeps();
+
+    // Amounts of checked modules.
+    qint64 range = m_spinRange->value();
+    for (int i = 0; i < m_treeModules->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *item = m_treeModules->topLevelItem(i);
+        if (item->checkState(0) == Qt::CheckState::Checked) {
+            m_variants->addAmountSweep(
+                item->data(0, Qt::ItemDataRole::UserRole).toString(), -range,
+                range);
+        }
+    }
+
+    // Habitations of other races with the same capacity.
+    if (m_chkRaces->isChecked()) {
+        auto stationModules = GameData::instance()->stationModules();
+        const auto &amounts = m_variants->amounts();
+        for (auto iter = amounts.begin(); iter != amounts.end(); ++iter) {
+            auto module = stationModules->module(iter.key());
+            if (module == nullptr
+                || module->moduleClass
+                       != StationModule::StationModuleClass::Habitation) {
+                continue;
+            }
+
+            QStringList alternatives;
+            for (const auto &alternative : stationModules->modules()) {
+                if (alternative->moduleClass == module->moduleClass
+                    && alternative->races != module->races
+                    && alternative->counters
+                               [StationModule::SupplyWorkforceAmount]
+                           == module->counters
+                               [StationModule::SupplyWorkforceAmount]) {
+                    alternatives.append(alternative->macro);
+                }
+            }
+            m_variants->addReplaceSweep(iter.key(), alternatives);
+        }
+    }
+
+    // Count.
+    quint64 count = m_variants->count();
+    m_lblCount->setText(STR("STR_WHAT_IF_VARIANTS").arg(count));
+    m_btnEvaluate->setEnabled(count <= WHAT_IF_MAX_VARIANTS);
+}
+
+/**
+ * @brief		Get name of a module.
+ */
+QString WhatIfDialog::moduleName(const QString &macro)
+{
+    auto module = GameData::instance()->stationModules()->module(macro);
+    return module == nullptr
+               ? macro
+               : GameData::instance()->texts()->text(module->name);
+}
+
+/**
+ * @brief		Change language.
+ */
+void WhatIfDialog::onLanguageChanged()
+{
+    this->setWindowTitle(STR("STR_TITLE_WHAT_IF"));
+
+    // Modules.
+    m_treeModules->setHeaderLabels(
+        {STR("STR_WHAT_IF_MODULE"), STR("STR_WHAT_IF_AMOUNT")});
+    for (int i = 0; i < m_treeModules->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *item = m_treeModules->topLevelItem(i);
+        item->setText(0, moduleName(item->data(0, Qt::ItemDataRole::UserRole)
+                                        .toString()));
+    }
+
+    // Options.
+    m_lblRange->setText(STR("STR_WHAT_IF_RANGE"));
+    m_chkRaces->setText(STR("STR_WHAT_IF_RACES"));
+    m_lblRankBy->setText(STR("STR_WHAT_IF_RANK_BY"));
+    int rankBy = ::std::max(m_comboRankBy->currentIndex(), 0);
+    m_comboRankBy->clear();
+    m_comboRankBy->addItem(STR("STR_WHAT_IF_RANK_SURPLUS"),
+                           static_cast<int>(StationVariants::RankBy::Surplus));
+    m_comboRankBy->addItem(STR("STR_WHAT_IF_RANK_COST"),
+                           static_cast<int>(StationVariants::RankBy::Cost));
+    m_comboRankBy->addItem(
+        STR("STR_WHAT_IF_RANK_THROUGHPUT"),
+        static_cast<int>(StationVariants::RankBy::Throughput));
+    m_comboRankBy->setCurrentIndex(rankBy);
+    m_btnEvaluate->setText(m_evaluating ? STR("STR_BTN_CANCEL")
+                                        : STR("STR_BTN_EVALUATE"));
+
+    // Results.
+    m_treeResults->setHeaderLabels(
+        {STR("STR_WHAT_IF_CHANGES"), STR("STR_WHAT_IF_RANK_SURPLUS"),
+         STR("STR_WHAT_IF_RANK_COST"), STR("STR_WHAT_IF_RANK_THROUGHPUT"),
+         STR("STR_SUMMARY_WORKFORCE"), STR("STR_SUMMARY_SURPLUS_WORKFORCE"),
+         STR("STR_WHAT_IF_WARNINGS")});
+
+    this->updateSweeps();
+}
+
+/**
+ * @brief		Enable or disable options while evaluating.
+ */
+void WhatIfDialog::setEvaluating(bool evaluating)
+{
+    m_evaluating = evaluating;
+    m_treeModules->setEnabled(! evaluating);
+    m_spinRange->setEnabled(! evaluating);
+    m_chkRaces->setEnabled(! evaluating);
+    m_comboRankBy->setEnabled(! evaluating);
+    m_btnEvaluate->setText(evaluating ? STR("STR_BTN_CANCEL")
+                                      : STR("STR_BTN_EVALUATE"));
+}
+
+/**
+ * @brief		Show evaluated variants.
+ */
+void WhatIfDialog::onVariantsEvaluated(
+    const QVector<StationVariants::Variant> &variants,
+    quint64                                  serial)
+{
+    // Skip if cancelled or a newer evaluation is running.
+    if (serial != m_evaluateSerial) {
+        return;
+    }
+    this->setEvaluating(false);
+
+    m_treeResults->clear();
+    for (const auto &variant : variants) {
+        // Changes.
+        QStringList changes;
+        for (auto iter = variant.changes.begin();
+             iter != variant.changes.end(); ++iter) {
+            changes.append(QString("%1%2 %3")
+                               .arg(*iter > 0 ? "+" : "")
+                               .arg(*iter)
+                               .arg(moduleName(iter.key())));
+        }
+        if (changes.empty()) {
+            changes.append(STR("STR_WHAT_IF_BASE"));
+        }
+
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setFlags(Qt::ItemFlag::ItemIsEnabled);
+        item->setText(0, changes.join(", "));
+        item->setText(1, QString("%1 CR/h").arg(variant.surplus));
+        item->setText(2, QString("%1 CR/h").arg(variant.cost));
+        item->setText(3, QString("%1 CR/h").arg(variant.throughput));
+        item->setText(4, QString::number(variant.workforce));
+        item->setText(5, QString::number(variant.surplusWorkforce));
+        item->setText(6, QString::number(variant.warnings));
+        m_treeResults->addTopLevelItem(item);
+    }
+}
+
+/**
+ * @brief		On button "Evaluate" clicked, cancels the evaluation if
+ *				evaluating.
+ */
+void WhatIfDialog::onBtnEvaluateClicked()
+{
+    if (m_evaluating) {
+        ++m_evaluateSerial;
+        m_evaluateTask->cancle();
+        this->setEvaluating(false);
+        return;
+    }
+
+    // Evaluate a copy in background, only the best variants shown are kept.
+    auto rankBy = static_cast<StationVariants::RankBy>(
+        m_comboRankBy->currentData().toInt());
+    auto    variants = ::std::make_shared<StationVariants>(*m_variants);
+    quint64 serial   = ++m_evaluateSerial;
+    this->setEvaluating(true);
+    m_evaluateTask->runTask([this, variants, rankBy, serial]() -> void {
+        auto result = variants->evaluate(rankBy, WHAT_IF_MAX_RESULTS,
+                                         [this, serial]() -> bool {
+                                             return serial != m_evaluateSerial;
+                                         });
+        if (serial != m_evaluateSerial) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, result, serial]() -> void {
+                this->onVariantsEvaluated(result, serial);
+            },
+            Qt::ConnectionType::QueuedConnection);
+    });
+}
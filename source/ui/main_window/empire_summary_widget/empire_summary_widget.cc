@@ -0,0 +1,436 @@
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+
+#include <config.h>
+#include <game_data/game_data.h>
+#include <locale/string_table.h>
+#include <summary/station_summary.h>
+#include <ui/main_window/editor_widget/editor_widget.h>
+#include <ui/main_window/empire_summary_widget/empire_summary_widget.h>
+
+/**
+ * @brief       Format range to show.
+ *
+ * @param[in]   range       Range.
+ *
+ * @return      Text.
+ */
+static QString formatRange(const Range<Rate> &range)
+{
+    return QString("%1/h - %2/h")
+        .arg(range.min().round())
+        .arg(range.max().round());
+}
+
+/**
+ * @brief		Constructor.
+ */
+EmpireSummaryWidget::EmpireSummaryWidget(QAction *       statusAction,
+                                         QWidget *       parent,
+                                         Qt::WindowFlags flags) :
+    ActionControlDockWidget(statusAction, parent, flags)
+{
+    m_widget = new QWidget(this);
+    this->setWidget(m_widget);
+
+    m_layout = new QGridLayout(m_widget);
+    m_widget->setLayout(m_layout);
+
+    m_btnAddFolder = new QPushButton(m_widget);
+    m_layout->addWidget(m_btnAddFolder, 0, 0);
+    this->connect(m_btnAddFolder, &QPushButton::clicked, this,
+                  &EmpireSummaryWidget::onBtnAddFolderClicked);
+
+    m_btnClearFolders = new QPushButton(m_widget);
+    m_layout->addWidget(m_btnClearFolders, 0, 1);
+    m_btnClearFolders->setEnabled(false);
+    this->connect(m_btnClearFolders, &QPushButton::clicked, this,
+                  &EmpireSummaryWidget::onBtnClearFoldersClicked);
+
+    m_treeSummary = new QTreeWidget(m_widget);
+    m_layout->addWidget(m_treeSummary, 1, 0, 1, 3);
+    m_treeSummary->header()->setSectionResizeMode(
+        QHeaderView::ResizeMode::ResizeToContents);
+    m_treeSummary->header()->setStretchLastSection(true);
+    m_treeSummary->setColumnCount(5);
+    m_treeSummary->setSelectionMode(
+        QAbstractItemView::SelectionMode::SingleSelection);
+    m_treeSummary->setSortingEnabled(true);
+    m_treeSummary->sortByColumn(0, Qt::SortOrder::AscendingOrder);
+
+    // Style
+    this->setFeatures(QDockWidget::DockWidgetFeature::DockWidgetClosable
+                      | QDockWidget::DockWidgetFeature::DockWidgetMovable);
+
+    // Change language.
+    this->connect(StringTable::instance().get(), &StringTable::languageChanged,
+                  this, &EmpireSummaryWidget::onLanguageChanged);
+
+    // Reload game data.
+    this->connect(GameData::instance().get(), &GameData::dataReloaded, this,
+                  &EmpireSummaryWidget::onDataReloaded);
+
+    this->onLanguageChanged();
+}
+
+/**
+ * @brief		Add an editor.
+ */
+void EmpireSummaryWidget::addEditor(EditorWidget *editor)
+{
+    QString key = editorKey(editor);
+
+    // The station in the editor replaces the same file in folders.
+    for (const auto &stationKey : m_stations.keys()) {
+        if (stationKey.startsWith("file:")
+            && EditorWidget::getEditorWidgetByPath(stationKey.mid(5))
+                   == editor) {
+            this->removeStation(stationKey);
+        }
+    }
+
+    this->connect(
+        editor, &EditorWidget::waresChanged, this,
+        [this, key](EditorWidget *                    editor,
+                    QMap<QString, Range<Rate>> wares) -> void {
+            this->setStation(key, editor->windowTitle(), wares);
+        });
+    this->connect(editor, &EditorWidget::windowTitleChanged, this,
+                  [this, key](const QString &title) -> void {
+                      this->renameStation(key, title);
+                  });
+    // Saves in folders are loaded again when they are no longer opened.
+    m_editorPaths[key] = editor->path();
+    this->connect(editor, &EditorWidget::pathChanged, this,
+                  [this, key](EditorWidget *, QString oldPath,
+                              QString newPath) -> void {
+                      m_editorPaths[key] = newPath;
+                      if (this->inFolders(oldPath)
+                          || this->inFolders(newPath)) {
+                          this->loadFolders();
+                      }
+                  });
+    this->connect(editor, &QObject::destroyed, this,
+                  [this, key]() -> void {
+                      this->removeStation(key);
+                      if (this->inFolders(m_editorPaths.take(key))) {
+                          this->loadFolders();
+                      }
+                  });
+}
+
+/**
+ * @brief		Destructor.
+ */
+EmpireSummaryWidget::~EmpireSummaryWidget() {}
+
+/**
+ * @brief		Change language.
+ */
+void EmpireSummaryWidget::onLanguageChanged()
+{
+    // Title
+    this->setWindowTitle(STR("STR_EMPIRE_SUMMARY_WIDGET_TITLE"));
+
+    // Buttons
+    m_btnAddFolder->setText(STR("STR_BTN_ADD_FOLDER"));
+    m_btnClearFolders->setText(STR("STR_BTN_CLEAR_FOLDERS"));
+
+    // Header
+    m_treeSummary->setHeaderLabels({STR("STR_EMPIRE_SUMMARY_WARE"),
+                                    STR("STR_EMPIRE_SUMMARY_SUPPLY"),
+                                    STR("STR_EMPIRE_SUMMARY_DEMAND"),
+                                    STR("STR_EMPIRE_SUMMARY_NET"),
+                                    STR("STR_EMPIRE_SUMMARY_COVERAGE")});
+
+    // Wares
+    this->updateWareItems(
+        QSet<QString>(m_totals.keyBegin(), m_totals.keyEnd()));
+}
+
+/**
+ * @brief		Get key of an editor.
+ */
+QString EmpireSummaryWidget::editorKey(const QObject *editor)
+{
+    return QString("editor:%1").arg(reinterpret_cast<quintptr>(editor));
+}
+
+/**
+ * @brief		Compute net rates of wares of a save.
+ */
+QMap<QString, Range<Rate>>
+    EmpireSummaryWidget::computeWares(::std::shared_ptr<Save> save)
+{
+    StationSummary summary;
+    summary.reset(GameData::instance()->stationModules()->table(), save);
+
+    return StationSummary::netWares(summary.make());
+}
+
+/**
+ * @brief		Set net rates of a station.
+ */
+void EmpireSummaryWidget::setStation(const QString &                   key,
+                                     const QString &                   name,
+                                     const QMap<QString, Range<Rate>> &wares)
+{
+    // Add rates of the station to totals, supply and demand are split on
+    // each boundary.
+    auto addRate = [this, &key](const QString &    ware,
+                                const Range<Rate> &rate, qint64 sign) -> void {
+        auto iter = m_totals.find(ware);
+        if (iter == m_totals.end()) {
+            iter = m_totals.insert(ware, {Range<Rate>(), Range<Rate>(), {}});
+        }
+        iter->supply.setRange(
+            iter->supply.min() + ::std::max(rate.min(), Rate()) * sign,
+            iter->supply.max() + ::std::max(rate.max(), Rate()) * sign);
+        iter->demand.setRange(
+            iter->demand.min() + ::std::max(-rate.min(), Rate()) * sign,
+            iter->demand.max() + ::std::max(-rate.max(), Rate()) * sign);
+
+        // Remove the ware when no station uses it.
+        if (sign > 0) {
+            iter->stations[key] = rate;
+        } else {
+            iter->stations.remove(key);
+            if (iter->stations.empty()) {
+                m_totals.erase(iter);
+            }
+        }
+    };
+
+    auto &        station = m_stations[key];
+    QSet<QString> changed;
+    for (auto iter = station.wares.begin(); iter != station.wares.end();
+         ++iter) {
+        auto newIter = wares.find(iter.key());
+        if (newIter == wares.end() || *newIter != *iter) {
+            addRate(iter.key(), *iter, -1);
+            changed.insert(iter.key());
+        }
+    }
+    for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
+        auto oldIter = station.wares.find(iter.key());
+        if (oldIter == station.wares.end() || *oldIter != *iter) {
+            addRate(iter.key(), *iter, 1);
+            changed.insert(iter.key());
+        }
+    }
+    station.wares = wares;
+
+    // Name of the station is shown in all of its wares.
+    if (station.name != name) {
+        station.name = name;
+        for (auto iter = wares.begin(); iter != wares.end(); ++iter) {
+            changed.insert(iter.key());
+        }
+    }
+
+    this->updateWareItems(changed);
+}
+
+/**
+ * @brief		Remove a station.
+ */
+void EmpireSummaryWidget::removeStation(const QString &key)
+{
+    auto iter = m_stations.find(key);
+    if (iter == m_stations.end()) {
+        return;
+    }
+
+    this->setStation(key, iter->name, {});
+    m_stations.remove(key);
+}
+
+/**
+ * @brief		Rename a station.
+ */
+void EmpireSummaryWidget::renameStation(const QString &key,
+                                        const QString &name)
+{
+    auto iter = m_stations.find(key);
+    if (iter == m_stations.end() || iter->name == name) {
+        return;
+    }
+
+    iter->name = name;
+    this->updateWareItems(
+        QSet<QString>(iter->wares.keyBegin(), iter->wares.keyEnd()));
+}
+
+/**
+ * @brief		Load saves in folders.
+ */
+void EmpireSummaryWidget::loadFolders()
+{
+    // Remove stations loaded from folders.
+    for (const auto &key : m_stations.keys()) {
+        if (key.startsWith("file:")) {
+            this->removeStation(key);
+        }
+    }
+
+    // Load saves, those opened in editors are followed by the editors.
+    for (const auto &folder : m_folders) {
+        for (const auto &info : QDir(folder).entryInfoList(
+                 {"*.x4station"}, QDir::Filter::Files, QDir::SortFlag::Name)) {
+            QString path = info.absoluteFilePath();
+            if (EditorWidget::getEditorWidgetByPath(path) != nullptr) {
+                continue;
+            }
+
+            auto save = Save::load(path);
+            if (save == nullptr) {
+                qWarning() << "Failed to load save" << path;
+                continue;
+            }
+            this->setStation(QString("file:%1").arg(path), info.fileName(),
+                             computeWares(save));
+        }
+    }
+
+    m_btnClearFolders->setEnabled(! m_folders.empty());
+}
+
+/**
+ * @brief		Check if a save is in the folders.
+ */
+bool EmpireSummaryWidget::inFolders(const QString &path) const
+{
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    QString dir = QFileInfo(path).absolutePath();
+    for (const auto &folder : m_folders) {
+        if (QDir(folder).absolutePath() == dir) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief		Update items of wares.
+ */
+void EmpireSummaryWidget::updateWareItems(const QSet<QString> &wares)
+{
+    if (wares.empty()) {
+        return;
+    }
+
+    m_treeSummary->setUpdatesEnabled(false);
+    m_treeSummary->setSortingEnabled(false);
+    for (const auto &ware : wares) {
+        this->updateWareItem(ware);
+    }
+    m_treeSummary->setSortingEnabled(true);
+    m_treeSummary->setUpdatesEnabled(true);
+}
+
+/**
+ * @brief		Update item of a ware.
+ */
+void EmpireSummaryWidget::updateWareItem(const QString &ware)
+{
+    auto totalIter = m_totals.find(ware);
+    auto itemIter  = m_wareItems.find(ware);
+
+    // Remove.
+    if (totalIter == m_totals.end()) {
+        if (itemIter != m_wareItems.end()) {
+            delete *itemIter;
+            m_wareItems.erase(itemIter);
+        }
+        return;
+    }
+
+    // Create.
+    QTreeWidgetItem *item;
+    if (itemIter == m_wareItems.end()) {
+        item = new QTreeWidgetItem();
+        item->setFlags(Qt::ItemFlag::ItemIsEnabled);
+        m_treeSummary->addTopLevelItem(item);
+        m_wareItems[ware] = item;
+    } else {
+        item = *itemIter;
+    }
+
+    // Totals.
+    const WareTotal &total = *totalIter;
+    item->setText(0, GameData::instance()->texts()->text(
+                         GameData::instance()->wares()->ware(ware)->name));
+    item->setText(1, formatRange(total.supply));
+    item->setText(2, formatRange(total.demand));
+    item->setText(3, formatRange(Range<Rate>(
+                         total.supply.min() - total.demand.min(),
+                         total.supply.max() - total.demand.max())));
+    if (total.demand.max() > Rate() && total.supply.max() > Rate()) {
+        item->setText(
+            4, QString("%1%").arg(qRound(
+                   ::std::min(total.supply.max().toDouble()
+                                  / total.demand.max().toDouble(),
+                              1.0)
+                   * 100)));
+    } else {
+        item->setText(4, "");
+    }
+
+    // Stations.
+    qDeleteAll(item->takeChildren());
+    for (auto iter = total.stations.begin(); iter != total.stations.end();
+         ++iter) {
+        QTreeWidgetItem *stationItem = new QTreeWidgetItem(item);
+        stationItem->setFlags(Qt::ItemFlag::ItemIsEnabled);
+        stationItem->setText(0, m_stations[iter.key()].name);
+        if (iter->max() >= Rate()) {
+            stationItem->setText(1, formatRange(*iter));
+        } else {
+            stationItem->setText(
+                2, formatRange(Range<Rate>(-iter->min(), -iter->max())));
+        }
+    }
+}
+
+/**
+ * @brief		On button "Add Folder" clicked.
+ */
+void EmpireSummaryWidget::onBtnAddFolderClicked()
+{
+    QString folder = QFileDialog::getExistingDirectory(
+        this, STR("STR_TITLE_SELECT_FOLDER"),
+        Config::instance()->getString("/openPath", QDir::homePath()));
+    if (folder == "" || m_folders.contains(folder)) {
+        return;
+    }
+
+    m_folders.append(folder);
+    this->loadFolders();
+}
+
+/**
+ * @brief		On button "Clear Folders" clicked.
+ */
+void EmpireSummaryWidget::onBtnClearFoldersClicked()
+{
+    m_folders.clear();
+    this->loadFolders();
+}
+
+/**
+ * @brief		Reload game data.
+ */
+void EmpireSummaryWidget::onDataReloaded()
+{
+    this->loadFolders();
+    this->onLanguageChanged();
+}
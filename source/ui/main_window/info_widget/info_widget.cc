@@ -5,6 +5,8 @@
 
 #include <common/generic_string.h>
 #include <game_data/game_data.h>
+#include <game_data/game_station_module_table.h>
+#include <game_data/game_ware_graph.h>
 #include <locale/string_table.h>
 #include <ui/main_window/info_widget/info_item.h>
 #include <ui/main_window/info_widget/info_widget.h>
@@ -57,6 +59,10 @@ InfoWidget::InfoWidget(QAction *       statusAction,
     this->connect(StringTable::instance().get(), &StringTable::languageChanged,
                   this, &InfoWidget::onLanguageChanged);
 
+    // Reload game data.
+    this->connect(GameData::instance().get(), &GameData::dataReloaded, this,
+                  &InfoWidget::update);
+
     this->onLanguageChanged();
 }
 
@@ -183,6 +189,9 @@ void InfoWidget::updateModule(const QString &macro)
 {
     auto module = GameData::instance()->stationModules()->module(macro);
     auto texts  = GameData::instance()->texts();
+    if (module == nullptr) {
+        return;
+    }
 
     // Basical information
     // Name
@@ -732,6 +741,35 @@ void InfoWidget::updateWare(const QString &macro)
                        ::std::unique_ptr<GenericString>(
                            new QtString(QString("%1 CR").arg(ware->maxPrice))));
     m_treeInfo->addTopLevelItem(maxPriceItem);
+
+    // Producers and consumers
+    auto   table     = GameData::instance()->stationModules()->table();
+    auto   wareGraph = GameData::instance()->stationModules()->wareGraph();
+    qint64 id        = wareGraph->id(macro);
+    if (id < 0) {
+        return;
+    }
+    auto addModules = [&](const QString &               title,
+                          const GameWareGraph::IDRange &modules) -> void {
+        if (modules.empty()) {
+            return;
+        }
+        QTreeWidgetItem *modulesItem = new InfoItem(
+            ::std::unique_ptr<GenericString>(new LocaleString(title)));
+        for (quint32 moduleID : modules) {
+            auto      module      = table->module(moduleID);
+            QString   moduleMacro = module->macro;
+            InfoItem *moduleItem  = new InfoItem(
+                ::std::unique_ptr<GenericString>(new GameString(module->name)),
+                [this, moduleMacro](int) -> void {
+                    this->showStationModuleInfo(moduleMacro, true);
+                });
+            modulesItem->addChild(moduleItem);
+        }
+        m_treeInfo->addTopLevelItem(modulesItem);
+    };
+    addModules("STR_INFO_PRODUCED_BY", wareGraph->producers(id));
+    addModules("STR_INFO_CONSUMED_BY", wareGraph->consumers(id));
 }
 
 /**
@@ -98,6 +98,21 @@ MainWindow::MainWindow() : QMainWindow(nullptr)
             .toLocal8Bit()));
     this->restoreDockWidget(m_infoWidget);
 
+    // Empire summary widget
+    m_empireSummaryWidget
+        = new EmpireSummaryWidget(m_actionViewEmpireSummary, this);
+    this->addDockWidget(Qt::DockWidgetArea::RightDockWidgetArea,
+                        m_empireSummaryWidget, Qt::Orientation::Vertical);
+    m_empireSummaryWidget->setObjectName("empireSummaryWidget");
+
+    // Restore EmpireSummaryWidget
+    m_empireSummaryWidget->restoreGeometry(QByteArray::fromHex(
+        Config::instance()
+            ->getString("/MainWindow/EmpireSummaryWidget/geometry",
+                        m_empireSummaryWidget->saveGeometry().toHex())
+            .toLocal8Bit()));
+    this->restoreDockWidget(m_empireSummaryWidget);
+
     // Central widget
     m_centralWidget = new QMdiArea(this);
     m_centralWidget->setViewMode(QMdiArea::TabbedView);
@@ -299,6 +314,13 @@ void MainWindow::initMenuToolBar()
     m_menuEdit->addAction(m_editActions.actionEditRemove);
     m_toolbarEdit->addAction(m_editActions.actionEditRemove);
 
+    m_menuEdit->addSeparator();
+
+    // Menu "Edit->What-If Analysis".
+    m_editActions.actionEditWhatIf = new QAction(this);
+    m_editActions.actionEditWhatIf->setEnabled(false);
+    m_menuEdit->addAction(m_editActions.actionEditWhatIf);
+
     // Setting menu
     // Menu "Settings".
     m_menuSettings = new QMenu(this);
@@ -328,6 +350,10 @@ void MainWindow::initMenuToolBar()
     m_actionViewInfo = new QAction(this);
     m_menuView->addAction(m_actionViewInfo);
 
+    // Menu "View->Empire Summary".
+    m_actionViewEmpireSummary = new QAction(this);
+    m_menuView->addAction(m_actionViewEmpireSummary);
+
     // Help menu
     // Menu "Help".
     m_menuHelp = new QMenu(this);
@@ -386,6 +412,9 @@ void MainWindow::closeEvent(QCloseEvent *event)
         m_stationModulesWidget->saveGeometry().toHex());
     Config::instance()->setString("/MainWindow/InfoWidget/geometry",
                                   m_infoWidget->saveGeometry().toHex());
+    Config::instance()->setString(
+        "/MainWindow/EmpireSummaryWidget/geometry",
+        m_empireSummaryWidget->saveGeometry().toHex());
 
     // Station module widget
     m_stationModulesWidget->enableClose();
@@ -395,6 +424,10 @@ void MainWindow::closeEvent(QCloseEvent *event)
     m_infoWidget->enableClose();
     m_infoWidget->close();
 
+    // Empire summary widget
+    m_empireSummaryWidget->enableClose();
+    m_empireSummaryWidget->close();
+
     event->accept();
 }
 
@@ -424,6 +457,7 @@ void MainWindow::open(QString path)
             this->connect(editorWidget, &EditorWidget::filterByResource,
                           m_stationModulesWidget,
                           &StationModulesWidget::onFilterByResource);
+            m_empireSummaryWidget->addEditor(editorWidget);
             m_centralWidget->setActiveSubWindow(container);
             editorWidget->show();
         }
@@ -456,6 +490,7 @@ void MainWindow::newAction()
     this->connect(editorWidget, &EditorWidget::filterByResource,
                   m_stationModulesWidget,
                   &StationModulesWidget::onFilterByResource);
+    m_empireSummaryWidget->addEditor(editorWidget);
     m_centralWidget->setActiveSubWindow(container);
     editorWidget->show();
 }
@@ -484,6 +519,7 @@ void MainWindow::newFactoryWizardAction()
     this->connect(editorWidget, &EditorWidget::filterByResource,
                   m_stationModulesWidget,
                   &StationModulesWidget::onFilterByResource);
+    m_empireSummaryWidget->addEditor(editorWidget);
     m_centralWidget->setActiveSubWindow(container);
     editorWidget->show();
 }
@@ -525,6 +561,7 @@ void MainWindow::editorActived(QMdiSubWindow *window)
         m_fileActions.actionFileExportAsHTML->setEnabled(false);
         m_fileActions.actionFileClose->setEnabled(false);
         m_editActions.actionEditNewGroup->setEnabled(false);
+        m_editActions.actionEditWhatIf->setEnabled(false);
     } else {
         static_cast<EditorWidget *>(window->widget())->active();
     }
@@ -552,8 +589,9 @@ void MainWindow::askGamePath()
 
         if (GameData::instance()->checkGamePath(str)) {
             Config::instance()->setString("/gamePath", str);
+            GameData::instance()->requestReload();
             QMessageBox::information(this, STR("STR_INFO"),
-                                     STR("STR_INFO_EFFECT_NEXT_LAUNCH"));
+                                     STR("STR_INFO_RELOADING_GAME_DATA"));
             return;
         } else {
             QMessageBox::critical(this, STR("STR_ERROR"),
@@ -651,6 +689,9 @@ void MainWindow::onLanguageChanged()
     // Menu "Edit->Remove".
     m_editActions.actionEditRemove->setText(STR("STR_MENU_EDIT_REMOVE"));
 
+    // Menu "Edit->What-If Analysis".
+    m_editActions.actionEditWhatIf->setText(STR("STR_MENU_EDIT_WHAT_IF"));
+
     // Setting menu
     // Menu "Settings".
     m_menuSettings->setTitle(STR("STR_MENU_SETTINGS"));
@@ -671,6 +712,9 @@ void MainWindow::onLanguageChanged()
     // Menu "View->Info".
     m_actionViewInfo->setText(STR("STR_MENU_VIEW_INFO"));
 
+    // Menu "View->Empire Summary".
+    m_actionViewEmpireSummary->setText(STR("STR_MENU_VIEW_EMPIRE_SUMMARY"));
+
     // Help menu
     // Menu "Help".
     m_menuHelp->setTitle(STR("STR_MENU_HELP"));
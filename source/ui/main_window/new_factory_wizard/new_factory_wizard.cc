@@ -3,6 +3,7 @@
 #include <QScreen>
 
 #include <game_data/game_data.h>
+#include <game_data/game_ware_graph.h>
 #include <locale/string_table.h>
 #include <ui/main_window/new_factory_wizard/new_factory_wizard.h>
 #include <ui/main_window/new_factory_wizard/new_factory_wizard_finish_widget.h>
@@ -67,19 +68,11 @@ NewFactoryWizard::NewFactoryWizard(QWidget *parent) :
 
     this->setFixedSize(windowRect.size());
 
-    // Scan products.
-    auto wares = GameData::instance()->wares();
-    for (auto stationModule :
-         GameData::instance()->stationModules()->modules()) {
-        if (stationModule->playerModule) {
-            auto propertyIter = stationModule->properties.find(
-                GameStationModules::Property::SupplyProduct);
-            if (propertyIter != stationModule->properties.end()) {
-                ::std::shared_ptr<GameStationModules::SupplyProduct> property
-                    = ::std::static_pointer_cast<
-                        GameStationModules::SupplyProduct>(*propertyIter);
-                m_products.insert(property->product);
-            }
+    // Products, station modules are all player modules.
+    auto wareGraph = GameData::instance()->stationModules()->wareGraph();
+    for (quint32 id = 0; id < wareGraph->size(); ++id) {
+        if (! wareGraph->producers(id).empty()) {
+            m_products.insert(wareGraph->ware(id));
         }
     }
 
@@ -0,0 +1,125 @@
+#include <locale/string_table.h>
+#include <ui/main_window/station_modules_widget/station_modules_filter_model.h>
+
+/**
+ * @brief		Constructor.
+ */
+StationModulesFilterModel::StationModulesFilterModel(QObject *parent) :
+    QSortFilterProxyModel(parent),
+    m_collator(StringTable::instance()->collator())
+{}
+
+/**
+ * @brief		Destructor.
+ */
+StationModulesFilterModel::~StationModulesFilterModel() {}
+
+/**
+ * @brief		Set visible modules.
+ */
+void StationModulesFilterModel::setVisibleModules(
+    const QBitArray &   visibleModules,
+    const QVector<int> &ranks)
+{
+    if (ranks != m_ranks) {
+        m_visibleModules = visibleModules;
+        m_ranks          = ranks;
+        this->invalidate();
+    } else if (visibleModules != m_visibleModules) {
+        m_visibleModules = visibleModules;
+        this->invalidateFilter();
+    }
+}
+
+/**
+ * @brief		Set collator and sort again.
+ */
+void StationModulesFilterModel::setCollator(const QCollator &collator)
+{
+    m_collator = collator;
+    m_sortKeys.clear();
+    this->invalidate();
+}
+
+/**
+ * @brief		Set source model.
+ */
+void StationModulesFilterModel::setSourceModel(
+    QAbstractItemModel *sourceModel)
+{
+    if (this->sourceModel() != nullptr) {
+        this->disconnect(this->sourceModel(),
+                         &QAbstractItemModel::modelAboutToBeReset, this,
+                         nullptr);
+    }
+
+    // Keys are built again for the new modules before sorting.
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+    this->connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this,
+                  [this]() -> void {
+                      m_sortKeys.clear();
+                  });
+}
+
+/**
+ * @brief		Check if a row is shown.
+ */
+bool StationModulesFilterModel::filterAcceptsRow(
+    int                sourceRow,
+    const QModelIndex &sourceParent) const
+{
+    if (! sourceParent.isValid() || m_visibleModules.isEmpty()) {
+        return true;
+    }
+
+    auto   model = static_cast<StationModulesModel *>(this->sourceModel());
+    qint64 id    = model->moduleID(model->index(sourceRow, 0, sourceParent));
+    return id < m_visibleModules.size()
+           && m_visibleModules.testBit(static_cast<int>(id));
+}
+
+/**
+ * @brief		Compare rows.
+ */
+bool StationModulesFilterModel::lessThan(const QModelIndex &left,
+                                         const QModelIndex &right) const
+{
+    auto   model   = static_cast<StationModulesModel *>(this->sourceModel());
+    qint64 leftID  = model->moduleID(left);
+    qint64 rightID = model->moduleID(right);
+    if (leftID < 0 || rightID < 0) {
+        return left.row() < right.row();
+    }
+
+    // Ranks may be older than the source model during a reload.
+    if (leftID < m_ranks.size() && rightID < m_ranks.size()
+        && m_ranks[leftID] != m_ranks[rightID]) {
+        return m_ranks[leftID] < m_ranks[rightID];
+    }
+
+    if (m_sortKeys.isEmpty()) {
+        this->buildSortKeys();
+    }
+    if (leftID >= m_sortKeys.size() || rightID >= m_sortKeys.size()) {
+        return leftID < rightID;
+    }
+    return m_sortKeys[leftID].compare(m_sortKeys[rightID]) < 0;
+}
+
+/**
+ * @brief		Build sort keys of names of listed modules.
+ */
+void StationModulesFilterModel::buildSortKeys() const
+{
+    auto model = static_cast<StationModulesModel *>(this->sourceModel());
+    if (model->table() == nullptr) {
+        return;
+    }
+
+    quint32 count = model->table()->size();
+    m_sortKeys.reserve(static_cast<int>(count));
+    for (quint32 id = 0; id < count; ++id) {
+        m_sortKeys.append(m_collator.sortKey(
+            model->listed(id) ? model->name(id) : QString()));
+    }
+}
@@ -0,0 +1,247 @@
+#include <game_data/game_data.h>
+#include <locale/string_table.h>
+#include <ui/main_window/station_modules_widget/station_modules_model.h>
+
+/**
+ * @brief		Constructor.
+ */
+StationModulesModel::StationModulesModel(QObject *parent) :
+    QAbstractItemModel(parent)
+{}
+
+/**
+ * @brief		Destructor.
+ */
+StationModulesModel::~StationModulesModel() {}
+
+/**
+ * @brief		Reload station modules from game data.
+ */
+void StationModulesModel::reload()
+{
+    this->beginResetModel();
+
+    m_table       = GameData::instance()->stationModules()->table();
+    quint32 count = m_table->size();
+    m_listed.fill(false, static_cast<int>(count));
+    m_names = QVector<QString>(static_cast<int>(count));
+    for (auto &ids : m_groups) {
+        ids.clear();
+    }
+    for (quint32 id = 0; id < count; ++id) {
+        int group = StationModulesModel::group(*(m_table->module(id)));
+        if (group >= 0) {
+            m_groups[group].append(id);
+            m_listed[id] = true;
+        }
+    }
+
+    this->endResetModel();
+}
+
+/**
+ * @brief		Get station modules.
+ */
+const ::std::shared_ptr<GameStationModuleTable> &
+    StationModulesModel::table() const
+{
+    return m_table;
+}
+
+/**
+ * @brief		Check if a module is listed.
+ */
+bool StationModulesModel::listed(quint32 id) const
+{
+    return id < static_cast<quint32>(m_listed.size()) && m_listed[id];
+}
+
+/**
+ * @brief		Get ID of the module of an index.
+ */
+qint64 StationModulesModel::moduleID(const QModelIndex &index) const
+{
+    if (! index.isValid() || index.internalId() == 0) {
+        return -1;
+    }
+
+    return m_groups[index.internalId() - 1][index.row()];
+}
+
+/**
+ * @brief		Get name of a module, resolved on first use.
+ */
+const QString &StationModulesModel::name(quint32 id) const
+{
+    QString &name = m_names[id];
+    if (name.isNull()) {
+        name = GameData::instance()->texts()->text(m_table->module(id)->name);
+    }
+
+    return name;
+}
+
+/**
+ * @brief		Change language.
+ */
+void StationModulesModel::onLanguageChanged()
+{
+    // Names are resolved again when the view asks for them.
+    m_names.fill(QString());
+
+    emit this->dataChanged(this->index(0, 0),
+                           this->index(GroupCount - 1, 0));
+    for (int group = 0; group < GroupCount; ++group) {
+        if (! m_groups[group].empty()) {
+            QModelIndex parent = this->index(group, 0);
+            QModelIndex last
+                = this->index(m_groups[group].size() - 1, 0, parent);
+            emit this->dataChanged(this->index(0, 0, parent), last);
+        }
+    }
+}
+
+/**
+ * @brief		Get index.
+ */
+QModelIndex StationModulesModel::index(int                row,
+                                       int                column,
+                                       const QModelIndex &parent) const
+{
+    if (row < 0 || column != 0) {
+        return QModelIndex();
+    }
+
+    // Groups have internal ID 0, modules have the group plus 1.
+    if (! parent.isValid()) {
+        return row < GroupCount ? this->createIndex(row, column, quintptr(0))
+                                : QModelIndex();
+    } else if (parent.internalId() == 0
+               && row < m_groups[parent.row()].size()) {
+        return this->createIndex(row, column,
+                                 static_cast<quintptr>(parent.row() + 1));
+    }
+
+    return QModelIndex();
+}
+
+/**
+ * @brief		Get parent index.
+ */
+QModelIndex StationModulesModel::parent(const QModelIndex &index) const
+{
+    if (! index.isValid() || index.internalId() == 0) {
+        return QModelIndex();
+    }
+
+    return this->createIndex(static_cast<int>(index.internalId() - 1), 0,
+                             quintptr(0));
+}
+
+/**
+ * @brief		Get number of rows.
+ */
+int StationModulesModel::rowCount(const QModelIndex &parent) const
+{
+    if (! parent.isValid()) {
+        return GroupCount;
+    } else if (parent.column() == 0 && parent.internalId() == 0) {
+        return m_groups[parent.row()].size();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief		Get number of columns.
+ */
+int StationModulesModel::columnCount(const QModelIndex &) const
+{
+    return 1;
+}
+
+/**
+ * @brief		Get data.
+ */
+QVariant StationModulesModel::data(const QModelIndex &index, int role) const
+{
+    static const char *groupNames[GroupCount]
+        = {"STATION_TYPE_BUILD",      "STATION_TYPE_DOCK",
+           "STATION_TYPE_PRODUCTION", "STATION_TYPE_STORAGE",
+           "STATION_TYPE_HABITATION", "STATION_TYPE_DEFENCE",
+           "STATION_TYPE_CONNECT",    "STATION_TYPE_WELFARE",
+           "STATION_TYPE_RADAR",      "STATION_TYPE_PROCESSING"};
+
+    if (! index.isValid() || role != Qt::ItemDataRole::DisplayRole) {
+        return QVariant();
+    }
+
+    qint64 id = this->moduleID(index);
+    if (id < 0) {
+        return STR(groupNames[index.row()]);
+    }
+
+    return this->name(static_cast<quint32>(id));
+}
+
+/**
+ * @brief		Get item flags.
+ */
+Qt::ItemFlags StationModulesModel::flags(const QModelIndex &index) const
+{
+    if (this->moduleID(index) < 0) {
+        return Qt::ItemFlag::ItemIsEnabled;
+    }
+
+    return Qt::ItemFlag::ItemIsEnabled | Qt::ItemFlag::ItemIsSelectable;
+}
+
+/**
+ * @brief		Get group of a module.
+ */
+int StationModulesModel::group(const GameStationModules::StationModule &module)
+{
+    typedef GameStationModules::StationModule::StationModuleClass
+        StationModuleClass;
+
+    switch (module.moduleClass) {
+        case StationModuleClass::BuildModule:
+            return Build;
+
+        case StationModuleClass::ConnectionModule:
+            return Connect;
+
+        case StationModuleClass::DefenceModule:
+            return Defence;
+
+        case StationModuleClass::Dockarea:
+            return Dock;
+
+        case StationModuleClass::Habitation:
+            return Habitation;
+
+        case StationModuleClass::Production:
+            return module.properties.contains(
+                       GameStationModules::Property::Type::SupplyProduct)
+                       ? Production
+                       : -1;
+
+        case StationModuleClass::Welfare:
+            return Welfare;
+
+        case StationModuleClass::Radar:
+            return Radar;
+
+        case StationModuleClass::Processing:
+            return module.properties.contains(
+                       GameStationModules::Property::Type::SupplyProduct)
+                       ? Processing
+                       : -1;
+
+        case StationModuleClass::Storage:
+            return Storage;
+
+        default:
+            return -1;
+    }
+}
@@ -1,14 +1,13 @@
-#include <QtCore/QCollator>
 #include <QtCore/QDebug>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QMessageBox>
 #include <QCheckBox>
 
-#include <common/compare.h>
 #include <game_data/game_data.h>
+#include <game_data/game_station_module_table.h>
+#include <game_data/game_ware_graph.h>
 #include <locale/string_table.h>
-#include <ui/locale/q_tree_widget_item_locale.h>
 #include <ui/main_window/station_modules_widget/station_modules_widget.h>
 
 /**
@@ -16,7 +15,7 @@
  */
 StationModulesWidget::StationModulesWidget(QAction *statusAction,
                                            QWidget *parent,
-                                           Qt::WindowFlags flags) : ActionControlDockWidget(statusAction, parent, flags)
+                                           Qt::WindowFlags flags) : ActionControlDockWidget(statusAction, parent, flags), m_searchSerial(0)
 {
     // Style
     // this->setWindowFlags(Qt::WindowType::Tool);
@@ -59,7 +58,7 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     m_layoutFilters->addWidget(m_chkByRace, 0, 0);
     this->connect(m_chkByRace, &QCheckBox::stateChanged, this,
                   &StationModulesWidget::onByRaceChkChanged);
-    m_comboByRaces = new QComboBox(m_widgetFilters);
+    m_comboByRaces = new SortedComboBox(m_widgetFilters);
     m_comboByRaces->setEnabled(false);
     m_layoutFilters->addWidget(m_comboByRaces, 0, 1);
 
@@ -69,7 +68,7 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     m_layoutFilters->addWidget(m_chkByProduction, 1, 0);
     this->connect(m_chkByProduction, &QCheckBox::stateChanged, this,
                   &StationModulesWidget::onByProductionChkChanged);
-    m_comboByProduction = new QComboBox(m_widgetFilters);
+    m_comboByProduction = new SortedComboBox(m_widgetFilters);
     m_comboByProduction->setEnabled(false);
     m_layoutFilters->addWidget(m_comboByProduction, 1, 1);
 
@@ -79,7 +78,7 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     m_layoutFilters->addWidget(m_chkByResource, 2, 0);
     this->connect(m_chkByResource, &QCheckBox::stateChanged, this,
                   &StationModulesWidget::onByResourceChkChanged);
-    m_comboByResource = new QComboBox(m_widgetFilters);
+    m_comboByResource = new SortedComboBox(m_widgetFilters);
     m_comboByResource->setEnabled(false);
     m_layoutFilters->addWidget(m_comboByResource, 2, 1);
 
@@ -94,60 +93,23 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     m_layoutFilters->addWidget(m_txtKeyword, 3, 1);
 
     // Station modules.
-    m_treeStationModules = new QTreeWidget(m_widget);
+    m_modulesModel = new StationModulesModel(this);
+    m_modulesFilter = new StationModulesFilterModel(this);
+    m_modulesFilter->setSourceModel(m_modulesModel);
+    m_modulesFilter->sort(0);
+
+    m_treeStationModules = new QTreeView(m_widget);
     m_layout->addWidget(m_treeStationModules);
     m_treeStationModules->header()->setVisible(false);
+    m_treeStationModules->setUniformRowHeights(true);
     m_treeStationModules->setSelectionMode(
         QAbstractItemView::SelectionMode::ExtendedSelection);
-
-    m_itemBuild = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemBuild->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemBuild->setExpanded(false);
-
-    m_itemDock = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemDock->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemDock->setExpanded(false);
-
-    m_itemProduction = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemProduction->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemProduction->setExpanded(false);
-
-    m_itemStorage = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemStorage->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemStorage->setExpanded(false);
-
-    m_itemHabitation = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemHabitation->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemHabitation->setExpanded(false);
-
-    m_itemDefence = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemDefence->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemDefence->setExpanded(false);
-
-    m_itemConnect = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemConnect->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemConnect->setExpanded(false);
-
-    m_itemWelfare = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemWelfare->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemWelfare->setExpanded(false);
-
-    m_itemRadar = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemRadar->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemRadar->setExpanded(false);
-
-    m_itemProcessing = new QTreeWidgetItemLocale(m_treeStationModules);
-    m_itemProcessing->setFlags(Qt::ItemFlag::ItemIsEnabled);
-    m_itemProcessing->setExpanded(false);
-
-    m_treeStationModules->insertTopLevelItems(
-        0, {m_itemBuild, m_itemDock, m_itemProduction, m_itemStorage,
-            m_itemHabitation, m_itemDefence, m_itemConnect, m_itemWelfare,
-            m_itemRadar, m_itemProcessing});
+    m_treeStationModules->setModel(m_modulesFilter);
 
     this->setWidget(m_widget);
 
     // Load modules
+    m_searchTask = new BackgroundTask(BackgroundTask::RunType::Newest, this);
     this->loadStationModules();
     for (const auto &resource : m_resources)
     {
@@ -167,6 +129,10 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     this->connect(StringTable::instance().get(), &StringTable::languageChanged,
                   this, &StationModulesWidget::onLanguageChanged);
 
+    // Reload game data.
+    this->connect(GameData::instance().get(), &GameData::dataReloaded, this,
+                  &StationModulesWidget::onGameDataReloaded);
+
     m_comboByResource->setCurrentIndex(0);
     m_comboByProduction->setCurrentIndex(0);
     m_comboByRaces->setCurrentIndex(0);
@@ -198,7 +164,7 @@ StationModulesWidget::StationModulesWidget(QAction *statusAction,
     this->connect(m_btnAddToStation, &QPushButton::clicked, this,
                   &StationModulesWidget::onAddToStationClicked);
 
-    this->connect(m_treeStationModules, &QTreeWidget::itemDoubleClicked, this,
+    this->connect(m_treeStationModules, &QTreeView::doubleClicked, this,
                   &StationModulesWidget::onItemClicked);
 
     this->onLanguageChanged();
@@ -267,117 +233,198 @@ void StationModulesWidget::onFilterByResource(QString ware)
 /**
  * @brief		Destructor.
  */
-StationModulesWidget::~StationModulesWidget() {}
+StationModulesWidget::~StationModulesWidget()
+{
+    // Stop searching before the members used by the task are destroyed.
+    ++m_searchSerial;
+    delete m_searchTask;
+}
 
 /**
  * @brief	Load all station modules.
  */
 void StationModulesWidget::loadStationModules()
 {
-    using std::shared_ptr;
+    m_modulesModel->reload();
 
-    auto stationModules = GameData::instance()->stationModules()->modules();
-    for (const shared_ptr<GameStationModules::StationModule> &module : stationModules)
+    // Collect races.
+    auto table = m_modulesModel->table();
+    int count = static_cast<int>(table->size());
+    for (quint32 id = 0; id < table->size(); ++id)
     {
-        // Collect races
-        for (const auto &race : module->races)
+        if (m_modulesModel->listed(id))
         {
-            m_races.insert(race);
+            for (const auto &race : table->module(id)->races)
+            {
+                m_races.insert(race);
+            }
         }
+    }
 
-        // Create tree widget items based on module class
-        StationModulesTreeWidgetItem *item = nullptr;
-        switch (module->moduleClass)
+    // Index modules of each race, modules without races match all races.
+    m_productionModules = QBitArray(count);
+    for (const auto &race : m_races)
+    {
+        m_raceModules[race] = QBitArray(count);
+    }
+    for (quint32 id = 0; id < table->size(); ++id)
+    {
+        if (!m_modulesModel->listed(id))
         {
-        case GameStationModules::StationModule::StationModuleClass::BuildModule:
-            item = new StationModulesTreeWidgetItem(m_itemBuild, module);
-            m_itemBuild->insertChild(-1, item);
-            break;
-
-        case GameStationModules::StationModule::StationModuleClass::ConnectionModule:
-            item = new StationModulesTreeWidgetItem(m_itemConnect, module);
-            m_itemConnect->insertChild(-1, item);
-            break;
-
-        case GameStationModules::StationModule::StationModuleClass::DefenceModule:
-            item = new StationModulesTreeWidgetItem(m_itemDefence, module);
-            m_itemDefence->insertChild(-1, item);
-            break;
-
-        case GameStationModules::StationModule::StationModuleClass::Dockarea:
-            item = new StationModulesTreeWidgetItem(m_itemDock, module);
-            m_itemDock->insertChild(-1, item);
-            break;
-
-        case GameStationModules::StationModule::StationModuleClass::Habitation:
-            item = new StationModulesTreeWidgetItem(m_itemHabitation, module);
-            m_itemHabitation->insertChild(-1, item);
-            break;
-
-        case GameStationModules::StationModule::StationModuleClass::Production:
+            continue;
+        }
+
+        auto module = table->module(id);
+        if (module->moduleClass == GameStationModules::StationModule::StationModuleClass::Production)
         {
-            auto iter = module->properties.find(GameStationModules::Property::Type::SupplyProduct);
-            if (iter == module->properties.end())
+            m_productionModules.setBit(id);
+        }
+
+        if (module->races.empty())
+        {
+            for (auto &bits : m_raceModules)
             {
-                break;
+                bits.setBit(id);
             }
-
-            item = new StationModulesTreeWidgetItem(m_itemProduction, module);
-            m_itemProduction->insertChild(-1, item);
-
-            auto property = std::static_pointer_cast<GameStationModules::SupplyProduct>(*iter);
-            m_products.insert(property->product);
-
-            for (const auto &resource : property->productionInfo->resources)
+        }
+        else
+        {
+            for (const auto &race : module->races)
             {
-                m_resources.insert(resource->id);
+                m_raceModules[race].setBit(id);
             }
         }
-        break;
-
-        case GameStationModules::StationModule::StationModuleClass::Welfare:
-            item = new StationModulesTreeWidgetItem(m_itemWelfare, module);
-            m_itemWelfare->insertChild(-1, item);
-            break;
+    }
 
-        case GameStationModules::StationModule::StationModuleClass::Radar:
-            item = new StationModulesTreeWidgetItem(m_itemRadar, module);
-            m_itemRadar->insertChild(-1, item);
-            break;
+    // Collect and index products and resources of production modules.
+    auto wareGraph = GameData::instance()->stationModules()->wareGraph();
+    auto indexModules = [&](GameWareGraph::IDRange moduleIDs) -> QBitArray
+    {
+        QBitArray ret(count);
+        for (quint32 moduleID : moduleIDs)
+        {
+            ret.setBit(moduleID);
+        }
+        return ret;
+    };
+    for (quint32 id = 0; id < wareGraph->size(); ++id)
+    {
+        const QString &ware = wareGraph->ware(id);
+        if (!wareGraph->producers(id).empty())
+        {
+            m_products.insert(ware);
+            m_productModules[ware] = indexModules(wareGraph->producers(id));
+        }
 
-        case GameStationModules::StationModule::StationModuleClass::Processing:
+        for (quint32 moduleID : wareGraph->consumers(id))
         {
-            // This should be similar to Production type.
-            auto iter = module->properties.find(GameStationModules::Property::Type::SupplyProduct);
-            if (iter == module->properties.end())
+            if (table->module(moduleID)->properties.contains(
+                    GameStationModules::Property::Type::SupplyProduct))
             {
+                m_resources.insert(ware);
+                m_resourceModules[ware] = indexModules(wareGraph->consumers(id));
                 break;
             }
-            item = new StationModulesTreeWidgetItem(m_itemProcessing, module);
-            m_itemProcessing->insertChild(-1, item);
-            auto property = std::static_pointer_cast<GameStationModules::SupplyProduct>(*iter);
-            m_products.insert(property->product);
-            for (const auto &resource : property->productionInfo->resources)
+        }
+    }
+}
+
+/**
+ * @brief	Build index of names of modules, macros of modules and names of
+ *			wares for keyword search.
+ */
+void StationModulesWidget::buildSearchIndex()
+{
+    auto gameData = GameData::instance();
+    auto table = m_modulesModel->table();
+    QVector<QStringList> documents(static_cast<int>(table->size()));
+    for (quint32 id = 0; id < table->size(); ++id)
+    {
+        if (!m_modulesModel->listed(id))
+        {
+            continue;
+        }
+
+        auto module = table->module(id);
+        QStringList &fields = documents[id];
+        fields << m_modulesModel->name(id) << module->macro;
+        for (const auto &rates : {module->products, module->resources})
+        {
+            for (const auto &rate : rates)
             {
-                m_resources.insert(resource->id);
+                auto ware = gameData->wares()->ware(rate.ware);
+                if (ware != nullptr)
+                {
+                    fields.append(gameData->texts()->text(ware->name));
+                }
             }
         }
-        break;
+    }
 
-        case GameStationModules::StationModule::StationModuleClass::Storage:
-            item = new StationModulesTreeWidgetItem(m_itemStorage, module);
-            m_itemStorage->insertChild(-1, item);
-            break;
+    m_searchIndex = ::std::make_shared<FuzzyIndex>(documents);
+}
 
-        default:
-            break;
-        }
+/**
+ * @brief		Search modules in background.
+ */
+void StationModulesWidget::searchModules(const QString &query)
+{
+    if (m_searchIndex == nullptr)
+    {
+        this->buildSearchIndex();
+    }
 
-        if (item)
+    m_searchQuery = query;
+    quint64 serial = ++m_searchSerial;
+    ::std::shared_ptr<FuzzyIndex> index = m_searchIndex;
+    m_searchTask->runTask(
+        [this, index, query, serial]() -> void
         {
-            m_moduleItems.push_back(item);
+            auto matches = index->search(query,
+                                         [this, serial]() -> bool
+                                         {
+                                             return serial != m_searchSerial;
+                                         });
+            if (serial != m_searchSerial)
+            {
+                return;
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [this, matches, serial]() -> void
+                {
+                    this->onModulesSearched(matches, serial);
+                },
+                Qt::ConnectionType::QueuedConnection);
+        });
+}
+
+/**
+ * @brief		Apply results of a search.
+ */
+void StationModulesWidget::onModulesSearched(const QVector<FuzzyIndex::Match> &matches,
+                                             quint64 serial)
+{
+    // Skip if a newer search is running.
+    if (serial != m_searchSerial)
+    {
+        return;
+    }
+
+    int count = m_productionModules.size();
+    m_keywordModules = QBitArray(count);
+    m_keywordRanks = QVector<int>(count, 0);
+    for (int i = 0; i < matches.size(); ++i)
+    {
+        if (matches[i].id < static_cast<quint32>(count))
+        {
+            m_keywordModules.setBit(matches[i].id);
+            m_keywordRanks[matches[i].id] = i;
         }
     }
+
+    this->filterModules();
 }
 
 /**
@@ -402,98 +449,35 @@ void StationModulesWidget::onLanguageChanged()
     m_btnAddToStation->setText(STR("STR_ADD_TO_STATION"));
 
     // Filters.
-    m_chkByRace->setText(STR("STR_BY_RACE"));
-    for (int i = 0; i < m_comboByRaces->count(); ++i)
+    auto wareName = [&](const QVariant &id) -> QString
     {
-        QString id = m_comboByRaces->itemData(i).toString();
-        m_comboByRaces->setItemText(
-            i, gameTexts->text(GameData::instance()->races()->race(id).name));
-    }
-    this->sortComboBox(m_comboByRaces);
+        return gameTexts->text(GameData::instance()->wares()->ware(id.toString())->name);
+    };
+    m_chkByRace->setText(STR("STR_BY_RACE"));
+    m_comboByRaces->setItemTexts(
+        [&](const QVariant &id) -> QString
+        {
+            return gameTexts->text(GameData::instance()->races()->race(id.toString()).name);
+        });
     m_chkByProduction->setText(STR("STR_BY_PRODUCT"));
-    for (int i = 0; i < m_comboByProduction->count(); ++i)
-    {
-        QString id = m_comboByProduction->itemData(i).toString();
-        m_comboByProduction->setItemText(
-            i, gameTexts->text(GameData::instance()->wares()->ware(id)->name));
-    }
-    this->sortComboBox(m_comboByProduction);
+    m_comboByProduction->setItemTexts(wareName);
 
     m_chkByResource->setText(STR("STR_BY_RESOURCE"));
-    for (int i = 0; i < m_comboByResource->count(); ++i)
-    {
-        QString id = m_comboByResource->itemData(i).toString();
-        m_comboByResource->setItemText(
-            i, gameTexts->text(GameData::instance()->wares()->ware(id)->name));
-    }
-    this->sortComboBox(m_comboByResource);
+    m_comboByResource->setItemTexts(wareName);
 
     m_chkByKeyword->setText(STR("STR_BY_KEYWORD"));
 
-    // Station modules.
-    m_itemBuild->setText(0, STR("STATION_TYPE_BUILD"));
-    m_itemDock->setText(0, STR("STATION_TYPE_DOCK"));
-    m_itemProduction->setText(0, STR("STATION_TYPE_PRODUCTION"));
-    m_itemStorage->setText(0, STR("STATION_TYPE_STORAGE"));
-    m_itemHabitation->setText(0, STR("STATION_TYPE_HABITATION"));
-    m_itemDefence->setText(0, STR("STATION_TYPE_DEFENCE"));
-    m_itemConnect->setText(0, STR("STATION_TYPE_CONNECT"));
-    m_itemRadar->setText(0, STR("STATION_TYPE_RADAR"));
-    m_itemProcessing->setText(0, STR("STATION_TYPE_PROCESSING"));
-    m_itemWelfare->setText(0, STR("STATION_TYPE_WELFARE"));
-    
-
-    // Items
-    for (auto module : m_moduleItems)
-    {
-        module->onLanguageChanged();
-    }
-
-    m_itemBuild->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemDock->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemProduction->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemStorage->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemHabitation->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemDefence->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemConnect->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemRadar->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemProcessing->sortChildren(0, Qt::SortOrder::AscendingOrder);
-    m_itemWelfare->sortChildren(0, Qt::SortOrder::AscendingOrder);
-}
+    // Station modules, names are resolved again when shown.
+    m_modulesModel->onLanguageChanged();
+    m_modulesFilter->setCollator(StringTable::instance()->collator());
 
-/**
- * @brief	Sort combobox.
- */
-void StationModulesWidget::sortComboBox(QComboBox *combo)
-{
-    QCollator collator = StringTable::instance()->collator();
-    int index = combo->currentIndex();
-    for (int i = 0; i < combo->count(); ++i)
+    // Search again with names in the new language.
+    m_searchIndex = nullptr;
+    if (!m_searchQuery.isNull())
     {
-        for (int j = i + 1; j < combo->count(); ++j)
-        {
-            if (collator.compare(combo->itemText(i), combo->itemText(j)) > 0)
-            {
-                // Swap
-                QVariant v = combo->itemData(i);
-                QString s = combo->itemText(i);
-                combo->setItemData(i, combo->itemData(j));
-                combo->setItemText(i, combo->itemText(j));
-                combo->setItemData(j, v);
-                combo->setItemText(j, s);
-                if (index == i)
-                {
-                    index = j;
-                }
-                else if (index == j)
-                {
-                    index = i;
-                }
-            }
-        }
+        m_searchQuery = QString();
+        this->filterModules();
     }
-
-    combo->setCurrentIndex(index);
 }
 
 /**
@@ -501,67 +485,56 @@ void StationModulesWidget::sortComboBox(QComboBox *combo)
  */
 void StationModulesWidget::filterModules()
 {
-    for (auto &moduleItem : m_moduleItems)
+    // Intersect the indices of the checked filters. Non-production modules
+    // are not filtered by product or resource.
+    int count = m_productionModules.size();
+    QBitArray visible(count, true);
+    if (m_chkByRace->isChecked())
     {
-        if (m_chkByRace->isChecked())
-        {
-            if ((!moduleItem->module()->races.empty()) && moduleItem->module()->races.find(
-                                                              m_comboByRaces->currentData().toString()) == moduleItem->module()->races.end())
-            {
-                moduleItem->setHidden(true);
-                continue;
-            }
-        }
+        visible &= m_raceModules.value(m_comboByRaces->currentData().toString(), QBitArray(count));
+    }
+
+    if (m_chkByResource->isChecked())
+    {
+        visible &= m_resourceModules.value(m_comboByResource->currentData().toString(), QBitArray(count)) | ~m_productionModules;
+    }
 
-        if (m_chkByResource->isChecked())
+    if (m_chkByProduction->isChecked())
+    {
+        visible &= m_productModules.value(m_comboByProduction->currentData().toString(), QBitArray(count)) | ~m_productionModules;
+    }
+
+    // Keywords are searched in background, results of the latest search
+    // finished are applied and ranked.
+    QVector<int> ranks;
+    QString keyword = m_chkByKeyword->isChecked() ? m_txtKeyword->text() : QString();
+    if (keyword.isEmpty())
+    {
+        if (!m_searchQuery.isNull())
         {
-            if (moduleItem->module()->moduleClass == GameStationModules::StationModule::StationModuleClass::
-                                                         Production)
-            {
-                ::std::shared_ptr<GameStationModules::StationModule> module = moduleItem->module();
-                ::std::shared_ptr<GameStationModules::SupplyProduct> property = ::std::static_pointer_cast<
-                    GameStationModules::SupplyProduct>(
-                    module->properties[GameStationModules::Property::Type::
-                                           SupplyProduct]);
-
-                if (property->productionInfo->resources.find(
-                        m_comboByResource->currentData().toString()) == property->productionInfo->resources.end())
-                {
-                    moduleItem->setHidden(true);
-                    continue;
-                }
-            }
+            ++m_searchSerial;
+            m_searchTask->cancle();
+            m_searchQuery = QString();
+            m_keywordModules.clear();
+            m_keywordRanks.clear();
         }
-
-        if (m_chkByProduction->isChecked())
+    }
+    else
+    {
+        if (keyword != m_searchQuery)
         {
-            if (moduleItem->module()->moduleClass == GameStationModules::StationModule::StationModuleClass::
-                                                         Production)
-            {
-                ::std::shared_ptr<GameStationModules::StationModule> module = moduleItem->module();
-                ::std::shared_ptr<GameStationModules::SupplyProduct> property = ::std::static_pointer_cast<
-                    GameStationModules::SupplyProduct>(
-                    module->properties[GameStationModules::Property::Type::
-                                           SupplyProduct]);
-                if (property->product != m_comboByProduction->currentData().toString())
-                {
-                    moduleItem->setHidden(true);
-                    continue;
-                }
-            }
+            this->searchModules(keyword);
         }
 
-        if (m_chkByKeyword->isChecked())
+        if (m_keywordModules.size() == count)
         {
-            if (!moduleItem->text(0).contains(m_txtKeyword->text()))
-            {
-                moduleItem->setHidden(true);
-                continue;
-            }
+            visible &= m_keywordModules;
+            ranks = m_keywordRanks;
         }
-
-        moduleItem->setHidden(false);
     }
+
+    // The proxy model only updates rows whose visibility changed.
+    m_modulesFilter->setVisibleModules(visible, ranks);
 }
 
 /**
@@ -652,14 +625,12 @@ void StationModulesWidget::onByKeywordChkChanged(int status)
 void StationModulesWidget::onAddToStationClicked()
 {
     QStringList macros;
-    for (auto item : m_treeStationModules->selectedItems())
+    for (const auto &index : m_treeStationModules->selectionModel()->selectedRows())
     {
-        if (notIn(item, m_itemBuild, m_itemDock, m_itemProduction,
-                  m_itemStorage, m_itemHabitation, m_itemDefence,
-                  m_itemConnect))
+        qint64 id = m_modulesModel->moduleID(m_modulesFilter->mapToSource(index));
+        if (id >= 0)
         {
-            StationModulesTreeWidgetItem *moduleItem = (StationModulesTreeWidgetItem *)item;
-            macros.push_back((moduleItem->module()->macro));
+            macros.push_back(m_modulesModel->table()->module(id)->macro);
         }
     }
     if (!macros.empty())
@@ -671,17 +642,55 @@ void StationModulesWidget::onAddToStationClicked()
 /**
  * @brief		On item clicked.
  */
-void StationModulesWidget::onItemClicked(QTreeWidgetItem *item)
+void StationModulesWidget::onItemClicked(const QModelIndex &index)
 {
-    if (in(item, m_itemBuild, m_itemDock, m_itemProduction, m_itemStorage,
-           m_itemHabitation, m_itemDefence, m_itemConnect))
+    qint64 id = m_modulesModel->moduleID(m_modulesFilter->mapToSource(index));
+    if (id < 0)
     {
         return;
     }
-    else
+
+    QString macro = m_modulesModel->table()->module(id)->macro;
+    qDebug() << macro << "clicked.";
+    emit this->stationModuleClicked(macro, false);
+}
+
+/**
+ * @brief		Reload station modules after game data reloaded.
+ */
+void StationModulesWidget::onGameDataReloaded()
+{
+    // Clear filters.
+    m_races.clear();
+    m_products.clear();
+    m_resources.clear();
+    m_raceModules.clear();
+    m_productModules.clear();
+    m_resourceModules.clear();
+    ++m_searchSerial;
+    m_searchIndex = nullptr;
+    m_searchQuery = QString();
+    m_keywordModules.clear();
+    m_keywordRanks.clear();
+
+    // Load modules.
+    this->loadStationModules();
+
+    // Reload filters, keep current selections. Texts are set when the
+    // language is applied.
+    auto reloadComboBox = [](SortedComboBox *combo, const QSet<QString> &ids)
     {
-        StationModulesTreeWidgetItem *moduleItem = (StationModulesTreeWidgetItem *)item;
-        qDebug() << moduleItem->module()->macro << "clicked.";
-        emit this->stationModuleClicked(moduleItem->module()->macro, false);
-    }
+        QVector<SortedComboBox::Item> items;
+        for (const auto &id : ids)
+        {
+            items.append({"", id});
+        }
+        combo->setItems(items);
+    };
+    reloadComboBox(m_comboByRaces, m_races);
+    reloadComboBox(m_comboByProduction, m_products);
+    reloadComboBox(m_comboByResource, m_resources);
+
+    this->onLanguageChanged();
+    this->filterModules();
 }
@@ -0,0 +1,60 @@
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+
+#include <locale/string_table.h>
+#include <ui/splash/splash_loading_sink.h>
+#include <ui/splash/splash_widget.h>
+
+/**
+ * @brief		Constructor.
+ */
+SplashLoadingSink::SplashLoadingSink(SplashWidget *splash) : m_splash(splash)
+{}
+
+/**
+ * @brief		Show progress.
+ */
+void SplashLoadingSink::setText(const QString &text)
+{
+    m_splash->setText(text);
+}
+
+/**
+ * @brief		Show error.
+ */
+void SplashLoadingSink::showError(const QString &message)
+{
+    m_splash->callFunc(::std::function<void()>([&]() -> void {
+        QMessageBox::critical(m_splash, STR("STR_ERROR"), message);
+    }));
+}
+
+/**
+ * @brief		Ask for path of game.
+ */
+bool SplashLoadingSink::askGamePath(const QString &current, QString &path)
+{
+    return m_splash->callFunc(::std::function<bool()>([&]() -> bool {
+        QFileDialog fileDialog(nullptr, STR("STR_TITLE_SELECT_GAME_PATH"),
+                               current, "*");
+        fileDialog.setAcceptMode(QFileDialog::AcceptMode::AcceptOpen);
+        fileDialog.setFileMode(QFileDialog::FileMode::Directory);
+        fileDialog.setFilter(QDir::Filter::Dirs | QDir::Filter::Hidden
+                             | QDir::Filter::System);
+        if (fileDialog.exec() != QDialog::DialogCode::Accepted
+            || fileDialog.selectedFiles().empty()) {
+            return false;
+        }
+        path = QDir(fileDialog.selectedFiles()[0]).absolutePath();
+        qDebug() << "Selected:" << path;
+
+        return true;
+    }));
+}
+
+/**
+ * @brief	Destructor.
+ */
+SplashLoadingSink::~SplashLoadingSink() {}
@@ -10,7 +10,9 @@ SplashThread::SplashThread(::std::function<int()> workFunc,
                            SplashWidget *         parent) :
     QThread(reinterpret_cast<QObject*>(parent)),
     m_workFunc(std::move(workFunc)), m_exitCode(-1)
-{}
+{
+    this->setObjectName("Loader");
+}
 
 /**
  * @brief		Get exit code.